@@ -0,0 +1,193 @@
+#pragma once
+#ifndef CPP_ASSERT_BENCHMARK_HPP
+#define	CPP_ASSERT_BENCHMARK_HPP
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+
+#if defined(__linux__)
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   include <cstring>
+#endif
+
+namespace benchmark
+{
+
+/**
+ * Sink for benchmark results, prevents compiler from removing
+ * measured code
+ */
+extern volatile std::uint64_t sink;
+
+/**
+ * Runs function given number of times and returns best time per
+ * operation in nanoseconds
+ *
+ * @param   function        Function to measure, it should perform
+ *                          `operations` operations and return
+ *                          std::uint64_t
+ * @param   operations      Number of operations performed by single call
+ * @param   repetitions     Number of calls
+ * @return  Best time of single operation in nanoseconds
+ */
+template<typename Function>
+double measure(Function function, std::size_t operations,
+               std::size_t repetitions)
+{
+    typedef std::chrono::steady_clock Clock;
+    double best = std::numeric_limits<double>::max();
+    for(std::size_t i = 0; i<repetitions; ++i)
+    {
+        const Clock::time_point start = Clock::now();
+        sink = sink + function();
+        const Clock::time_point stop = Clock::now();
+        const double elapsed = std::chrono::duration<double, std::nano>(
+                    stop-start).count();
+        best = std::min(best, elapsed/static_cast<double>(operations));
+    }
+    return best;
+}
+
+/**
+ * Counts instructions retired in user space by calling thread, uses
+ * perf events on Linux. Counter is not available on other platforms or
+ * when perf events are not permitted i.e. in containers.
+ */
+class InstructionCounter
+{
+public:
+    InstructionCounter()
+    {
+#if defined(__linux__)
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        descriptor_ = static_cast<int>(syscall(__NR_perf_event_open
+                                               , &attributes, 0, -1, -1, 0));
+#endif
+    }
+
+    ~InstructionCounter()
+    {
+#if defined(__linux__)
+        if(descriptor_>=0)
+        {
+            close(descriptor_);
+        }
+#endif
+    }
+
+    InstructionCounter(const InstructionCounter &) = delete;
+    InstructionCounter &operator=(const InstructionCounter &) = delete;
+
+    bool isAvailable() const
+    {
+        return (descriptor_>=0);
+    }
+
+    void start()
+    {
+#if defined(__linux__)
+        if(descriptor_>=0)
+        {
+            ioctl(descriptor_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(descriptor_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    std::uint64_t stop()
+    {
+        std::uint64_t count = 0;
+#if defined(__linux__)
+        if(descriptor_>=0)
+        {
+            ioctl(descriptor_, PERF_EVENT_IOC_DISABLE, 0);
+            if(read(descriptor_, &count, sizeof(count))!=sizeof(count))
+            {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+
+private:
+    int descriptor_ = -1;
+};
+
+/**
+ * Result of measurement with instruction counter
+ */
+struct Measurement
+{
+    double nsPerOp;             ///< Best time of single operation
+    double instructionsPerOp;   ///< Fewest instructions of single operation,
+                                ///< negative if counter is not available
+};
+
+/**
+ * Runs function given number of times and returns best time and fewest
+ * instructions per operation
+ *
+ * @param   counter         Instruction counter
+ * @param   function        Function to measure, it should perform
+ *                          `operations` operations and return
+ *                          std::uint64_t
+ * @param   operations      Number of operations performed by single call
+ * @param   repetitions     Number of calls
+ * @return  Best time and fewest instructions of single operation
+ */
+template<typename Function>
+Measurement measure(InstructionCounter &counter, Function function,
+                    std::size_t operations, std::size_t repetitions)
+{
+    typedef std::chrono::steady_clock Clock;
+    Measurement best = {std::numeric_limits<double>::max()
+                        , std::numeric_limits<double>::max()};
+    for(std::size_t i = 0; i<repetitions; ++i)
+    {
+        const Clock::time_point start = Clock::now();
+        counter.start();
+        const std::uint64_t result = function();
+        const std::uint64_t instructions = counter.stop();
+        const Clock::time_point stop = Clock::now();
+        sink = sink + result;
+        const double elapsed = std::chrono::duration<double, std::nano>(
+                    stop-start).count();
+        best.nsPerOp = std::min(best.nsPerOp
+                                , elapsed/static_cast<double>(operations));
+        best.instructionsPerOp = std::min(best.instructionsPerOp
+                                , static_cast<double>(instructions)
+                                    /static_cast<double>(operations));
+    }
+    if(!counter.isAvailable())
+    {
+        best.instructionsPerOp = -1.0;
+    }
+    return best;
+}
+
+/**
+ * Prints single benchmark result
+ * @param   name    Benchmark name
+ * @param   nsPerOp Time of single operation in nanoseconds
+ */
+inline void report(const char *name, double nsPerOp)
+{
+    std::printf("%-40s %10.3f ns/op\n", name, nsPerOp);
+}
+
+} //benchmark
+
+#endif	/* CPP_ASSERT_BENCHMARK_HPP */
@@ -0,0 +1,62 @@
+#include "Benchmark.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+volatile std::uint64_t sink = 0;
+}
+
+#define DECLARE_KERNELS(name) \
+namespace name \
+{ \
+std::uint64_t lessThan(const std::uint32_t *values, std::size_t size, \
+                       std::uint32_t limit); \
+std::uint64_t equalStrings(const std::string *values, std::size_t size); \
+}
+
+DECLARE_KERNELS(singleEvaluation)
+DECLARE_KERNELS(doubleEvaluation)
+
+namespace
+{
+const std::size_t VALUES = 4096;
+const std::size_t REPETITIONS = 200;
+const std::uint32_t LIMIT = 65536;
+
+void run(const char *name, const std::vector<std::uint32_t> &values,
+         const std::vector<std::string> &strings,
+         std::uint64_t (*lessThan)(const std::uint32_t *, std::size_t,
+                                   std::uint32_t),
+         std::uint64_t (*equalStrings)(const std::string *, std::size_t))
+{
+    const std::string lessThanName = std::string(name)+" LT integers";
+    const std::string equalStringsName = std::string(name)+" EQ strings";
+    benchmark::report(lessThanName.c_str(), benchmark::measure([&]()
+    {
+        return lessThan(values.data(), values.size(), LIMIT);
+    }, values.size(), REPETITIONS));
+    benchmark::report(equalStringsName.c_str(), benchmark::measure([&]()
+    {
+        return equalStrings(strings.data(), strings.size());
+    }, strings.size(), REPETITIONS));
+}
+}
+
+int main()
+{
+    std::vector<std::uint32_t> values;
+    std::vector<std::string> strings;
+    for(std::size_t i = 0; i<VALUES; ++i)
+    {
+        values.push_back(static_cast<std::uint32_t>((i*7919)%LIMIT));
+        strings.push_back(std::string(8+i%56, static_cast<char>('a'+i%26)));
+    }
+
+    run("single evaluation", values, strings, singleEvaluation::lessThan
+        , singleEvaluation::equalStrings);
+    run("double evaluation", values, strings, doubleEvaluation::lessThan
+        , doubleEvaluation::equalStrings);
+    return 0;
+}
@@ -0,0 +1,30 @@
+/*
+ * Former expansion of comparison assertions which evaluated arguments
+ * once for comparison and again for failure report
+ */
+#include <cppassert/Assertion.hpp>
+
+#define DOUBLE_EVALUATION_ASSERT(val1, val2, predicate, operator_) \
+    do \
+    {   \
+        CPP_ASSERT_SITE_PROLOGUE(Always, predicate, \
+                        CPP_ASSERT_STRING(val1), CPP_ASSERT_STRING(val2)) \
+        if(CPP_ASSERT_SKIPPED(Always, cppAssertSite_) \
+           || CPP_ASSERT_LIKELY((val1) operator_ (val2))) \
+        {   \
+            ; \
+        }\
+        else \
+        { \
+            ::cppassert::internal::onPredicateAssertionFailure(&cppAssertSite_, \
+                                    val1, \
+                                    val2); \
+        } \
+    } CPP_ASSERT_WHILE_FALSE
+
+#define COMPARISON_NAMESPACE doubleEvaluation
+#define COMPARISON_ASSERT_LT(val1, val2) \
+    DOUBLE_EVALUATION_ASSERT(val1, val2, Lt, <)
+#define COMPARISON_ASSERT_EQ(val1, val2) \
+    DOUBLE_EVALUATION_ASSERT(val1, val2, Eq, ==)
+#include "ComparisonKernels-inl.hpp"
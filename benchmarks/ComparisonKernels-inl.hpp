@@ -0,0 +1,39 @@
+/*
+ * Benchmark kernels, this file is included by translation units using
+ * current and former expansion of comparison assertions.
+ * COMPARISON_NAMESPACE, COMPARISON_ASSERT_LT and COMPARISON_ASSERT_EQ
+ * have to be defined before inclusion.
+ */
+#include <cppassert/Assertion.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace COMPARISON_NAMESPACE
+{
+
+std::uint64_t lessThan(const std::uint32_t *values, std::size_t size,
+                       std::uint32_t limit)
+{
+    std::uint64_t sum = 0;
+    for(std::size_t i = 0; i<size; ++i)
+    {
+        COMPARISON_ASSERT_LT(values[i], limit);
+        sum += values[i];
+    }
+    return sum;
+}
+
+std::uint64_t equalStrings(const std::string *values, std::size_t size)
+{
+    std::uint64_t sum = 0;
+    for(std::size_t i = 0; i<size; ++i)
+    {
+        COMPARISON_ASSERT_EQ(values[i].size(), values[i].length());
+        COMPARISON_ASSERT_EQ(values[i], values[i]);
+        sum += values[i].size();
+    }
+    return sum;
+}
+
+} //COMPARISON_NAMESPACE
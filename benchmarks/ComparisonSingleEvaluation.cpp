@@ -0,0 +1,4 @@
+#define COMPARISON_NAMESPACE singleEvaluation
+#define COMPARISON_ASSERT_LT CPP_ASSERT_ALWAYS_LT
+#define COMPARISON_ASSERT_EQ CPP_ASSERT_ALWAYS_EQ
+#include "ComparisonKernels-inl.hpp"
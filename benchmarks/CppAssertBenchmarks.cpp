@@ -0,0 +1,181 @@
+/*
+ * Overhead of every macro family in tight loops, in enabled, NDEBUG and
+ * CPP_ASSERT_DISABLE_ALL builds, against standard assert and unchecked
+ * loop. Failure path is measured end to end with a counting handler.
+ * Results are printed and written as JSON to file given as the first
+ * argument, cppassertBenchmarks.json by default.
+ */
+#include "Benchmark.hpp"
+#include "MacroKernels.hpp"
+#include <cppassert/CppAssert.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+volatile std::uint64_t sink = 0;
+}
+
+CPP_ASSERT_DECLARE_KERNELS(enabled)
+CPP_ASSERT_DECLARE_KERNELS(ndebug)
+CPP_ASSERT_DECLARE_KERNELS(disabledAll)
+
+namespace baseline
+{
+std::uint64_t rawAssert(const std::uint32_t *values, std::size_t size,
+                        std::uint32_t limit);
+std::uint64_t unchecked(const std::uint32_t *values, std::size_t size,
+                        std::uint32_t limit);
+}
+
+namespace
+{
+const std::size_t VALUES = 4096;
+const std::size_t REPETITIONS = 200;
+const std::size_t FAILURES = 64;
+const std::size_t FAILURE_REPETITIONS = 10;
+const std::uint32_t LIMIT = 65536;
+
+struct Kernels
+{
+    const char *macro;
+    MacroKernel enabled;
+    MacroKernel ndebug;
+    MacroKernel disabledAll;
+};
+
+#define CPP_ASSERT_KERNELS_ENTRY(name, macro, assertion) \
+    {macro, enabled::name, ndebug::name, disabledAll::name},
+
+const Kernels KERNELS[] =
+{
+    CPP_ASSERT_BENCHMARK_KERNELS(CPP_ASSERT_KERNELS_ENTRY)
+};
+
+struct Result
+{
+    std::string name;
+    const char *build;
+    const char *path;
+    benchmark::Measurement measurement;
+};
+
+class Runner
+{
+public:
+    Runner()
+    {
+        for(std::size_t i = 0; i<VALUES; ++i)
+        {
+            values_.push_back(static_cast<std::uint32_t>((i*7919)%LIMIT));
+        }
+    }
+
+    void success(const char *name, const char *build, MacroKernel kernel)
+    {
+        const benchmark::Measurement measurement
+                = benchmark::measure(counter_, [&]()
+        {
+            return kernel(values_.data(), values_.size(), LIMIT);
+        }, values_.size(), REPETITIONS);
+        add(name, build, "success", measurement);
+    }
+
+    void failure(const char *name, MacroKernel kernel)
+    {
+        const benchmark::Measurement measurement
+                = benchmark::measure(counter_, [&]()
+        {
+            return kernel(values_.data(), FAILURES, 0);
+        }, FAILURES, FAILURE_REPETITIONS);
+        add(name, "enabled", "failure", measurement);
+    }
+
+    bool writeJson(const char *fileName) const
+    {
+        std::ofstream file(fileName);
+        file<<"{\n  \"benchmarks\": [\n";
+        for(std::size_t i = 0; i<results_.size(); ++i)
+        {
+            const Result &result = results_[i];
+            file<<"    {\"name\": \""<<result.name<<"\", \"build\": \""
+                <<result.build<<"\", \"path\": \""<<result.path
+                <<"\", \"ns_per_op\": "<<result.measurement.nsPerOp
+                <<", \"instructions_per_op\": ";
+            if(result.measurement.instructionsPerOp<0.0)
+            {
+                file<<"null";
+            }
+            else
+            {
+                file<<result.measurement.instructionsPerOp;
+            }
+            file<<((i+1<results_.size()) ? "},\n" : "}\n");
+        }
+        file<<"  ]\n}\n";
+        return static_cast<bool>(file);
+    }
+
+private:
+    void add(const char *name, const char *build, const char *path,
+             const benchmark::Measurement &measurement)
+    {
+        std::printf("%-36s %-12s %-8s %10.3f ns/op", name, build, path
+                    , measurement.nsPerOp);
+        if(measurement.instructionsPerOp>=0.0)
+        {
+            std::printf(" %10.2f instructions/op", measurement.instructionsPerOp);
+        }
+        std::printf("\n");
+        Result result = {name, build, path, measurement};
+        results_.push_back(result);
+    }
+
+    std::vector<std::uint32_t> values_;
+    std::vector<Result> results_;
+    benchmark::InstructionCounter counter_;
+};
+}
+
+int main(int argc, char **argv)
+{
+    const char *fileName = (argc>1) ? argv[1] : "cppassertBenchmarks.json";
+    Runner runner;
+
+    runner.success("unchecked", "baseline", baseline::unchecked);
+    runner.success("assert", "baseline", baseline::rawAssert);
+    for(const Kernels &kernels: KERNELS)
+    {
+        runner.success(kernels.macro, "enabled", kernels.enabled);
+        runner.success(kernels.macro, "NDEBUG", kernels.ndebug);
+        runner.success(kernels.macro, "DISABLE_ALL", kernels.disabledAll);
+    }
+
+    std::size_t failures = 0;
+    cppassert::CppAssert::getInstance()->setAssertionHandler(
+                [&failures](const cppassert::AssertionFailure &)
+    {
+        ++failures;
+    });
+    for(const Kernels &kernels: KERNELS)
+    {
+        runner.failure(kernels.macro, kernels.enabled);
+    }
+    cppassert::CppAssert::getInstance()->setDefaultHandler();
+    const std::size_t expectedFailures = sizeof(KERNELS)/sizeof(KERNELS[0])
+                                         *FAILURES*FAILURE_REPETITIONS;
+    if(failures!=expectedFailures)
+    {
+        std::printf("Expected %zu failures, handler was called %zu times\n"
+                    , expectedFailures, failures);
+        return 1;
+    }
+
+    if(!runner.writeJson(fileName))
+    {
+        std::printf("Unable to write %s\n", fileName);
+        return 1;
+    }
+    return 0;
+}
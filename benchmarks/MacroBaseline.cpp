@@ -0,0 +1,38 @@
+/*
+ * Baselines for cppassertBenchmarks, standard assert and no check at all
+ */
+#undef NDEBUG
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace baseline
+{
+
+std::uint64_t rawAssert(const std::uint32_t *values, std::size_t size,
+                        std::uint32_t limit)
+{
+    std::uint64_t sum = 0;
+    for(std::size_t i = 0; i<size; ++i)
+    {
+        const std::uint32_t value = values[i];
+        assert(value<limit);
+        sum += value;
+    }
+    static_cast<void>(limit);
+    return sum;
+}
+
+std::uint64_t unchecked(const std::uint32_t *values, std::size_t size,
+                        std::uint32_t limit)
+{
+    std::uint64_t sum = 0;
+    for(std::size_t i = 0; i<size; ++i)
+    {
+        sum += values[i];
+    }
+    static_cast<void>(limit);
+    return sum;
+}
+
+} //baseline
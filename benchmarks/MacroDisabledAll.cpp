@@ -0,0 +1,4 @@
+// all macros removed
+#define CPP_ASSERT_DISABLE_ALL
+#define MACRO_NAMESPACE disabledAll
+#include "MacroKernels-inl.hpp"
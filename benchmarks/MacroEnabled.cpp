@@ -0,0 +1,4 @@
+// all macros enabled, regardless of build type
+#undef NDEBUG
+#define MACRO_NAMESPACE enabled
+#include "MacroKernels-inl.hpp"
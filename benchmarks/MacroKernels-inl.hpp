@@ -0,0 +1,29 @@
+/*
+ * Benchmark kernels, this file is included by translation units compiled
+ * in different build modes. MACRO_NAMESPACE has to be defined before
+ * inclusion.
+ */
+#include "MacroKernels.hpp"
+#include <cppassert/Assertion.hpp>
+
+#define CPP_ASSERT_DEFINE_KERNEL(name, macro, assertion) \
+std::uint64_t name(const std::uint32_t *values, std::size_t size, \
+                   std::uint32_t limit) \
+{ \
+    std::uint64_t sum = 0; \
+    for(std::size_t i = 0; i<size; ++i) \
+    { \
+        const std::uint32_t value = values[i]; \
+        assertion; \
+        sum += value; \
+    } \
+    CPP_ASSERT_MARK_UNUSED(limit); \
+    return sum; \
+}
+
+namespace MACRO_NAMESPACE
+{
+
+CPP_ASSERT_BENCHMARK_KERNELS(CPP_ASSERT_DEFINE_KERNEL)
+
+} //MACRO_NAMESPACE
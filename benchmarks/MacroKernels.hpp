@@ -0,0 +1,76 @@
+#pragma once
+#ifndef CPP_ASSERT_MACRO_KERNELS_HPP
+#define	CPP_ASSERT_MACRO_KERNELS_HPP
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Assertion of every macro family benchmarked by cppassertBenchmarks,
+ * KERNEL(name, macro, assertion) is invoked for each of them. Assertion
+ * holds for every `value` lower than `limit` and fails for every value when
+ * `limit` is 0, so the same kernels measure the failure path.
+ */
+#define CPP_ASSERT_BENCHMARK_KERNELS(KERNEL) \
+    KERNEL(assertStatement, "CPP_ASSERT", \
+           CPP_ASSERT(value<limit)) \
+    KERNEL(assertStatementMessage, "CPP_ASSERT with message", \
+           CPP_ASSERT(value<limit, "value "<<value)) \
+    KERNEL(assertTrue, "CPP_ASSERT_TRUE", \
+           CPP_ASSERT_TRUE(value<limit)) \
+    KERNEL(assertFalse, "CPP_ASSERT_FALSE", \
+           CPP_ASSERT_FALSE(value>=limit)) \
+    KERNEL(assertEq, "CPP_ASSERT_EQ", \
+           CPP_ASSERT_EQ(value<limit, true)) \
+    KERNEL(assertNe, "CPP_ASSERT_NE", \
+           CPP_ASSERT_NE(value+limit, value)) \
+    KERNEL(assertLt, "CPP_ASSERT_LT", \
+           CPP_ASSERT_LT(value, limit)) \
+    KERNEL(assertLe, "CPP_ASSERT_LE", \
+           CPP_ASSERT_LE(value+1, limit)) \
+    KERNEL(assertGt, "CPP_ASSERT_GT", \
+           CPP_ASSERT_GT(limit, value)) \
+    KERNEL(assertGe, "CPP_ASSERT_GE", \
+           CPP_ASSERT_GE(limit, value+1)) \
+    KERNEL(assertLtMessage, "CPP_ASSERT_LT with message", \
+           CPP_ASSERT_LT(value, limit, "value "<<value)) \
+    KERNEL(alwaysStatement, "CPP_ASSERT_ALWAYS", \
+           CPP_ASSERT_ALWAYS(value<limit)) \
+    KERNEL(alwaysStatementMessage, "CPP_ASSERT_ALWAYS with message", \
+           CPP_ASSERT_ALWAYS(value<limit, "value "<<value)) \
+    KERNEL(alwaysTrue, "CPP_ASSERT_ALWAYS_TRUE", \
+           CPP_ASSERT_ALWAYS_TRUE(value<limit)) \
+    KERNEL(alwaysFalse, "CPP_ASSERT_ALWAYS_FALSE", \
+           CPP_ASSERT_ALWAYS_FALSE(value>=limit)) \
+    KERNEL(alwaysEq, "CPP_ASSERT_ALWAYS_EQ", \
+           CPP_ASSERT_ALWAYS_EQ(value<limit, true)) \
+    KERNEL(alwaysNe, "CPP_ASSERT_ALWAYS_NE", \
+           CPP_ASSERT_ALWAYS_NE(value+limit, value)) \
+    KERNEL(alwaysLt, "CPP_ASSERT_ALWAYS_LT", \
+           CPP_ASSERT_ALWAYS_LT(value, limit)) \
+    KERNEL(alwaysLe, "CPP_ASSERT_ALWAYS_LE", \
+           CPP_ASSERT_ALWAYS_LE(value+1, limit)) \
+    KERNEL(alwaysGt, "CPP_ASSERT_ALWAYS_GT", \
+           CPP_ASSERT_ALWAYS_GT(limit, value)) \
+    KERNEL(alwaysGe, "CPP_ASSERT_ALWAYS_GE", \
+           CPP_ASSERT_ALWAYS_GE(limit, value+1)) \
+    KERNEL(alwaysLtMessage, "CPP_ASSERT_ALWAYS_LT with message", \
+           CPP_ASSERT_ALWAYS_LT(value, limit, "value "<<value))
+
+/**
+ * Signature of every benchmark kernel, it returns sum of values
+ */
+typedef std::uint64_t (*MacroKernel)(const std::uint32_t *values,
+                                     std::size_t size,
+                                     std::uint32_t limit);
+
+#define CPP_ASSERT_DECLARE_KERNEL(name, macro, assertion) \
+    std::uint64_t name(const std::uint32_t *values, std::size_t size, \
+                       std::uint32_t limit);
+
+#define CPP_ASSERT_DECLARE_KERNELS(namespace_) \
+namespace namespace_ \
+{ \
+CPP_ASSERT_BENCHMARK_KERNELS(CPP_ASSERT_DECLARE_KERNEL) \
+}
+
+#endif	/* CPP_ASSERT_MACRO_KERNELS_HPP */
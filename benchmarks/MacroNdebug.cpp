@@ -0,0 +1,6 @@
+// CPP_ASSERT_* macros removed, CPP_ASSERT_ALWAYS_* macros enabled
+#ifndef NDEBUG
+#   define NDEBUG
+#endif
+#define MACRO_NAMESPACE ndebug
+#include "MacroKernels-inl.hpp"
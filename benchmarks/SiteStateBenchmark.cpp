@@ -0,0 +1,96 @@
+#include "Benchmark.hpp"
+#include <cppassert/CppAssert.hpp>
+#include <vector>
+
+namespace benchmark
+{
+volatile std::uint64_t sink = 0;
+}
+
+#define DECLARE_KERNELS(name) \
+namespace name \
+{ \
+std::uint64_t cheapPredicate(const std::uint32_t *values, std::size_t size, \
+                             std::uint32_t limit); \
+std::uint64_t expensivePredicate(const std::uint32_t *values, \
+                                 std::size_t size); \
+}
+
+DECLARE_KERNELS(unconditional)
+DECLARE_KERNELS(siteState)
+DECLARE_KERNELS(staticKeys)
+
+namespace
+{
+const std::size_t VALUES = 4096;
+const std::size_t REPETITIONS = 200;
+const std::uint32_t LIMIT = 65536;
+
+std::vector<std::uint32_t> getPrimes(std::size_t count)
+{
+    std::vector<std::uint32_t> result;
+    for(std::uint32_t value = 65521; result.size()<count; value -= 2)
+    {
+        bool prime = true;
+        for(std::uint32_t divisor = 3; divisor*divisor<=value; divisor += 2)
+        {
+            if(value%divisor==0)
+            {
+                prime = false;
+                break;
+            }
+        }
+        if(prime)
+        {
+            result.push_back(value);
+        }
+    }
+    return result;
+}
+
+void run(const char *name, const std::vector<std::uint32_t> &values,
+         std::uint64_t (*cheap)(const std::uint32_t *, std::size_t,
+                                std::uint32_t),
+         std::uint64_t (*expensive)(const std::uint32_t *, std::size_t))
+{
+    const std::string cheapName = std::string(name)+" cheap";
+    const std::string expensiveName = std::string(name)+" expensive";
+    benchmark::report(cheapName.c_str(), benchmark::measure([&]()
+    {
+        return cheap(values.data(), values.size(), LIMIT);
+    }, values.size(), REPETITIONS));
+    benchmark::report(expensiveName.c_str(), benchmark::measure([&]()
+    {
+        return expensive(values.data(), values.size());
+    }, values.size(), REPETITIONS));
+}
+}
+
+int main()
+{
+    const std::vector<std::uint32_t> values = getPrimes(VALUES);
+
+    run("unconditional", values, unconditional::cheapPredicate
+        , unconditional::expensivePredicate);
+    run("site state enabled", values, siteState::cheapPredicate
+        , siteState::expensivePredicate);
+    run("static keys enabled", values, staticKeys::cheapPredicate
+        , staticKeys::expensivePredicate);
+
+    const std::size_t disabled = cppassert::CppAssert::setSitesEnabled(
+                "*SiteStateKernels-inl.hpp", false);
+    if(disabled==0)
+    {
+        std::printf("Assertion sites are not listed on this platform\n");
+        return 0;
+    }
+    run("site state disabled", values, siteState::cheapPredicate
+        , siteState::expensivePredicate);
+    if(cppassert::CppAssert::getStaticKeyCount()!=0)
+    {
+        run("static keys disabled", values, staticKeys::cheapPredicate
+            , staticKeys::expensivePredicate);
+    }
+    cppassert::CppAssert::setSitesEnabled("*SiteStateKernels-inl.hpp", true);
+    return 0;
+}
@@ -0,0 +1,2 @@
+#define SITE_STATE_NAMESPACE siteState
+#include "SiteStateKernels-inl.hpp"
@@ -0,0 +1,53 @@
+/*
+ * Benchmark kernels, this file is included by translation units compiled
+ * with and without CPP_ASSERT_DISABLE_SITE_STATE. SITE_STATE_NAMESPACE
+ * has to be defined before inclusion.
+ */
+#include <cppassert/Assertion.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace SITE_STATE_NAMESPACE
+{
+
+static bool isPrime(std::uint32_t value)
+{
+    if(value<2)
+    {
+        return false;
+    }
+    for(std::uint32_t divisor = 2; divisor*divisor<=value; ++divisor)
+    {
+        if(value%divisor==0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint64_t cheapPredicate(const std::uint32_t *values, std::size_t size,
+                             std::uint32_t limit)
+{
+    std::uint64_t sum = 0;
+    for(std::size_t i = 0; i<size; ++i)
+    {
+        CPP_ASSERT_ALWAYS_LT(values[i], limit);
+        sum += values[i];
+    }
+    return sum;
+}
+
+std::uint64_t expensivePredicate(const std::uint32_t *values,
+                                 std::size_t size)
+{
+    std::uint64_t sum = 0;
+    for(std::size_t i = 0; i<size; ++i)
+    {
+        CPP_ASSERT_ALWAYS(isPrime(values[i]), values[i]<<" is not a prime");
+        sum += values[i];
+    }
+    return sum;
+}
+
+} //SITE_STATE_NAMESPACE
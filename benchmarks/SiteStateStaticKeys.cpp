@@ -0,0 +1,4 @@
+// sites patched at runtime, see CPP_ASSERT_STATIC_KEYS
+#define CPP_ASSERT_STATIC_KEYS
+#define SITE_STATE_NAMESPACE staticKeys
+#include "SiteStateKernels-inl.hpp"
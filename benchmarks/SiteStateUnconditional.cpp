@@ -0,0 +1,4 @@
+// current CPP_ASSERT_ALWAYS expansion, without runtime site state
+#define CPP_ASSERT_DISABLE_SITE_STATE
+#define SITE_STATE_NAMESPACE unconditional
+#include "SiteStateKernels-inl.hpp"
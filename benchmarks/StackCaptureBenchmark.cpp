@@ -0,0 +1,77 @@
+#include "Benchmark.hpp"
+#include <cppassert/details/StackUnwinder.hpp>
+#include <string>
+
+#ifdef CPP_ASSERT_HAVE_BACKTRACE
+#include <execinfo.h>
+#endif
+
+namespace benchmark
+{
+volatile std::uint64_t sink = 0;
+}
+
+namespace
+{
+const std::size_t MAX_FRAMES = 256;
+const std::size_t CAPTURES = 1000;
+const std::size_t REPETITIONS = 20;
+const std::size_t DEPTHS[] = {8, 32, 128};
+
+typedef std::size_t (*CaptureFunction)(void **, std::size_t);
+
+#ifdef CPP_ASSERT_HAVE_BACKTRACE
+std::size_t captureWithBacktrace(void **frames, std::size_t maxFrames)
+{
+    return static_cast<std::size_t>(
+                ::backtrace(frames, static_cast<int>(maxFrames)));
+}
+#endif
+
+/*
+ * Adds `depth` frames to the stack before capturing, result is used after
+ * recursive call so that it's not turned into a jump
+ */
+__attribute__((noinline))
+std::uint64_t captureAtDepth(CaptureFunction capture, std::size_t depth)
+{
+    if(depth>0)
+    {
+        return captureAtDepth(capture, depth-1)+benchmark::sink%2;
+    }
+    std::uint64_t result = 0;
+    void *frames[MAX_FRAMES];
+    for(std::size_t i = 0; i<CAPTURES; ++i)
+    {
+        result += capture(frames, MAX_FRAMES);
+    }
+    return result;
+}
+
+void run(const char *name, CaptureFunction capture)
+{
+    for(const std::size_t depth: DEPTHS)
+    {
+        const std::string benchmarkName = std::string(name)+" depth "
+                                          +std::to_string(depth);
+        benchmark::report(benchmarkName.c_str(), benchmark::measure([&]()
+        {
+            return captureAtDepth(capture, depth);
+        }, CAPTURES, REPETITIONS));
+    }
+}
+}
+
+int main()
+{
+#ifdef CPP_ASSERT_HAVE_BACKTRACE
+    run("backtrace", &captureWithBacktrace);
+#endif
+#ifdef CPP_ASSERT_HAVE_UNWIND_BACKTRACE
+    run("unwind", &cppassert::internal::captureWithUnwind);
+#endif
+#ifdef CPP_ASSERT_HAVE_FRAME_POINTER_UNWINDER
+    run("frame-pointer", &cppassert::internal::captureWithFramePointers);
+#endif
+    return 0;
+}
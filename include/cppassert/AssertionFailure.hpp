@@ -2,7 +2,12 @@
 #ifndef CPP_ASSERT_ASSERTIONFAILURE_HPP
 #define	CPP_ASSERT_ASSERTIONFAILURE_HPP
 #include "details/AssertionMessage.hpp"
+#include "details/ModuleMap.hpp"
+#include "MessageSink.hpp"
+#include "details/StackTrace.hpp"
+#include "AssertionSite.hpp"
 #include <cstdint>
+#include <string>
 
 namespace cppassert
 {
@@ -44,6 +49,28 @@ public:
                     , const char *function
                     , std::string &&message);
 
+    /**
+     * @brief Creates an assertion failure of assertion site.
+     *
+     * Source file line, file name and function name are taken from
+     * site description.
+     *
+     * @param[in]   site        Assertion site that failed
+     * @param[in]   message     Message associated with failed assertion
+     */
+    AssertionFailure(const AssertionSite *site
+                    , std::string &&message);
+
+    /**
+     * @brief Creates an assertion failure of assertion site with message
+     * formatted directly into AssertionMessage, see MessageSink.
+     *
+     * @param[in]   site        Assertion site that failed
+     * @param[in]   message     Message associated with failed assertion
+     */
+    AssertionFailure(const AssertionSite *site
+                    , AssertionMessage &&message);
+
     /**
      * Move constructor, have to be implemented by hand
      * because Visual C++ doesn't support generation of default ones
@@ -55,11 +82,17 @@ public:
             sourceFileLine_ = other.sourceFileLine_;
             sourceFileName_ = other.sourceFileName_;
             functionName_ = other.functionName_;
+            site_ = other.site_;
             message_ = std::move(other.message_);
             stackTrace_ = std::move(other.stackTrace_);
+            moduleMap_ = std::move(other.moduleMap_);
+            stackTraceText_ = std::move(other.stackTraceText_);
+            stackTraceRendered_ = other.stackTraceRendered_;
+            other.stackTraceRendered_ = false;
             other.sourceFileLine_ = 0;
             other.sourceFileName_ = nullptr;
             other.functionName_ = nullptr;
+            other.site_ = nullptr;
     }
 
     /**
@@ -73,11 +106,17 @@ public:
             sourceFileLine_ = other.sourceFileLine_;
             sourceFileName_ = other.sourceFileName_;
             functionName_ = other.functionName_;
+            site_ = other.site_;
             message_ = std::move(other.message_);
             stackTrace_ = std::move(other.stackTrace_);
+            moduleMap_ = std::move(other.moduleMap_);
+            stackTraceText_ = std::move(other.stackTraceText_);
+            stackTraceRendered_ = other.stackTraceRendered_;
+            other.stackTraceRendered_ = false;
             other.sourceFileLine_ = 0;
             other.sourceFileName_ = nullptr;
             other.functionName_ = nullptr;
+            other.site_ = nullptr;
             return (*this);
     }
 
@@ -134,7 +173,16 @@ public:
     const char *getFunctionName() const;
 
     /**
-     * Returns stack trace associated with a failed assertion
+     * Returns assertion site that failed
+     * @return  Assertion site or nullptr if failure wasn't created by
+     *          CPP_ASSERT_* macro
+     */
+    const AssertionSite *getAssertionSite() const;
+
+    /**
+     * Returns stack trace associated with a failed assertion. Only return
+     * addresses are captured when assertion fails, trace is symbolized
+     * and formatted on first call.
      * @return  Stack trace
      * @note    Please note that stack trace may not be available in
      *          some specific build configurations, especially when
@@ -142,12 +190,53 @@ public:
      */
     const std::string &getStackTrace() const;
 
+    /**
+     * Returns stack frames captured when assertion failed, they are not
+     * symbolized until their symbol is requested
+     * @return  Captured stack frames, the first one is assertion site
+     */
+    const internal::StackTrace &getStackFrames() const;
+
+    /**
+     * Returns snapshot of modules loaded when assertion failed
+     * @return  Module map of stack frames or nullptr if no stack
+     *          was captured
+     */
+    const std::shared_ptr<const internal::ModuleMap> &getModuleMap() const;
+
+    /**
+     * Returns stack frames as module offsets with build-ids of their
+     * modules, it can be symbolized offline by `cppassert-symbolize`
+     * @return  Raw stack record, empty if no stack was captured
+     */
+    std::string getRawStackTrace() const;
+
     /**
      * Returns message associated with failed assertion
      * @return message associated with assertion
      */
     std::string getMessage() const;
 
+    /**
+     * Appends message associated with failed assertion to \p sink,
+     * see getMessage()
+     * @param   sink    Output the message is appended to
+     */
+    void appendMessage(MessageSink &sink) const;
+
+    /**
+     * Appends stack trace to \p sink, see getStackTrace(). Trace which
+     * wasn't rendered yet is rendered directly to the sink.
+     * @param   sink    Output the stack trace is appended to
+     */
+    void appendStackTrace(MessageSink &sink) const;
+
+    /**
+     * Appends raw stack record to \p sink, see getRawStackTrace()
+     * @param   sink    Output the record is appended to
+     */
+    void appendRawStackTrace(MessageSink &sink) const;
+
     /**
      * Returns assertion as string formatted by installed assertion message
      * formatter. Message format depends on CPP_ASSERT_*() macro used to
@@ -156,13 +245,28 @@ public:
      */
     std::string toString() const;
 
-    void onAssertionFailure(const AssertionMessage &message);
+    /**
+     * Appends streamed message, collects stack trace and invokes
+     * installed assertion handler
+     *
+     * @param   message         Message streamed by library client
+     * @param   framesToSkip    Number of additional frames between
+     *                          assertion site and this call that
+     *                          shouldn't be reported in stack trace
+     */
+    CPP_ASSERT_LIBRARY_CODE
+    void onAssertionFailure(const AssertionMessage &message,
+                            std::uint32_t framesToSkip = 0);
 private:
     std::uint32_t sourceFileLine_ = 0;
     const char *sourceFileName_ = nullptr;
     const char *functionName_ = nullptr;
+    const AssertionSite *site_ = nullptr;
     AssertionMessage message_;
-    std::string stackTrace_;
+    internal::StackTrace stackTrace_;
+    std::shared_ptr<const internal::ModuleMap> moduleMap_;
+    mutable std::string stackTraceText_;
+    mutable bool stackTraceRendered_ = false;
 };
 
 } //asrt
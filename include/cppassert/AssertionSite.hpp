@@ -0,0 +1,239 @@
+#pragma once
+#ifndef CPP_ASSERT_ASSERTIONSITE_HPP
+#define	CPP_ASSERT_ASSERTIONSITE_HPP
+#include "details/Atomic.hpp"
+#include <cstdint>
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#   define CPP_ASSERT_CONSTEXPR const
+#else
+#   define CPP_ASSERT_CONSTEXPR constexpr
+#endif
+
+namespace cppassert
+{
+
+/**
+ * Kind of macro that created assertion site
+ */
+enum class AssertionKind : std::uint8_t
+{
+    Statement,  ///< CPP_ASSERT[_ALWAYS]
+    True,       ///< CPP_ASSERT[_ALWAYS]_TRUE
+    False,      ///< CPP_ASSERT[_ALWAYS]_FALSE
+    Eq,         ///< CPP_ASSERT[_ALWAYS]_EQ
+    Ne,         ///< CPP_ASSERT[_ALWAYS]_NE
+    Lt,         ///< CPP_ASSERT[_ALWAYS]_LT
+    Le,         ///< CPP_ASSERT[_ALWAYS]_LE
+    Gt,         ///< CPP_ASSERT[_ALWAYS]_GT
+    Ge          ///< CPP_ASSERT[_ALWAYS]_GE
+};
+
+/**
+ * Build level of assertion site. Levels are ordered by cost of the check,
+ * site is compiled in when its level doesn't exceed CPP_ASSERT_LEVEL and
+ * evaluated when it doesn't exceed runtime threshold, see
+ * CppAssert::setAssertionLevel.
+ */
+enum class AssertionLevel : std::uint8_t
+{
+    Always = 0, ///< CPP_ASSERT_ALWAYS_* macros, enabled in all builds
+    Cheap = 1,  ///< CPP_ASSERT_CHEAP macro, O(1) checks
+    Debug = 2,  ///< CPP_ASSERT_* macros, disabled when NDEBUG is defined
+    Audit = 3   ///< CPP_ASSERT_AUDIT macro, expensive i.e. O(n) checks
+};
+
+/**
+ * @class AssertionSite
+ *
+ * Compile time description of a single assertion site. Every CPP_ASSERT_*
+ * macro expansion emits exactly one AssertionSite record and passes pointer
+ * to it to the failure path. On platforms that support it, pointer to
+ * every record is also stored in `cppassert_sites` linker section which
+ * allows to walk all the assertion sites linked into executable, see
+ * CppAssert::getAssertionSites.
+ *
+ * Each site has one byte runtime state which is checked with a relaxed
+ * load before predicate is evaluated, so a disabled site doesn't evaluate
+ * its arguments at all. See CppAssert::setSiteEnabled.
+ */
+class AssertionSite
+{
+public:
+    /**
+     * Creates assertion site description
+     *
+     * @param   file                Source file name of assertion site
+     * @param   line                Source file line of assertion site
+     * @param   function            Function name of assertion site
+     * @param   expression          Expression text, for EQ/NE/LT/LE/GT/GE
+     *                              assertions text of first argument
+     * @param   secondExpression    Text of second argument for
+     *                              EQ/NE/LT/LE/GT/GE assertions, nullptr
+     *                              otherwise
+     * @param   kind                Kind of macro
+     * @param   level               Build level of macro
+     */
+    CPP_ASSERT_CONSTEXPR AssertionSite(const char *file
+                            , std::uint32_t line
+                            , const char *function
+                            , const char *expression
+                            , const char *secondExpression
+                            , AssertionKind kind
+                            , AssertionLevel level)
+    :file_(file), function_(function), expression_(expression)
+    , secondExpression_(secondExpression), line_(line), kind_(kind)
+    , level_(level), state_(ENABLED), stackDepth_(0)
+    {
+    }
+
+    AssertionSite(const AssertionSite &) = delete;
+    AssertionSite &operator=(const AssertionSite &) = delete;
+
+    /**
+     * Returns true if assertion site is enabled, this is checked by
+     * CPP_ASSERT_* macros before predicate is evaluated
+     * @return true if site is enabled
+     */
+    bool isEnabled() const
+    {
+        return (internal::loadRelaxed(state_)==ENABLED);
+    }
+
+    /**
+     * Enables or disables assertion site. Site state is not a part
+     * of site description so it can be changed through const
+     * pointer obtained from CppAssert::getAssertionSites
+     * @param   enabled     New state of site
+     */
+    void setEnabled(bool enabled) const
+    {
+        internal::storeRelaxed(state_, enabled ? ENABLED : DISABLED);
+    }
+
+    /**
+     * Returns maximal number of stack frames collected when assertion
+     * fails
+     * @return  Stack depth, 0 means CppAssert::getMaxStackDepth()
+     */
+    std::uint8_t getStackDepth() const
+    {
+        return internal::loadRelaxed(stackDepth_);
+    }
+
+    /**
+     * Overrides maximal number of stack frames collected when assertion
+     * fails, like site state it can be changed through const pointer
+     * @param   depth   Stack depth, 0 restores CppAssert::getMaxStackDepth()
+     */
+    void setStackDepth(std::uint8_t depth) const
+    {
+        internal::storeRelaxed(stackDepth_, depth);
+    }
+
+    /**
+     * Returns source file name of assertion site
+     * @return source file name
+     */
+    const char *getFile() const
+    {
+        return file_;
+    }
+
+    /**
+     * Returns source file line of assertion site
+     * @return source file line
+     */
+    std::uint32_t getLine() const
+    {
+        return line_;
+    }
+
+    /**
+     * Returns function name of assertion site
+     * @return function name
+     * @note Value returned depends on compiler and is not portable
+     *       some compilers may return mangled name
+     */
+    const char *getFunction() const
+    {
+        return function_;
+    }
+
+    /**
+     * Returns asserted expression as text, for EQ/NE/LT/LE/GT/GE
+     * assertions it is text of first argument
+     * @return expression as text
+     */
+    const char *getExpression() const
+    {
+        return expression_;
+    }
+
+    /**
+     * Returns text of second argument of EQ/NE/LT/LE/GT/GE
+     * assertions
+     * @return second argument as text or nullptr
+     */
+    const char *getSecondExpression() const
+    {
+        return secondExpression_;
+    }
+
+    /**
+     * Returns kind of macro that created this site
+     * @return kind of macro
+     */
+    AssertionKind getKind() const
+    {
+        return kind_;
+    }
+
+    /**
+     * Returns build level of this site
+     * @return build level
+     */
+    AssertionLevel getLevel() const
+    {
+        return level_;
+    }
+
+    /**
+     * Returns predicate of EQ/NE/LT/LE/GT/GE assertions as text
+     * i.e. "==" for CPP_ASSERT_EQ
+     * @return predicate as text or nullptr for other kinds
+     */
+    const char *getPredicate() const;
+
+    /**
+     * Returns 32 bit FNV-1a hash of expression text. For EQ/NE/LT/LE/GT/GE
+     * assertions hash is computed over
+     * "<expression> <predicate> <second expression>" i.e. "a == b".
+     * Hash doesn't depend on file name or line so it identifies
+     * assertion across builds.
+     * @return expression hash
+     */
+    std::uint32_t getExpressionHash() const;
+
+private:
+    enum State : std::uint8_t
+    {
+        ENABLED = 0,
+        DISABLED = 1
+    };
+
+
+    const char *file_;
+    const char *function_;
+    const char *expression_;
+    const char *secondExpression_;
+    std::uint32_t line_;
+    AssertionKind kind_;
+    AssertionLevel level_;
+    mutable std::uint8_t state_;
+    mutable std::uint8_t stackDepth_;
+};
+
+} //cppassert
+
+#endif	/* CPP_ASSERT_ASSERTIONSITE_HPP */
@@ -0,0 +1,70 @@
+#pragma once
+#ifndef CPP_ASSERT_CODERANGE_HPP
+#define	CPP_ASSERT_CODERANGE_HPP
+#include <cstddef>
+#include <memory>
+
+namespace cppassert
+{
+
+/**
+ * Names dynamically generated code, i.e. a function compiled by a JIT, so
+ * that its frames are symbolized in stack traces. Frames outside of loaded
+ * modules are looked up in registered ranges and then in perf map of the
+ * process, `/tmp/perf-<pid>.map`, which is read again when it changes.
+ * Range overlapping previously registered ones replaces them, so memory
+ * of released code can be reused.
+ *
+ * @param   begin   Address of the first instruction
+ * @param   end     Address past the last instruction
+ * @param   name    Function name, it's copied and demangled on
+ *                  symbolization
+ */
+void registerCodeRange(const void *begin, const void *end, const char *name);
+
+/**
+ * Removes range registered with registerCodeRange()
+ *
+ * @param   begin   Address of the first instruction of the range
+ * @return  false if there is no range starting at \p begin
+ */
+bool unregisterCodeRange(const void *begin);
+
+namespace internal
+{
+
+/**
+ * Registered range or perf map entry containing an address
+ */
+struct CodeRangeSymbol
+{
+    /**
+     * Keeps names alive while the symbol is used
+     */
+    std::shared_ptr<const void> owner;
+    const char *module = nullptr;       ///< `[jit]` or path of perf map
+    const char *name = nullptr;         ///< Function name
+    std::size_t offset = 0;             ///< Offset from range begin
+};
+
+/**
+ * Finds registered range or perf map entry containing return address
+ *
+ * @param[in]   address     Return address of stack frame
+ * @param[out]  symbol      Found range
+ * @return  false if address isn't in any range
+ */
+bool findCodeRange(const void *address, CodeRangeSymbol *symbol);
+
+/**
+ * Replaces perf map read by findCodeRange(), empty path restores
+ * `/tmp/perf-<pid>.map`
+ *
+ * @param   path    Path of perf map
+ */
+void setPerfMapPath(const char *path);
+
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_CODERANGE_HPP */
@@ -5,11 +5,18 @@
 #include <string>
 #include <functional>
 #include <mutex>
+#include <vector>
 #include <cppassert/details/DebugPrint.hpp>
 #include <cppassert/details/AssertionMessage.hpp>
+#include <cppassert/details/FormatterAdapter.hpp>
 #include <cppassert/details/Helpers.hpp>
 #include <cppassert/details/StackTrace.hpp>
+#include <cppassert/details/StackTraceRenderer.hpp>
+#include <cppassert/details/StackUnwinder.hpp>
+#include <cppassert/details/SymbolCache.hpp>
+#include <cppassert/details/WarmUp.hpp>
 #include <cppassert/AssertionFailure.hpp>
+#include <cppassert/MessageSink.hpp>
 
 
 namespace cppassert
@@ -19,18 +26,56 @@ class AssertionFailure;
 namespace internal
 {
     void onAssertionFailureDefaultHandler(const AssertionFailure &assertion);
+    const std::vector<const AssertionSite *> &getAssertionSites();
+    std::size_t setSiteEnabled(const char *file, std::uint32_t line,
+                               bool enabled);
+    std::size_t setSitesEnabled(const char *fileGlob, bool enabled);
+    std::size_t setSitesEnabledByHash(std::uint32_t expressionHash,
+                                      bool enabled);
+    std::size_t setSitesStackDepth(const char *fileGlob, std::uint8_t depth);
+    void disableSitesFromEnvironment();
+    bool setStaticKeysEnabled(const AssertionSite *site, bool enabled);
+    std::size_t getStaticKeyCount();
+    void setAssertionLevel(AssertionLevel level);
+    AssertionLevel getAssertionLevel();
 }
 
+/**
+ * Default formatter, every method appends to MessageSink and has a variant
+ * returning std::string. Custom formatter can implement either variant of
+ * each method, see internal::FormatterAdapter.
+ */
 struct DefaultFormatter
 {
-    std::string formatAssertionMessage(const AssertionFailure &assertion);
-    std::string formatBoolFailureMessage(const char* expressionText,
-                                         const char* actualPredicateValue,
-                                         const char* expectedPredicateValue);
+    void formatAssertionMessage(MessageSink &sink,
+                                const AssertionFailure &assertion);
+    void formatBoolFailureMessage(MessageSink &sink,
+                                  const char* expressionText,
+                                  const char* actualPredicateValue,
+                                  const char* expectedPredicateValue);
     /**
      * Formats messages produced by equality/inequality macros
      * (CPP_ASSERT_[EQ|NE|LE|LT|GE|GT]
      */
+    void formatPredicateFailureMessage(MessageSink &sink,
+                                       const char* predicate,
+                                       const char* value1Text,
+                                       const char* value2Text,
+                                       const AssertionMessage &value1,
+                                       const AssertionMessage &value2);
+    void formatStatementFailureMessage(MessageSink &sink,
+                                       const char *statement);
+    void formatStreamedMessage(MessageSink &sink,
+                               const AssertionMessage &message);
+    void formatFrame(MessageSink &sink
+                     , std::uint32_t frameNumber
+                     , const void *address
+                     , const char *symbol);
+
+    std::string formatAssertionMessage(const AssertionFailure &assertion);
+    std::string formatBoolFailureMessage(const char* expressionText,
+                                         const char* actualPredicateValue,
+                                         const char* expectedPredicateValue);
     std::string formatPredicateFailureMessage(const char* predicate,
                                               const char* value1Text,
                                               const char* value2Text,
@@ -43,10 +88,26 @@ struct DefaultFormatter
                             , const char *symbol);
 };
 
+struct DefaultHandler {
+    void operator()(const AssertionFailure &assertion) {
+        internal::onAssertionFailureDefaultHandler(assertion);
+    }
+};
+
+/**
+ * Type of runtime replaceable assertion handler
+ */
+using AssertionHandlerFunction = std::function<void(const AssertionFailure &)>;
+
 template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
 class CppAssertT
 {
 public:
+    CppAssertT()
+        :assertionHandler_(DefaultHandler())
+    {
+    }
+
     /**
      * Invoke assertion handler
      *
@@ -54,14 +115,46 @@ public:
      */
     void onAssertionFailure(const AssertionFailure &assertion);
 
+    /**
+     * Replaces assertion handler, it's invoked on every assertion failure
+     * instead of default one which prints failure and aborts
+     *
+     * @param   assertionHandler    New assertion handler
+     */
+    void setAssertionHandler(AssertionHandler assertionHandler);
+
+    /**
+     * Restores default assertion handler
+     */
+    void setDefaultHandler();
+
     /**
      * Return stack trace except top frames as std::string except
      * number of frames
      * @param   frames      Number of frames to be skipped
      * @return  Stack trace as std::string
      */
+    CPP_ASSERT_ALWAYS_INLINE
     std::string getStackTraceExceptTop(std::uint32_t frames);
 
+    /**
+     * Symbolizes and formats captured stack trace with formatFrame of
+     * installed formatter
+     * @param   frames      Stack trace to be formatted
+     * @return  Stack trace as std::string
+     */
+    std::string formatStackTrace(const internal::StackTrace &frames);
+
+    /**
+     * Symbolizes and formats captured stack trace with formatFrame of
+     * installed formatter, frames are appended to \p sink one by one
+     * and filtered by rules set with setStackTraceFilter
+     * @param   frames      Stack trace to be formatted
+     * @param   sink        Output stack trace is appended to
+     */
+    void appendStackTrace(const internal::StackTrace &frames,
+                          MessageSink &sink);
+
     /**
      * Returns a message for a bool assertion failures i.e. CPP_ASSERT_{TRUE|FALSE}
      *
@@ -122,7 +215,7 @@ public:
      * Returns user readable description of failed statement. Default
      * implementation is to return following:
      * @code
-        std::stringstream msg;
+        AssertionMessage msg;
         msg<< "Assertion failure: "<<statement;
      * @endcode
      *
@@ -139,19 +232,44 @@ public:
      * @return User readable description of user custom message
      */
     std::string formatStreamedMessage(const std::string &message);
+
+    /**
+     * Methods appending to \p sink format the same messages as methods
+     * returning std::string above, they don't allocate intermediate
+     * strings when formatter implements them, see
+     * internal::FormatterAdapter.
+     *
+     * @param   sink    Output the message is appended to
+     */
+    void formatBoolFailureMessage(MessageSink &sink,
+                                  const char* expressionText,
+                                  const char* actualPredicateValue,
+                                  const char* expectedPredicateValue);
+    void formatPredicateFailureMessage(MessageSink &sink,
+                                       const char* predicate,
+                                       const char* value1AsText,
+                                       const char* value2AsText,
+                                       const AssertionMessage &value1,
+                                       const AssertionMessage &value2);
+    void formatAssertionMessage(MessageSink &sink,
+                                const AssertionFailure &failure);
+    void formatStatementFailureMessage(MessageSink &sink,
+                                       const char *statement);
+    void formatStreamedMessage(MessageSink &sink,
+                               const AssertionMessage &message);
 private:
+    internal::FormatterAdapter<Formatter> getFormatter()
+    {
+        return internal::FormatterAdapter<Formatter>(formatter_);
+    }
+
     Formatter formatter_;
     LockingPolicy lockingPolicy_;
     AssertionHandler assertionHandler_;
 };
 
-struct DefaultHandler {
-    void operator()(const AssertionFailure &assertion) {
-        internal::onAssertionFailureDefaultHandler(assertion);
-    }
-};
-
-using DefaultImplType = CppAssertT<DefaultFormatter, std::mutex, DefaultHandler>;
+using DefaultImplType = CppAssertT<DefaultFormatter, std::mutex
+                                    , AssertionHandlerFunction>;
 /**
  * Provides default functionality for CPP_ASSERT macros
  */
@@ -186,11 +304,295 @@ public:
      * @param   frames      Number of frames to be skipped
      * @return  Stack trace as std::string
      */
+    CPP_ASSERT_ALWAYS_INLINE
     std::string getStackTraceExceptTop(std::uint32_t frames)
     {
         return static_cast<Impl*>(this)->getStackTraceExceptTop(frames);
     }
 
+    /**
+     * Symbolizes and formats captured stack trace with formatFrame of
+     * installed formatter
+     * @param   frames      Stack trace to be formatted
+     * @return  Stack trace as std::string
+     */
+    std::string formatStackTrace(const internal::StackTrace &frames)
+    {
+        return static_cast<Impl*>(this)->formatStackTrace(frames);
+    }
+
+    /**
+     * Symbolizes and formats captured stack trace with formatFrame of
+     * installed formatter, frames are appended to \p sink one by one
+     * and filtered by rules set with setStackTraceFilter
+     * @param   frames      Stack trace to be formatted
+     * @param   sink        Output stack trace is appended to
+     */
+    void appendStackTrace(const internal::StackTrace &frames,
+                          MessageSink &sink)
+    {
+        static_cast<Impl*>(this)->appendStackTrace(frames, sink);
+    }
+
+    /**
+     * Sets rules that bound rendered stack traces, i.e. hide frames of
+     * standard library or render at most given number of frames. Frames
+     * that aren't rendered because of frame limit aren't symbolized.
+     * By default all frames are rendered.
+     *
+     * @code
+        StackTraceFilter filter;
+        filter.maxFrames = 16;
+        filter.hiddenPrefixes = {"std::", "__gnu_cxx::"};
+        CppAssert::setStackTraceFilter(filter);
+     * @endcode
+     *
+     * @param   filter  New rules
+     */
+    static void setStackTraceFilter(StackTraceFilter filter)
+    {
+        internal::setStackTraceFilter(std::move(filter));
+    }
+
+    /**
+     * Returns rules that bound rendered stack traces
+     *
+     * @return  Current rules
+     */
+    static StackTraceFilter getStackTraceFilter()
+    {
+        const auto filter = internal::getStackTraceFilter();
+        return filter ? *filter : StackTraceFilter();
+    }
+
+    /**
+     * Returns all assertion sites linked into executable, sorted by
+     * source file name and line. List is collected from
+     * `cppassert_sites` section once, on first call. List is always
+     * empty on platforms without section support and doesn't contain
+     * sites compiled as position independent code of shared libraries,
+     * see CPP_ASSERT_HAVE_SITE_SECTION.
+     *
+     * @return  List of assertion sites
+     */
+    static const std::vector<const AssertionSite *> &getAssertionSites()
+    {
+        return internal::getAssertionSites();
+    }
+
+    /**
+     * Enables or disables assertion sites at given source file line.
+     * Disabled site doesn't evaluate its predicate. Only sites returned
+     * by getAssertionSites() can be found. Sites can be disabled also
+     * with `CPPASSERT_DISABLE` environment variable which is parsed once
+     * at startup, it's a comma separated list of entries:
+     *
+     * @code
+        CPPASSERT_DISABLE="Parser.cpp:120,*Network*.cpp,#8a3f01c2"
+     * @endcode
+     *
+     * where `file:line` entry is handled by this method, `#hash` by
+     * setSitesEnabledByHash and all other entries by setSitesEnabled.
+     *
+     * Sites compiled with CPP_ASSERT_STATIC_KEYS on x86-64 Linux are
+     * toggled by patching their code, site that can't be patched
+     * (i.e. `mprotect` is not permitted) keeps its state and isn't
+     * counted.
+     *
+     * @param   file        Source file name, it's enough to pass trailing
+     *                      path components i.e. "Parser.cpp" matches
+     *                      "/src/Parser.cpp"
+     * @param   line        Source file line
+     * @param   enabled     New state of matching sites
+     * @return  Number of sites matched
+     */
+    static std::size_t setSiteEnabled(const char *file,
+                                      std::uint32_t line,
+                                      bool enabled)
+    {
+        return internal::setSiteEnabled(file, line, enabled);
+    }
+
+    /**
+     * Enables or disables all assertion sites which source file name
+     * matches a glob, `*` matches any sequence of characters including
+     * path separators and `?` matches any single character.
+     *
+     * @param   fileGlob    Glob i.e. "*Network*.cpp"
+     * @param   enabled     New state of matching sites
+     * @return  Number of sites matched
+     */
+    static std::size_t setSitesEnabled(const char *fileGlob, bool enabled)
+    {
+        return internal::setSitesEnabled(fileGlob, enabled);
+    }
+
+    /**
+     * Enables or disables all assertion sites with given expression hash,
+     * see AssertionSite::getExpressionHash.
+     *
+     * @param   expressionHash  Expression hash
+     * @param   enabled         New state of matching sites
+     * @return  Number of sites matched
+     */
+    static std::size_t setSitesEnabledByHash(std::uint32_t expressionHash,
+                                             bool enabled)
+    {
+        return internal::setSitesEnabledByHash(expressionHash, enabled);
+    }
+
+    /**
+     * Overrides number of stack frames collected when assertion sites
+     * which source file name matches a glob fail, see
+     * AssertionSite::setStackDepth.
+     *
+     * @param   fileGlob    Glob i.e. "*Network*.cpp"
+     * @param   depth       Stack depth, 0 restores getMaxStackDepth()
+     * @return  Number of sites matched
+     */
+    static std::size_t setSitesStackDepth(const char *fileGlob,
+                                          std::uint8_t depth)
+    {
+        return internal::setSitesStackDepth(fileGlob, depth);
+    }
+
+    /**
+     * Returns number of patchable instructions of assertion sites compiled
+     * with CPP_ASSERT_STATIC_KEYS. Site inlined into several functions
+     * has one instruction per copy.
+     *
+     * @return  Number of static key instructions in executable
+     */
+    static std::size_t getStaticKeyCount()
+    {
+        return internal::getStaticKeyCount();
+    }
+
+    /**
+     * Sets runtime level threshold. Sites which level is above it don't
+     * evaluate their predicate, CPP_ASSERT_ALWAYS_* sites are always
+     * evaluated. Default threshold is AssertionLevel::Debug so that
+     * CPP_ASSERT_AUDIT sites, if compiled in (see CPP_ASSERT_LEVEL), are
+     * off until enabled. Threshold can be set also with `CPPASSERT_LEVEL`
+     * environment variable which is parsed once at startup, it's one of
+     * `always`, `cheap`, `debug` or `audit`.
+     *
+     * @param   level   New runtime threshold
+     */
+    static void setAssertionLevel(AssertionLevel level)
+    {
+        internal::setAssertionLevel(level);
+    }
+
+    /**
+     * Returns runtime level threshold
+     *
+     * @return  Current runtime threshold
+     */
+    static AssertionLevel getAssertionLevel()
+    {
+        return internal::getAssertionLevel();
+    }
+
+    /**
+     * Selects method used to collect stack traces of assertion failures.
+     * Default is StackUnwinder::Backtrace, it can be set also with
+     * `CPPASSERT_UNWINDER` environment variable which is parsed once at
+     * startup, it's one of `backtrace`, `unwind` or `frame-pointer`.
+     *
+     * @param   unwinder    Stack unwinder to be used
+     */
+    static void setStackUnwinder(StackUnwinder unwinder)
+    {
+        internal::setStackUnwinder(unwinder);
+    }
+
+    /**
+     * Returns method used to collect stack traces
+     *
+     * @return  Selected stack unwinder
+     */
+    static StackUnwinder getStackUnwinder()
+    {
+        return internal::getStackUnwinder();
+    }
+
+    /**
+     * Runs one stack capture, symbolization and formatting, so that the
+     * first assertion failure doesn't load `libgcc_s`, build symbol and
+     * line tables or create process wide caches, which allocates and
+     * takes loader lock, i.e. in a signal handler or under memory
+     * pressure. Warm up runs also during static initialization when
+     * `CPPASSERT_WARMUP` environment variable is set to `1`. Per thread
+     * buffers are allocated for calling thread only.
+     *
+     * @return  Time spent by steps of warm up
+     */
+    static WarmUpTimes warmUp()
+    {
+        return internal::warmUp();
+    }
+
+    /**
+     * Returns time spent by the last warm up, either the automatic one
+     * or the one run by warmUp()
+     *
+     * @return  Time spent by steps of warm up, zeros if it didn't run
+     */
+    static WarmUpTimes getWarmUpTimes()
+    {
+        return internal::getWarmUpTimes();
+    }
+
+    /**
+     * Sets maximal number of stack frames collected when assertion fails,
+     * unwinding stops there. Default is 64 frames, it can be set also
+     * with `CPPASSERT_STACK_DEPTH` environment variable which is parsed
+     * once at startup. Sites can override it, see setSitesStackDepth.
+     *
+     * @param   depth   Number of frames, 0 or depth above
+     *                  StackTrace::MaxDepth means StackTrace::MaxDepth
+     */
+    static void setMaxStackDepth(std::size_t depth)
+    {
+        internal::setMaxStackDepth(depth);
+    }
+
+    /**
+     * Returns maximal number of stack frames collected when assertion
+     * fails
+     *
+     * @return  Number of frames
+     */
+    static std::size_t getMaxStackDepth()
+    {
+        return internal::getMaxStackDepth();
+    }
+
+    /**
+     * Sets directory where symbol and line tables of modules are stored,
+     * named by build-id, so that later processes of the same build map
+     * them instead of reading debug information. Caching is disabled by
+     * default, directory can be set also with `CPPASSERT_SYMBOL_CACHE`
+     * environment variable. Tables already built are not written.
+     *
+     * @param   directory   Cache directory, empty disables caching
+     */
+    static void setSymbolCacheDirectory(const std::string &directory)
+    {
+        internal::SymbolCacheFile::setDirectory(directory);
+    }
+
+    /**
+     * Returns directory of symbol cache
+     *
+     * @return  Cache directory, empty if caching is disabled
+     */
+    static std::string getSymbolCacheDirectory()
+    {
+        return internal::SymbolCacheFile::getDirectory();
+    }
+
 
     /**
      * Returns a message for a bool assertion failures i.e. CPP_ASSERT_{TRUE|FALSE}
@@ -267,7 +669,7 @@ public:
      * Returns user readable description of failed statement. Default
      * implementation is to return following:
      * @code
-        std::stringstream msg;
+        AssertionMessage msg;
         msg<< "Assertion failure: "<<statement;
      * @endcode
      *
@@ -290,6 +692,59 @@ public:
     {
         return static_cast<Impl*>(this)->formatStreamedMessage(message);
     }
+
+    /**
+     * Methods appending to \p sink format the same messages as methods
+     * returning std::string above, they don't allocate intermediate
+     * strings when formatter implements them, see
+     * internal::FormatterAdapter.
+     *
+     * @param   sink    Output the message is appended to
+     */
+    void formatBoolFailureMessage(MessageSink &sink,
+                                  const char* expressionText,
+                                  const char* actualPredicateValue,
+                                  const char* expectedPredicateValue)
+    {
+        static_cast<Impl*>(this)->formatBoolFailureMessage(sink
+                                                , expressionText
+                                                , actualPredicateValue
+                                                , expectedPredicateValue);
+    }
+
+    void formatPredicateFailureMessage(MessageSink &sink,
+                                       const char* predicate,
+                                       const char* value1AsText,
+                                       const char* value2AsText,
+                                       const AssertionMessage &value1,
+                                       const AssertionMessage &value2)
+    {
+        static_cast<Impl*>(this)->formatPredicateFailureMessage(sink
+                                                , predicate
+                                                , value1AsText
+                                                , value2AsText
+                                                , value1
+                                                , value2);
+    }
+
+    void formatAssertionMessage(MessageSink &sink,
+                                const AssertionFailure &failure)
+    {
+        static_cast<Impl*>(this)->formatAssertionMessage(sink, failure);
+    }
+
+    void formatStatementFailureMessage(MessageSink &sink,
+                                       const char *statement)
+    {
+        static_cast<Impl*>(this)->formatStatementFailureMessage(sink
+                                                                , statement);
+    }
+
+    void formatStreamedMessage(MessageSink &sink,
+                               const AssertionMessage &message)
+    {
+        static_cast<Impl*>(this)->formatStreamedMessage(sink, message);
+    }
 private:
     CppAssertI()
     {
@@ -311,24 +766,48 @@ void CppAssertT<Formatter, LockingPolicy, AssertionHandler>::onAssertionFailure(
     assertionHandler(assertion);
 }
 
+template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
+void CppAssertT<Formatter, LockingPolicy, AssertionHandler>::setAssertionHandler(AssertionHandler assertionHandler)
+{
+    std::unique_lock<std::mutex> lock(lockingPolicy_);
+    assertionHandler_ = std::move(assertionHandler);
+}
+
+template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
+void CppAssertT<Formatter, LockingPolicy, AssertionHandler>::setDefaultHandler()
+{
+    std::unique_lock<std::mutex> lock(lockingPolicy_);
+    assertionHandler_ = DefaultHandler();
+}
+
 template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
 std::string CppAssertT<Formatter, LockingPolicy, AssertionHandler>::getStackTraceExceptTop(std::uint32_t skip)
 {
-    auto frames = internal::StackTrace::getStackTrace();
-    //skip current frame
-    skip += 1;
-    AssertionMessage msg;
-    if(frames.size()>skip)
+    //it's always inlined, so the caller is the first frame
+    return formatStackTrace(internal::StackTrace::getStackTrace(skip));
+}
+
+template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
+std::string CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatStackTrace(const internal::StackTrace &frames)
+{
+    std::string text;
+    MessageSink sink(text);
+    appendStackTrace(frames, sink);
+    return text;
+}
+
+template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
+void CppAssertT<Formatter, LockingPolicy, AssertionHandler>::appendStackTrace(const internal::StackTrace &frames, MessageSink &sink)
+{
+    const internal::StackTraceRenderer renderer(internal::getStackTraceFilter());
+    internal::FormatterAdapter<Formatter> formatter = getFormatter();
+    renderer.render(frames, sink, [&formatter](MessageSink &output
+                                               , std::uint32_t frameNumber
+                                               , const void *address
+                                               , const char *symbol)
     {
-        std::uint32_t frameNumber = skip;
-        for(; frameNumber<frames.size(); ++frameNumber)
-        {
-            msg<<formatter_.formatFrame(frameNumber-skip
-                            , frames[frameNumber].getAddress()
-                            , frames[frameNumber].getSymbol());
-        }
-    }
-    return msg.str();
+        formatter.formatFrame(output, frameNumber, address, symbol);
+    });
 }
 
 template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
@@ -336,7 +815,19 @@ std::string CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatBoolFa
                                 const char* actualPredicateValue,
                                 const char* expectedPredicateValue)
 {
-    return formatter_.formatBoolFailureMessage(expressionText
+    return getFormatter().formatBoolFailureMessage(expressionText
+                            , actualPredicateValue
+                            , expectedPredicateValue);
+}
+
+template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
+void CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatBoolFailureMessage(MessageSink &sink,
+                                const char* expressionText,
+                                const char* actualPredicateValue,
+                                const char* expectedPredicateValue)
+{
+    getFormatter().formatBoolFailureMessage(sink
+                            , expressionText
                             , actualPredicateValue
                             , expectedPredicateValue);
 }
@@ -348,30 +839,63 @@ std::string CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatPredic
                                 const std::string &value1,
                                 const std::string &value2)
 {
-    return formatter_.formatPredicateFailureMessage(predicate
+    return getFormatter().formatPredicateFailureMessage(predicate
                         , value1AsText
                         , value2AsText
                         , value1
                         , value2);
 }
 
+template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
+void CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatPredicateFailureMessage(MessageSink &sink,
+                                const char* predicate,
+                                const char* value1AsText,
+                                const char* value2AsText,
+                                const AssertionMessage &value1,
+                                const AssertionMessage &value2)
+{
+    getFormatter().formatPredicateFailureMessage(sink
+                        , predicate
+                        , value1AsText
+                        , value2AsText
+                        , value1
+                        , value2);
+}
 
 template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
 std::string CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatAssertionMessage(const AssertionFailure &assertion)
 {
-    return formatter_.formatAssertionMessage(assertion);
+    return getFormatter().formatAssertionMessage(assertion);
+}
+
+template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
+void CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatAssertionMessage(MessageSink &sink, const AssertionFailure &assertion)
+{
+    getFormatter().formatAssertionMessage(sink, assertion);
 }
 
 template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
 std::string CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatStatementFailureMessage(const char *statement)
 {
-    return formatter_.formatStatementFailureMessage(statement);
+    return getFormatter().formatStatementFailureMessage(statement);
+}
+
+template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
+void CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatStatementFailureMessage(MessageSink &sink, const char *statement)
+{
+    getFormatter().formatStatementFailureMessage(sink, statement);
 }
 
 template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
 std::string CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatStreamedMessage(const std::string &message)
 {
-    return formatter_.formatStreamedMessage(message);
+    return getFormatter().formatStreamedMessage(message);
+}
+
+template<typename Formatter, typename LockingPolicy, typename AssertionHandler>
+void CppAssertT<Formatter, LockingPolicy, AssertionHandler>::formatStreamedMessage(MessageSink &sink, const AssertionMessage &message)
+{
+    getFormatter().formatStreamedMessage(sink, message);
 }
 
 } //cppassert
@@ -0,0 +1,142 @@
+#pragma once
+#ifndef CPP_ASSERT_MESSAGESINK_HPP
+#define	CPP_ASSERT_MESSAGESINK_HPP
+#include <cppassert/details/AssertionMessage.hpp>
+#include <cstddef>
+#include <string>
+
+namespace cppassert
+{
+
+/**
+ * Output of formatters, text is appended directly to a buffer owned by
+ * the caller, so that a whole failure report is built without temporary
+ * strings. Buffer is one of:
+ *
+ *  - fixed array of characters, text that doesn't fit is dropped and the
+ *    array is always null terminated, it never allocates
+ *  - std::string, it grows as needed
+ *  - AssertionMessage, it grows as needed and is truncated when heap is
+ *    exhausted
+ *
+ * Values are formatted the same way as by AssertionMessage with default
+ * formatting flags.
+ */
+class MessageSink
+{
+    MessageSink(const MessageSink &) = delete;
+    MessageSink &operator=(const MessageSink &) = delete;
+public:
+    /**
+     * Creates sink writing to fixed buffer
+     *
+     * @param   buffer      Buffer of \p capacity characters
+     * @param   capacity    Size of \p buffer including null terminator
+     */
+    MessageSink(char *buffer, std::size_t capacity);
+
+    /**
+     * Creates sink appending to a string
+     *
+     * @param   output  String text is appended to
+     */
+    explicit MessageSink(std::string &output);
+
+    /**
+     * Creates sink appending to a message
+     *
+     * @param   output  Message text is appended to
+     */
+    explicit MessageSink(internal::AssertionMessage &output);
+
+    /**
+     * Appends characters as they are
+     *
+     * @param   text    Characters to be appended
+     * @param   length  Number of characters
+     */
+    void append(const char *text, std::size_t length);
+
+    /**
+     * Appends null terminated string
+     * @param   text    String to be appended, null is displayed as "(null)"
+     * @return  Reference to (*this) to allow chain calls
+     */
+    MessageSink &operator<<(const char *text);
+    MessageSink &operator<<(const std::string &text);
+    MessageSink &operator<<(const internal::AssertionMessage &message);
+    MessageSink &operator<<(char character);
+
+    /**
+     * Appends decimal number padded to width set by setWidth()
+     * @param   value   Number to be appended
+     * @return  Reference to (*this) to allow chain calls
+     */
+    MessageSink &operator<<(int value);
+    MessageSink &operator<<(unsigned int value);
+    MessageSink &operator<<(long value);
+    MessageSink &operator<<(unsigned long value);
+    MessageSink &operator<<(long long value);
+    MessageSink &operator<<(unsigned long long value);
+
+    /**
+     * Appends address as zero padded hexadecimal number
+     * @param   pointer     Address to be appended, null is displayed
+     *                      as "(null)"
+     * @return  Reference to (*this) to allow chain calls
+     */
+    MessageSink &operator<<(const void *pointer);
+    MessageSink &operator<<(std::nullptr_t);
+
+    /**
+     * Sets minimal width of next number, it's padded with spaces
+     *
+     * @param   width   Minimal number of characters
+     */
+    void setWidth(std::size_t width)
+    {
+        width_ = width;
+    }
+
+    /**
+     * Returns number of characters appended to the buffer by this sink
+     *
+     * @return  Number of characters
+     */
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * Tests whether some text didn't fit into fixed buffer
+     *
+     * @return  true if text was dropped
+     */
+    bool isTruncated() const
+    {
+        return truncated_;
+    }
+private:
+    enum class Kind
+    {
+        Buffer,
+        String,
+        Message
+    };
+
+    void print(const char *format, ...);
+
+    Kind kind_;
+    char *buffer_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::string *string_ = nullptr;
+    internal::AssertionMessage *message_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t width_ = 0;
+    bool truncated_ = false;
+};
+
+} //cppassert
+
+#endif	/* CPP_ASSERT_MESSAGESINK_HPP */
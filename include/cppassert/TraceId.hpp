@@ -0,0 +1,73 @@
+#pragma once
+#ifndef CPP_ASSERT_TRACEID_HPP
+#define	CPP_ASSERT_TRACEID_HPP
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <cppassert/details/StackTrace.hpp>
+
+namespace cppassert
+{
+
+/**
+ * Identifier of an interned stack trace. Return addresses of captured
+ * stacks are stored once per distinct stack in a process wide table, so
+ * equal stacks have equal ids and an id can be attached to an object or
+ * an event for 4 bytes. Traces are never released, an id stays valid for
+ * the process lifetime.
+ */
+enum class TraceId : std::uint32_t
+{
+    Empty = 0   ///< Id of empty trace i.e. when stack can't be collected
+};
+
+/**
+ * Collects return addresses of current stack, up to
+ * CppAssert::getMaxStackDepth() frames, and interns them. Lookup of a
+ * stack that was captured before doesn't lock nor allocate, the first
+ * capture of a stack appends it to the table under a lock. Frames are
+ * not symbolized.
+ *
+ * @param   framesToSkip    Number of frames below the caller that
+ *                          shouldn't be included, 0 means that the first
+ *                          frame is the caller
+ * @return  Id of the stack, TraceId::Empty if it can't be collected or
+ *          the table is full
+ */
+CPP_ASSERT_LIBRARY_CODE TraceId capture(std::size_t framesToSkip = 0);
+
+/**
+ * Returns number of frames of interned stack
+ *
+ * @param   id  Trace id returned by capture()
+ * @return  Number of frames, 0 for TraceId::Empty
+ */
+std::size_t getTraceSize(TraceId id);
+
+/**
+ * Creates stack trace of interned stack, frames are symbolized on demand
+ *
+ * @param   id  Trace id returned by capture()
+ * @return  Stack trace, empty for TraceId::Empty
+ */
+internal::StackTrace getStackTrace(TraceId id);
+
+/**
+ * Symbolizes interned stack and formats it with
+ * CppAssert::formatStackTrace
+ *
+ * @param   id  Trace id returned by capture()
+ * @return  Stack trace as text, empty for TraceId::Empty
+ */
+std::string toString(TraceId id);
+
+/**
+ * Returns number of distinct stacks interned so far
+ *
+ * @return  Number of interned stacks
+ */
+std::size_t getTraceCount();
+
+} //cppassert
+
+#endif	/* CPP_ASSERT_TRACEID_HPP */
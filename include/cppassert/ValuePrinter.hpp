@@ -0,0 +1,311 @@
+#pragma once
+#ifndef CPP_ASSERT_VALUEPRINTER_HPP
+#define	CPP_ASSERT_VALUEPRINTER_HPP
+#include "details/AssertionMessage.hpp"
+#include "details/TypeTraits.hpp"
+#include <cstddef>
+
+namespace cppassert
+{
+namespace internal
+{
+/**
+ * Appends decimal representation of integer, it doesn't depend on locale
+ * nor on formatting flags of the message
+ *
+ * @param   message     Message value is appended to
+ * @param   value       Integer to be printed
+ */
+void printInteger(AssertionMessage &message, long long value);
+void printInteger(AssertionMessage &message, unsigned long long value);
+
+/**
+ * Appends the shortest decimal representation of floating point number
+ * which is parsed back to the same value, decimal point is always '.'
+ *
+ * @param   message     Message value is appended to
+ * @param   value       Number to be printed
+ */
+void printFloatingPoint(AssertionMessage &message, float value);
+void printFloatingPoint(AssertionMessage &message, double value);
+void printFloatingPoint(AssertionMessage &message, long double value);
+
+/**
+ * Appends character in quotes followed by its code i.e. `'a' (97)`,
+ * characters that are not printable are escaped
+ *
+ * @param   message     Message value is appended to
+ * @param   character   Character to be printed
+ * @param   code        Numeric value of character
+ */
+void printCharacter(AssertionMessage &message, char character, int code);
+
+/**
+ * Appends address as hexadecimal number with `0x` prefix
+ *
+ * @param   message     Message value is appended to
+ * @param   pointer     Address to be printed
+ */
+void printPointer(AssertionMessage &message, const volatile void *pointer);
+
+/*
+ * Pointers to characters are printed as strings, the same way they are
+ * streamed
+ */
+inline void printPointer(AssertionMessage &message, const char *text)
+{
+    message<<text;
+}
+
+inline void printPointer(AssertionMessage &message, const signed char *text)
+{
+    message<<reinterpret_cast<const char *>(text);
+}
+
+inline void printPointer(AssertionMessage &message, const unsigned char *text)
+{
+    message<<reinterpret_cast<const char *>(text);
+}
+
+/**
+ * Appends object representation of a value which can't be streamed i.e.
+ * `8-byte object <01 00 00 00 02 00 00 00>`
+ *
+ * @param   message     Message value is appended to
+ * @param   object      Address of the object
+ * @param   size        Size of the object
+ */
+void printObjectBytes(AssertionMessage &message, const void *object,
+                      std::size_t size);
+
+struct StreamableTag {};
+struct NotStreamableTag {};
+
+template<typename T>
+inline void printObject(AssertionMessage &message, const T &value,
+                        StreamableTag)
+{
+    message<<value;
+}
+
+template<typename T>
+inline void printObject(AssertionMessage &message, const T &value,
+                        NotStreamableTag)
+{
+    printObjectBytes(message, &value, sizeof(value));
+}
+} //internal
+
+/**
+ * @class ValuePrinter
+ *
+ * Prints arguments of `CPP_ASSERT[_ALWAYS]_{EQ|NE|LE|LT|GE|GT}` macros
+ * when assertion fails. Integers, floating point numbers and pointers are
+ * formatted by the library without std::ostream, floating point numbers
+ * with the shortest representation that is parsed back to the same
+ * value. Strings are printed as they are. Other types, enumerations
+ * included, are streamed with their `operator<<(std::ostream &, const T &)`
+ * found by argument dependent lookup, see internal::IsStreamable.
+ * Enumerations without it are printed as their underlying integer and
+ * other types as bytes of their object representation, so any type that
+ * can be compared can be used in assertion.
+ *
+ * Printing of user type can be customized by specialization in
+ * `cppassert` namespace:
+ *
+ *      namespace cppassert
+ *      {
+ *      template<>
+ *      struct ValuePrinter<Point>
+ *      {
+ *          static void print(AssertionMessage &message, const Point &value)
+ *          {
+ *              message<<'('<<value.x<<", "<<value.y<<')';
+ *          }
+ *      };
+ *      }
+ *
+ * Second template parameter allows partial specialization for a group of
+ * types selected with std::enable_if.
+ */
+template<typename T, typename Enable = void>
+struct ValuePrinter
+{
+    static void print(AssertionMessage &message, const T &value)
+    {
+        internal::printObject(message, value,
+                              typename internal::Conditional<
+                                    internal::IsStreamable<T>::value,
+                                    internal::StreamableTag,
+                                    internal::NotStreamableTag>::type());
+    }
+};
+
+#define CPP_ASSERT_DEFINE_VALUE_PRINTER(type, function, printedType) \
+template<> \
+struct ValuePrinter<type> \
+{ \
+    static void print(AssertionMessage &message, type value) \
+    { \
+        function(message, static_cast<printedType>(value)); \
+    } \
+}
+
+CPP_ASSERT_DEFINE_VALUE_PRINTER(short, internal::printInteger, long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(unsigned short, internal::printInteger,
+                                unsigned long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(int, internal::printInteger, long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(unsigned int, internal::printInteger,
+                                unsigned long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(long, internal::printInteger, long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(unsigned long, internal::printInteger,
+                                unsigned long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(long long, internal::printInteger, long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(unsigned long long, internal::printInteger,
+                                unsigned long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(wchar_t, internal::printInteger, long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(char16_t, internal::printInteger,
+                                unsigned long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(char32_t, internal::printInteger,
+                                unsigned long long);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(float, internal::printFloatingPoint, float);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(double, internal::printFloatingPoint, double);
+CPP_ASSERT_DEFINE_VALUE_PRINTER(long double, internal::printFloatingPoint,
+                                long double);
+
+#undef CPP_ASSERT_DEFINE_VALUE_PRINTER
+
+template<>
+struct ValuePrinter<char>
+{
+    static void print(AssertionMessage &message, char value)
+    {
+        internal::printCharacter(message, value, value);
+    }
+};
+
+template<>
+struct ValuePrinter<signed char>
+{
+    static void print(AssertionMessage &message, signed char value)
+    {
+        internal::printCharacter(message, static_cast<char>(value), value);
+    }
+};
+
+template<>
+struct ValuePrinter<unsigned char>
+{
+    static void print(AssertionMessage &message, unsigned char value)
+    {
+        internal::printCharacter(message, static_cast<char>(value), value);
+    }
+};
+
+template<>
+struct ValuePrinter<bool>
+{
+    static void print(AssertionMessage &message, bool value)
+    {
+        message<<value;
+    }
+};
+
+template<>
+struct ValuePrinter<std::string>
+{
+    static void print(AssertionMessage &message, const std::string &value)
+    {
+        message<<value;
+    }
+};
+
+template<>
+struct ValuePrinter<std::nullptr_t>
+{
+    static void print(AssertionMessage &message, std::nullptr_t)
+    {
+        message<<nullptr;
+    }
+};
+
+template<typename T>
+struct ValuePrinter<T, typename internal::EnableIf<
+                                internal::IsEnum<T>::value
+                                && !internal::IsStreamable<T>::value>::type>
+{
+    static void print(AssertionMessage &message, T value)
+    {
+        using UnderlyingType = typename internal::UnderlyingType<T>::type;
+        using PrintedType = typename internal::Conditional<
+                                internal::IsSigned<UnderlyingType>::value,
+                                long long,
+                                unsigned long long>::type;
+        internal::printInteger(message, static_cast<PrintedType>(
+                                    static_cast<UnderlyingType>(value)));
+    }
+};
+
+template<typename T>
+struct ValuePrinter<T *>
+{
+    static void print(AssertionMessage &message, T *value)
+    {
+        if(value==nullptr)
+        {
+            message<<nullptr;
+            return;
+        }
+        internal::printPointer(message, value);
+    }
+};
+
+template<typename Result, typename... Arguments>
+struct ValuePrinter<Result (*)(Arguments...)>
+{
+    static void print(AssertionMessage &message,
+                      Result (*value)(Arguments...))
+    {
+        if(value==nullptr)
+        {
+            message<<nullptr;
+            return;
+        }
+        internal::printPointer(message, reinterpret_cast<const void *>(value));
+    }
+};
+
+template<typename Result, typename... Arguments>
+struct ValuePrinter<Result (*)(Arguments..., ...)>
+{
+    static void print(AssertionMessage &message,
+                      Result (*value)(Arguments..., ...))
+    {
+        if(value==nullptr)
+        {
+            message<<nullptr;
+            return;
+        }
+        internal::printPointer(message, reinterpret_cast<const void *>(value));
+    }
+};
+
+namespace internal
+{
+/**
+ * Prints argument of comparison assertion with ValuePrinter of its
+ * decayed type. Type is given explicitly, it's FailureType of
+ * PredicateArgument, so that arrays are printed as pointers.
+ *
+ * @param   message     Message value is appended to
+ * @param   value       Argument of assertion
+ */
+template<typename T>
+inline void printValue(AssertionMessage &message, T value)
+{
+    ValuePrinter<typename Decay<T>::type>::print(message, value);
+}
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_VALUEPRINTER_HPP */
@@ -1,78 +1,81 @@
 #pragma once
 #ifndef CPP_ASSERT_ASSERTIONMESSAGE_HPP
 #define	CPP_ASSERT_ASSERTIONMESSAGE_HPP
-#include <memory>
-#include <sstream>
+#include "TypeTraits.hpp"
+#include <iosfwd>
 #include <cstddef>
-#include <iomanip>
-#include <type_traits>
-#include <cstdint>
+//std::string is declared by <iosfwd> of libstdc++ and libc++ only
+#if defined(_MSC_VER)
+#   include <string>
+#endif
 
 namespace cppassert
 {
 namespace internal
 {
+/*
+ * Converts to std::ostream & by user defined conversion only, so that
+ * neither members of std::ostream nor operators of namespace std are
+ * candidates for it
+ */
+struct StreamArgument
+{
+    operator std::ostream &() const;
+};
+
+/**
+ * Tests whether non member `operator<<(std::ostream &, const T &)` of T is
+ * found by argument dependent lookup. Members of std::ostream and operators
+ * of namespace std are not considered, so the result is the same whether
+ * std::ostream is complete in a translation unit or not. Operators taking
+ * any `std::basic_ostream<Char, Traits> &` are not found either.
+ */
+template<typename T>
+struct IsStreamable
+{
+    template<typename U>
+    static char test(decltype(static_cast<void>(
+                operator<<(declareValue<StreamArgument>(),
+                           declareValue<const U &>()))) *);
+
+    template<typename U>
+    static long test(...);
+
+    static const bool value = (sizeof(test<T>(nullptr))==sizeof(char));
+};
 
-    template<typename T>
-    struct PointerHelper 
-    {
-        PointerHelper(std::ostream &str)
-            :stream_(&str)
-        {
-            
-        }
-        
-        inline std::ostream& write(const T *const &pointer) 
-        {
-             (*stream_)<<pointer;
-             return (*stream_);
-        }
-               
-        
-        std::ostream* stream_;
-    };
-    
-    template<>
-    struct PointerHelper<void>
-    {
-        PointerHelper(std::ostream &str)
-            :stream_(&str)
-        {
-            
-        }
-        
-        std::ostream& write(void const *pointer) 
-        {
-            std::uintptr_t value = reinterpret_cast<std::uintptr_t>(pointer);
-            (*stream_)<<"0x"
-                <<std::setfill ('0') << std::setw(sizeof(void const *)*2)
-                <<std::hex
-                <<value;
-                         
-            return (*stream_);
-        }
-                
-        std::ostream* stream_;
-    };
-        
 /**
  *  Provides streaming operator to CPP_ASSERT_* macros
+ *
+ *  Message is built in a buffer of InlineCapacity characters stored in the
+ *  object and it's moved to the heap only when it gets longer. If heap
+ *  allocation fails message is truncated, so that failure can be reported
+ *  even when heap is exhausted.
+ *
+ *  Formatting of fundamental types, strings and pointers is implemented in
+ *  the library without std::ostream, so that this header doesn't depend on
+ *  iostreams. Other types are streamed with their
+ *  `operator<<(std::ostream &, const T &)` to a stream writing to this
+ *  message, which requires std::ostream to be complete only for types that
+ *  are converted to one of the types above implicitly.
  */
 class AssertionMessage
 {
     AssertionMessage(const AssertionMessage &) = delete;
     AssertionMessage &operator=(const AssertionMessage &) = delete;
 public:
+    enum
+    {
+        InlineCapacity = 256
+    };
+
     /**
      * Move constructor, needs to be implemented by hand
      * until Visual C++ compiler will support generation default
      * implementation.
      * @param   other   Object to be moved
      */
-    AssertionMessage(AssertionMessage &&other)
-    {
-            stream_ = std::move(other.stream_);
-    }
+    AssertionMessage(AssertionMessage &&other);
 
     /**
      * Move assignment operator, needs to be implemented by hand
@@ -80,14 +83,12 @@ public:
      * implementation.
      * @param   other   Object to be moved
      */
-    AssertionMessage &operator=(AssertionMessage &&other)
-    {
-            stream_ = std::move(other.stream_);
-            return (*this);
-    }
+    AssertionMessage &operator=(AssertionMessage &&other);
 
     AssertionMessage();
 
+    ~AssertionMessage();
+
     /**
      * Streams boolean value
      * @param   value   value to be streamed as text
@@ -98,6 +99,41 @@ public:
         return *this << (value ? "true" : "false");
     }
 
+    /**
+     * Streams characters and numbers, formatting flags set by
+     * manipulators are respected.
+     * @param   value   value to be streamed as text
+     * @return  Reference to (*this) to allow chain calls
+     */
+    AssertionMessage& operator<<(char value);
+    AssertionMessage& operator<<(signed char value);
+    AssertionMessage& operator<<(unsigned char value);
+    AssertionMessage& operator<<(short value);
+    AssertionMessage& operator<<(unsigned short value);
+    AssertionMessage& operator<<(int value);
+    AssertionMessage& operator<<(unsigned int value);
+    AssertionMessage& operator<<(long value);
+    AssertionMessage& operator<<(unsigned long value);
+    AssertionMessage& operator<<(long long value);
+    AssertionMessage& operator<<(unsigned long long value);
+    AssertionMessage& operator<<(float value);
+    AssertionMessage& operator<<(double value);
+    AssertionMessage& operator<<(long double value);
+
+    /**
+     * Streams null terminated string
+     * @param   text    String to be streamed, null is displayed as "(null)"
+     * @return  Reference to (*this) to allow chain calls
+     */
+    AssertionMessage& operator<<(const char *text);
+
+    /**
+     * Streams string
+     * @param   text    String to be streamed
+     * @return  Reference to (*this) to allow chain calls
+     */
+    AssertionMessage& operator<<(const std::string &text);
+
     /**
      * Streams a non-pointer value to this object.
      * @param val
@@ -106,8 +142,11 @@ public:
     template <typename T>
     inline AssertionMessage& operator<<(const T& val)
     {
-        getStream() << val;
-        return *this;
+        return stream(val, typename Conditional<
+                                    IsUnscopedEnum<T>::value
+                                    && !IsStreamable<T>::value,
+                                    EnumTag,
+                                    ObjectTag>::type());
     }
     /**
      * Streams pointer to this object, null pointers
@@ -121,21 +160,20 @@ public:
     {
         if(pointer == nullptr)
         {
-            (*this)<<nullptr;
-        }
-        else
-        {            
-           using remove_cv_t = typename std::remove_cv<T>::type;
-           PointerHelper<remove_cv_t>(getStream()).write(pointer);
+            return (*this)<<nullptr;
         }
-        return *this;
+        return streamPointer(pointer);
     }
 
- 
+
     /**
      * Type definition for std::ostream manipulators like @c std::endl
      */
     using StdIoManipulatorType = std::ostream& (*)(std::ostream&);
+    /**
+     * Type definition for std::ios_base manipulators like @c std::hex
+     */
+    using StdIosBaseManipulatorType = std::ios_base& (*)(std::ios_base&);
     /**
      *  @brief  Interface for manipulators.
      *
@@ -143,27 +181,69 @@ public:
      *  functions in constructs like "std::cout << std::endl".  For more
      *  information, see the iomanip header.
      */
-    AssertionMessage& operator<<(StdIoManipulatorType manipulator)
-    {
-      getStream()<<manipulator;
-      return (*this);
-    }
+    AssertionMessage& operator<<(StdIoManipulatorType manipulator);
+    AssertionMessage& operator<<(StdIosBaseManipulatorType manipulator);
     /**
      * Streams C++11 nullptr type
      * @param   nullptr
      * @return  Reference to (*this) to allow chain calls
      */
-    AssertionMessage &operator<<(std::nullptr_t)
+    AssertionMessage &operator<<(std::nullptr_t);
+
+    /**
+     * Sets minimal width of next formatted value, same as std::setw but
+     * doesn't require std::ostream
+     *
+     * @param   width   Minimal number of characters
+     */
+    void setWidth(std::size_t width)
     {
-        getStream()<<"(null)";
-        return (*this);
+        width_ = static_cast<std::ptrdiff_t>(width);
+    }
+
+    /**
+     * Sets character used to pad values to the width, same as
+     * std::setfill but doesn't require std::ostream
+     *
+     * @param   fill    Fill character
+     */
+    void setFill(char fill)
+    {
+        fill_ = fill;
     }
+
+    /**
+     * Appends characters as they are, formatting flags don't apply
+     *
+     * @param   text    Characters to be appended
+     * @param   length  Number of characters
+     */
+    void append(const char *text, std::size_t length);
+
     /**
      * Returns text streamed to this object as std::string
      * @return  All the text streamed so far as std::string
      */
     std::string str() const;
 
+    /**
+     * Returns text streamed to this object, it's not null terminated
+     * @return  Pointer to size() characters
+     */
+    inline const char *data() const
+    {
+        return data_;
+    }
+
+    /**
+     * Returns number of characters streamed to this object
+     * @return  Message length
+     */
+    inline std::size_t size() const
+    {
+        return size_;
+    }
+
     /**
      * Tests whether object contains any content streamed
      *
@@ -171,21 +251,80 @@ public:
      */
     inline bool empty() const
     {
-        return static_cast<bool>(stream_.get()==nullptr);
+        return (size_==0);
+    }
+
+private:
+    struct EnumTag {};
+    struct ObjectTag {};
+    class StreamAdapter;
+
+    /*
+     * Unscoped enumerations without their own operator<< are streamed as
+     * their promoted underlying type, the same way std::ostream does it.
+     * Scoped ones don't convert to it and are streamed by their own
+     * operator<<.
+     */
+    template <typename T>
+    AssertionMessage& stream(const T& value, EnumTag)
+    {
+        return (*this)<<(+value);
     }
 
-private:    
-    inline std::ostream &getStream()
+    template <typename T>
+    AssertionMessage& stream(const T& value, ObjectTag)
     {
-        if(stream_.get()==nullptr)
-        {
-            stream_.reset(new std::stringstream);
-        }
-        
-        return  *stream_;
+        getStream()<<value;
+        releaseStream();
+        return (*this);
+    }
+
+    /*
+     * Pointers to void are displayed as zero padded hexadecimal address,
+     * pointers to characters as strings and other pointers as
+     * std::ostream displays them
+     */
+    template <typename T>
+    AssertionMessage& streamPointer(const volatile T *pointer)
+    {
+        return streamObjectPointer(pointer);
     }
-   
-    std::unique_ptr<std::stringstream> stream_;
+
+    AssertionMessage& streamObjectPointer(const volatile void *pointer);
+    AssertionMessage& streamPointer(const void *pointer);
+    AssertionMessage& streamPointer(const char *text);
+    AssertionMessage& streamPointer(const signed char *text);
+    AssertionMessage& streamPointer(const unsigned char *text);
+
+    /*
+     * Stream used for other types, its formatting state is synchronized
+     * with state of this object by getStream() and releaseStream()
+     */
+    std::ostream &getStream();
+    void releaseStream();
+
+    bool reserve(std::size_t length);
+    void print(const char *format, ...);
+    void pad(std::size_t start, std::size_t internal);
+    void appendText(const char *text, std::size_t length);
+    void appendCharacter(char character);
+    void appendSigned(long long value, unsigned long long bits);
+    void appendUnsigned(unsigned long long value);
+    void appendFloatingPoint(double value);
+    void appendFloatingPoint(long double value);
+    void moveFrom(AssertionMessage &other);
+    void release();
+
+    char *data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = InlineCapacity;
+    //std::ios_base::fmtflags
+    unsigned long flags_;
+    std::ptrdiff_t width_ = 0;
+    std::ptrdiff_t precision_ = 6;
+    char fill_ = ' ';
+    StreamAdapter *stream_ = nullptr;
+    char inline_[InlineCapacity];
 };
 
 
@@ -196,4 +335,3 @@ using AssertionMessage = internal::AssertionMessage;
 } //asrt
 
 #endif	/* CPP_ASSERT_ASSERTIONMESSAGE_HPP */
-
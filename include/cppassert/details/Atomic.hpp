@@ -0,0 +1,37 @@
+#pragma once
+#ifndef CPP_ASSERT_ATOMIC_HPP
+#define	CPP_ASSERT_ATOMIC_HPP
+#include <cstdint>
+
+namespace cppassert
+{
+namespace internal
+{
+/*
+ * Relaxed atomic access to bytes shared between threads, i.e. site state
+ * and level threshold. <atomic> includes <type_traits> and is most of
+ * preprocessed cppassert/Assert.hpp, so it's replaced by compiler
+ * builtins. Byte access is a single instruction on every supported
+ * architecture, other compilers rely on volatile access for it.
+ */
+inline std::uint8_t loadRelaxed(const std::uint8_t &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(&value, __ATOMIC_RELAXED);
+#else
+    return *static_cast<const volatile std::uint8_t *>(&value);
+#endif
+}
+
+inline void storeRelaxed(std::uint8_t &value, std::uint8_t newValue)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(&value, newValue, __ATOMIC_RELAXED);
+#else
+    *static_cast<volatile std::uint8_t *>(&value) = newValue;
+#endif
+}
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_ATOMIC_HPP */
@@ -1,6 +1,7 @@
 #pragma once
 #ifndef CPPASSERT_DEBUGPRINT_HPP
 #define	CPPASSERT_DEBUGPRINT_HPP
+#include <cstddef>
 
 namespace cppassert
 {
@@ -12,6 +13,13 @@ namespace internal
  */
 void PrintMessageToStdErr(const char *message);
 
+/**
+ * Prints message of given length to stderr and flushes stderr, message
+ * doesn't need to be null terminated
+ *
+ */
+void PrintMessageToStdErr(const char *message, std::size_t length);
+
 } //internal
 } //cppassert
 
@@ -0,0 +1,158 @@
+#pragma once
+#ifndef CPP_ASSERT_DWARFLINETABLE_HPP
+#define	CPP_ASSERT_DWARFLINETABLE_HPP
+#include <cppassert/details/ElfSymbolTable.hpp>
+#include <cppassert/details/StackTrace.hpp>
+#include <cppassert/details/SymbolCache.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(CPP_ASSERT_HAVE_ELF_SYMBOLS) && defined(CPP_ASSERT_HAVE_DWARF)
+#   define CPP_ASSERT_HAVE_DWARF_LINES 1
+#endif
+
+namespace cppassert
+{
+namespace internal
+{
+
+/**
+ * Source locations of a module decoded from its DWARF debug information.
+ * Line programs of `.debug_line` are decoded into an array of rows sorted
+ * by address and ranges of inlined calls are read from `.debug_info`, so
+ * that a location is found by binary search. Debug information is read
+ * from the module itself or from a separate debug file found through its
+ * build-id or `.gnu_debuglink` section under `/usr/lib/debug`. If symbol
+ * cache is enabled decoded table is stored in SymbolCacheFile of module
+ * build-id and rows of later tables of the same build are searched in
+ * the cache.
+ */
+class DwarfLineTable
+{
+    DwarfLineTable(const DwarfLineTable &) = delete;
+    DwarfLineTable &operator=(const DwarfLineTable &) = delete;
+public:
+    /**
+     * Returns line table of module at \p modulePath, table is decoded on
+     * first call for the module and cached for the process lifetime
+     *
+     * @param   modulePath  Path of executable or shared library
+     * @return  Line table, empty if module has no debug information
+     */
+    static const DwarfLineTable &getTable(const char *modulePath);
+
+    /**
+     * Decodes line table of module at \p modulePath which doesn't have to
+     * be loaded into the process, i.e. a binary or its debug file found
+     * by an offline symbolizer. Table is not cached.
+     *
+     * @param   modulePath  Path of module or of its debug file
+     * @return  Line table, empty if module has no debug information
+     */
+    static std::unique_ptr<DwarfLineTable> create(const char *modulePath);
+
+    /**
+     * Finds source locations of an instruction. The first location is
+     * the one of the instruction, the following ones are call sites of
+     * inlined functions from the innermost one.
+     *
+     * @param[in]   address         Address of instruction in module file
+     * @param[out]  locations       Found locations
+     * @param[in]   maxLocations    Size of \p locations
+     * @return  Number of locations written to \p locations
+     */
+    std::size_t findLocations(std::uintptr_t address,
+                              SourceLocation *locations,
+                              std::size_t maxLocations) const;
+
+    /**
+     * Tests whether debug information was found
+     * @return  true if there is no line information
+     */
+    bool isEmpty() const;
+
+    /**
+     * Tests whether table was read from symbol cache
+     * @return  true if rows are stored in mapped cache file
+     */
+    bool isCached() const;
+
+    ~DwarfLineTable();
+private:
+    explicit DwarfLineTable(const char *modulePath);
+
+    class Loader;
+    friend class Loader;
+
+    /*
+     * Row of line table, end of sequence has InvalidFile
+     */
+    struct Row
+    {
+        std::uintptr_t address;
+        std::uint32_t file;
+        std::uint32_t line;
+    };
+
+    /*
+     * Address range of function, calls inlined into it are
+     * calls_[firstCall, lastCall)
+     */
+    struct Function
+    {
+        std::uintptr_t begin;
+        std::uintptr_t end;
+        std::uint32_t firstCall;
+        std::uint32_t lastCall;
+    };
+
+    /*
+     * Address range of inlined function and its call site, depth is
+     * 1 for functions inlined directly into the function
+     */
+    struct InlinedCall
+    {
+        std::uintptr_t begin;
+        std::uintptr_t end;
+        const char *function;
+        std::uint32_t depth;
+        std::uint32_t file;
+        std::uint32_t line;
+    };
+
+    /*
+     * Inlined call as it's stored in symbol cache, function is offset
+     * of its name or InvalidName
+     */
+    struct CachedCall
+    {
+        std::uintptr_t begin;
+        std::uintptr_t end;
+        std::uint32_t function;
+        std::uint32_t depth;
+        std::uint32_t file;
+        std::uint32_t line;
+    };
+
+    static const std::uint32_t InvalidFile = UINT32_MAX;
+    static const std::uint32_t InvalidName = UINT32_MAX;
+
+    const char *getFile(std::uint32_t file) const;
+    bool loadCache(const std::string &buildId);
+    void writeCache(const std::string &buildId) const;
+
+    ElfImage image_;
+    SymbolCacheFile cache_;
+    std::vector<std::string> files_;
+    CachedArray<Row> rows_;
+    CachedArray<Function> functions_;
+    std::vector<InlinedCall> calls_;
+};
+
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_DWARFLINETABLE_HPP */
@@ -0,0 +1,264 @@
+#pragma once
+#ifndef CPP_ASSERT_ELFSYMBOLTABLE_HPP
+#define	CPP_ASSERT_ELFSYMBOLTABLE_HPP
+#include <cppassert/details/SymbolCache.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) && defined(__ELF__)
+#   define CPP_ASSERT_HAVE_ELF_SYMBOLS 1
+#endif
+
+struct dl_phdr_info;
+
+namespace cppassert
+{
+namespace internal
+{
+
+class ModuleMap;
+
+/**
+ * Read only memory mapping of an ELF file of the same class as the
+ * process, it gives access to sections stored in the file
+ */
+class ElfImage
+{
+    ElfImage(const ElfImage &) = delete;
+    ElfImage &operator=(const ElfImage &) = delete;
+public:
+    /**
+     * Section stored in the file
+     */
+    struct Section
+    {
+        const char *name = nullptr;     ///< Section name
+        std::uint32_t type = 0;         ///< Section type, SHT_*
+        std::uint32_t link = 0;         ///< Index of linked section
+        std::size_t entrySize = 0;      ///< Size of table entry
+        const char *data = nullptr;     ///< Section contents
+        std::size_t size = 0;           ///< Size of contents
+    };
+
+    /**
+     * Creates empty image
+     */
+    ElfImage() = default;
+
+    /**
+     * Maps file at \p path, image is empty if file can't be mapped or
+     * it isn't a valid ELF file
+     * @param   path    Path of file
+     */
+    explicit ElfImage(const char *path);
+
+    ElfImage(ElfImage &&other) noexcept;
+    ElfImage &operator=(ElfImage &&other) noexcept;
+    ~ElfImage();
+
+    /**
+     * Tests whether file was mapped
+     * @return  true if file is mapped and has a valid header
+     */
+    bool isValid() const;
+
+    /**
+     * Returns contents of mapped file
+     * @return  Beginning of mapped file or nullptr
+     */
+    const char *getData() const;
+
+    /**
+     * Returns size of mapped file
+     * @return  Size in bytes
+     */
+    std::size_t getSize() const;
+
+    /**
+     * Returns number of sections
+     * @return  Number of section headers
+     */
+    std::size_t getSectionCount() const;
+
+    /**
+     * Returns section at \p index, compressed sections and sections that
+     * don't have contents in the file are not returned
+     * @param[in]   index       Index of section header
+     * @param[out]  section     Section
+     * @return  false if section is not available
+     */
+    bool getSection(std::size_t index, Section *section) const;
+
+    /**
+     * Returns first section named \p name
+     * @param[in]   name        Section name, i.e. `.debug_line`
+     * @param[out]  section     Section
+     * @return  false if there is no such section
+     */
+    bool findSection(const char *name, Section *section) const;
+
+    /**
+     * Returns GNU build-id stored in `.note.gnu.build-id` section
+     * @return  Hex encoded build-id or empty string if there is none
+     */
+    std::string getBuildId() const;
+private:
+    void unmap();
+
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * Function symbols of one ELF file. Symbols of `.symtab` and `.dynsym`
+ * are stored in an array sorted by address, so that also static functions
+ * and symbols which are not exported are found by binary search. Names
+ * are not copied, they refer to string table of the mapped file. If
+ * symbol cache is enabled the index is stored in SymbolCacheFile of file
+ * build-id and later indexes of the same build are searched in the cache.
+ */
+class ElfSymbolIndex
+{
+    ElfSymbolIndex(const ElfSymbolIndex &) = delete;
+    ElfSymbolIndex &operator=(const ElfSymbolIndex &) = delete;
+public:
+    /**
+     * Creates empty index
+     */
+    ElfSymbolIndex() = default;
+
+    /**
+     * Maps file at \p path and indexes its function symbols, index is
+     * empty if file can't be read
+     * @param   path    Path of executable, shared library or debug file
+     */
+    explicit ElfSymbolIndex(const char *path);
+
+    ElfSymbolIndex(ElfSymbolIndex &&other) = default;
+    ElfSymbolIndex &operator=(ElfSymbolIndex &&other) = default;
+
+    /**
+     * Finds function symbol containing return address
+     *
+     * @param[in]   address     Return address in module file, that is
+     *                          relative to module load address
+     * @param[out]  offset      Offset of \p address from the symbol
+     * @return  Mangled name or nullptr if there is no such symbol
+     */
+    const char *findSymbol(std::uintptr_t address, std::size_t *offset) const;
+
+    /**
+     * Tests whether any symbol was found
+     * @return  true if index has no symbols
+     */
+    bool isEmpty() const;
+
+    /**
+     * Tests whether index was read from symbol cache
+     * @return  true if index is stored in mapped cache file
+     */
+    bool isCached() const;
+private:
+    /*
+     * Symbol address is relative to module load address, name is offset
+     * into names_
+     */
+    struct Entry
+    {
+        std::uintptr_t address;
+        std::uint32_t size;
+        std::uint32_t nameOffset;
+    };
+
+    void loadSymbols();
+    bool loadCache(const std::string &buildId);
+    void writeCache(const std::string &buildId) const;
+
+    ElfImage image_;
+    SymbolCacheFile cache_;
+    CachedArray<Entry> entries_;
+    const char *names_ = nullptr;
+};
+
+/**
+ * Symbol table of executable and shared libraries loaded into the process.
+ * Files of loaded modules, found with `dl_iterate_phdr`, are memory
+ * mapped and indexed with ElfSymbolIndex, so symbols are resolved without
+ * allocation.
+ */
+class ElfSymbolTable
+{
+    ElfSymbolTable(const ElfSymbolTable &) = delete;
+    ElfSymbolTable &operator=(const ElfSymbolTable &) = delete;
+public:
+    /**
+     * Symbol that contains an address
+     */
+    struct Symbol
+    {
+        const char *module = nullptr;   ///< Path of module file
+        const char *name = nullptr;     ///< Mangled name or nullptr
+        std::size_t offset = 0;         ///< Offset from symbol or module
+        std::uintptr_t moduleAddress = 0;   ///< Address in module file
+    };
+
+    /**
+     * Returns symbol table of modules loaded into the process. It's built
+     * on first call and again whenever ModuleMap snapshot changes, that
+     * is after `dlopen` or `dlclose`. Indexes of modules that stay loaded
+     * are shared with the previous table. Tables are never destroyed, so
+     * the returned one stays valid also in destructors of static objects.
+     *
+     * @return  Process symbol table
+     */
+    static const ElfSymbolTable &getInstance();
+
+    /**
+     * Finds function symbol containing return address
+     *
+     * @param[in]   address     Return address of stack frame
+     * @param[out]  symbol      Module and symbol of the address, name is
+     *                          nullptr if module doesn't have symbol
+     *                          for it and offset is relative to module
+     *                          load address then
+     * @return  false if address doesn't belong to any module
+     */
+    bool findSymbol(const void *address, Symbol *symbol) const;
+
+    /**
+     * Returns number of modules which symbols were loaded
+     * @return  Number of modules
+     */
+    std::size_t getModuleCount() const;
+
+    ~ElfSymbolTable();
+private:
+    ElfSymbolTable(std::shared_ptr<const ModuleMap> moduleMap,
+                   const ElfSymbolTable *previous);
+
+    struct Module
+    {
+        std::string path;
+        std::uintptr_t base = 0;
+        std::uintptr_t begin = 0;
+        std::uintptr_t end = 0;
+        std::shared_ptr<const ElfSymbolIndex> symbols;
+    };
+
+    static int addModule(dl_phdr_info *info, std::size_t size, void *table);
+
+    /*
+     * Snapshot the table was built for, it's kept alive so that its
+     * address can't be reused by a later snapshot
+     */
+    std::shared_ptr<const ModuleMap> moduleMap_;
+    std::vector<Module> modules_;
+};
+
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_ELFSYMBOLTABLE_HPP */
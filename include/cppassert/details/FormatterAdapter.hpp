@@ -0,0 +1,422 @@
+#pragma once
+#ifndef CPP_ASSERT_FORMATTERADAPTER_HPP
+#define	CPP_ASSERT_FORMATTERADAPTER_HPP
+#include <cppassert/MessageSink.hpp>
+#include <cppassert/details/AssertionMessage.hpp>
+#include <cstdint>
+#include <string>
+
+namespace cppassert
+{
+class AssertionFailure;
+
+namespace internal
+{
+
+/**
+ * Provides both formatter interfaces, methods appending to MessageSink and
+ * methods returning std::string, over a formatter which implements either
+ * of them. Methods implemented by formatter are called directly, the other
+ * ones are emulated: returned string is appended to the sink or sink
+ * writes to a new string. Formatter implementing only string methods thus
+ * keeps working, at the cost of a string per call.
+ */
+template<typename Formatter>
+class FormatterAdapter
+{
+public:
+    explicit FormatterAdapter(Formatter &formatter)
+        :formatter_(formatter)
+    {
+    }
+
+    void formatAssertionMessage(MessageSink &sink,
+                                const AssertionFailure &assertion)
+    {
+        formatAssertionMessage(formatter_, sink, assertion, Preferred());
+    }
+
+    std::string formatAssertionMessage(const AssertionFailure &assertion)
+    {
+        return formatAssertionMessage(formatter_, assertion, Preferred());
+    }
+
+    void formatBoolFailureMessage(MessageSink &sink,
+                                  const char *expressionText,
+                                  const char *actualPredicateValue,
+                                  const char *expectedPredicateValue)
+    {
+        formatBoolFailureMessage(formatter_, sink, expressionText
+                                 , actualPredicateValue
+                                 , expectedPredicateValue, Preferred());
+    }
+
+    std::string formatBoolFailureMessage(const char *expressionText,
+                                         const char *actualPredicateValue,
+                                         const char *expectedPredicateValue)
+    {
+        return formatBoolFailureMessage(formatter_, expressionText
+                                        , actualPredicateValue
+                                        , expectedPredicateValue
+                                        , Preferred());
+    }
+
+    void formatPredicateFailureMessage(MessageSink &sink,
+                                       const char *predicate,
+                                       const char *value1Text,
+                                       const char *value2Text,
+                                       const AssertionMessage &value1,
+                                       const AssertionMessage &value2)
+    {
+        formatPredicateFailureMessage(formatter_, sink, predicate
+                                      , value1Text, value2Text
+                                      , value1, value2, Preferred());
+    }
+
+    std::string formatPredicateFailureMessage(const char *predicate,
+                                              const char *value1Text,
+                                              const char *value2Text,
+                                              const std::string &value1,
+                                              const std::string &value2)
+    {
+        return formatPredicateFailureMessage(formatter_, predicate
+                                             , value1Text, value2Text
+                                             , value1, value2, Preferred());
+    }
+
+    void formatStatementFailureMessage(MessageSink &sink,
+                                       const char *statement)
+    {
+        formatStatementFailureMessage(formatter_, sink, statement
+                                      , Preferred());
+    }
+
+    std::string formatStatementFailureMessage(const char *statement)
+    {
+        return formatStatementFailureMessage(formatter_, statement
+                                             , Preferred());
+    }
+
+    void formatStreamedMessage(MessageSink &sink,
+                               const AssertionMessage &message)
+    {
+        formatStreamedMessage(formatter_, sink, message, Preferred());
+    }
+
+    std::string formatStreamedMessage(const std::string &message)
+    {
+        return formatStreamedMessage(formatter_, message, Preferred());
+    }
+
+    void formatFrame(MessageSink &sink, std::uint32_t frameNumber,
+                     const void *address, const char *symbol)
+    {
+        formatFrame(formatter_, sink, frameNumber, address, symbol
+                    , Preferred());
+    }
+
+    std::string formatFrame(std::uint32_t frameNumber, const void *address,
+                            const char *symbol)
+    {
+        return formatFrame(formatter_, frameNumber, address, symbol
+                           , Preferred());
+    }
+private:
+    /*
+     * Overloads taking Preferred are selected when formatter implements
+     * the method, Fallback ones emulate it
+     */
+    struct Fallback {};
+    struct Preferred: Fallback {};
+
+    template<typename F>
+    static auto formatAssertionMessage(F &formatter, MessageSink &sink,
+                                       const AssertionFailure &assertion,
+                                       Preferred)
+        -> decltype(formatter.formatAssertionMessage(sink, assertion), void())
+    {
+        formatter.formatAssertionMessage(sink, assertion);
+    }
+
+    template<typename F>
+    static void formatAssertionMessage(F &formatter, MessageSink &sink,
+                                       const AssertionFailure &assertion,
+                                       Fallback)
+    {
+        sink<<formatter.formatAssertionMessage(assertion);
+    }
+
+    template<typename F>
+    static auto formatAssertionMessage(F &formatter,
+                                       const AssertionFailure &assertion,
+                                       Preferred)
+        -> decltype(std::string(formatter.formatAssertionMessage(assertion)))
+    {
+        return formatter.formatAssertionMessage(assertion);
+    }
+
+    template<typename F>
+    static std::string formatAssertionMessage(F &formatter,
+                                              const AssertionFailure &assertion,
+                                              Fallback)
+    {
+        std::string text;
+        MessageSink sink(text);
+        formatter.formatAssertionMessage(sink, assertion);
+        return text;
+    }
+
+    template<typename F>
+    static auto formatBoolFailureMessage(F &formatter, MessageSink &sink,
+                                         const char *expressionText,
+                                         const char *actualPredicateValue,
+                                         const char *expectedPredicateValue,
+                                         Preferred)
+        -> decltype(formatter.formatBoolFailureMessage(sink, expressionText
+                                                , actualPredicateValue
+                                                , expectedPredicateValue)
+                    , void())
+    {
+        formatter.formatBoolFailureMessage(sink, expressionText
+                                           , actualPredicateValue
+                                           , expectedPredicateValue);
+    }
+
+    template<typename F>
+    static void formatBoolFailureMessage(F &formatter, MessageSink &sink,
+                                         const char *expressionText,
+                                         const char *actualPredicateValue,
+                                         const char *expectedPredicateValue,
+                                         Fallback)
+    {
+        sink<<formatter.formatBoolFailureMessage(expressionText
+                                                 , actualPredicateValue
+                                                 , expectedPredicateValue);
+    }
+
+    template<typename F>
+    static auto formatBoolFailureMessage(F &formatter,
+                                         const char *expressionText,
+                                         const char *actualPredicateValue,
+                                         const char *expectedPredicateValue,
+                                         Preferred)
+        -> decltype(std::string(formatter.formatBoolFailureMessage(
+                                                expressionText
+                                                , actualPredicateValue
+                                                , expectedPredicateValue)))
+    {
+        return formatter.formatBoolFailureMessage(expressionText
+                                                  , actualPredicateValue
+                                                  , expectedPredicateValue);
+    }
+
+    template<typename F>
+    static std::string formatBoolFailureMessage(F &formatter,
+                                                const char *expressionText,
+                                                const char *actualPredicateValue,
+                                                const char *expectedPredicateValue,
+                                                Fallback)
+    {
+        std::string text;
+        MessageSink sink(text);
+        formatter.formatBoolFailureMessage(sink, expressionText
+                                           , actualPredicateValue
+                                           , expectedPredicateValue);
+        return text;
+    }
+
+    template<typename F>
+    static auto formatPredicateFailureMessage(F &formatter, MessageSink &sink,
+                                              const char *predicate,
+                                              const char *value1Text,
+                                              const char *value2Text,
+                                              const AssertionMessage &value1,
+                                              const AssertionMessage &value2,
+                                              Preferred)
+        -> decltype(formatter.formatPredicateFailureMessage(sink, predicate
+                                                    , value1Text, value2Text
+                                                    , value1, value2)
+                    , void())
+    {
+        formatter.formatPredicateFailureMessage(sink, predicate, value1Text
+                                                , value2Text, value1, value2);
+    }
+
+    template<typename F>
+    static void formatPredicateFailureMessage(F &formatter, MessageSink &sink,
+                                              const char *predicate,
+                                              const char *value1Text,
+                                              const char *value2Text,
+                                              const AssertionMessage &value1,
+                                              const AssertionMessage &value2,
+                                              Fallback)
+    {
+        sink<<formatter.formatPredicateFailureMessage(predicate, value1Text
+                                                      , value2Text
+                                                      , value1.str()
+                                                      , value2.str());
+    }
+
+    template<typename F>
+    static auto formatPredicateFailureMessage(F &formatter,
+                                              const char *predicate,
+                                              const char *value1Text,
+                                              const char *value2Text,
+                                              const std::string &value1,
+                                              const std::string &value2,
+                                              Preferred)
+        -> decltype(std::string(formatter.formatPredicateFailureMessage(
+                                                    predicate
+                                                    , value1Text, value2Text
+                                                    , value1, value2)))
+    {
+        return formatter.formatPredicateFailureMessage(predicate, value1Text
+                                                       , value2Text, value1
+                                                       , value2);
+    }
+
+    template<typename F>
+    static std::string formatPredicateFailureMessage(F &formatter,
+                                                     const char *predicate,
+                                                     const char *value1Text,
+                                                     const char *value2Text,
+                                                     const std::string &value1,
+                                                     const std::string &value2,
+                                                     Fallback)
+    {
+        AssertionMessage value1Message;
+        AssertionMessage value2Message;
+        value1Message<<value1;
+        value2Message<<value2;
+        std::string text;
+        MessageSink sink(text);
+        formatter.formatPredicateFailureMessage(sink, predicate, value1Text
+                                                , value2Text, value1Message
+                                                , value2Message);
+        return text;
+    }
+
+    template<typename F>
+    static auto formatStatementFailureMessage(F &formatter, MessageSink &sink,
+                                              const char *statement,
+                                              Preferred)
+        -> decltype(formatter.formatStatementFailureMessage(sink, statement)
+                    , void())
+    {
+        formatter.formatStatementFailureMessage(sink, statement);
+    }
+
+    template<typename F>
+    static void formatStatementFailureMessage(F &formatter, MessageSink &sink,
+                                              const char *statement,
+                                              Fallback)
+    {
+        sink<<formatter.formatStatementFailureMessage(statement);
+    }
+
+    template<typename F>
+    static auto formatStatementFailureMessage(F &formatter,
+                                              const char *statement,
+                                              Preferred)
+        -> decltype(std::string(formatter.formatStatementFailureMessage(
+                                                                statement)))
+    {
+        return formatter.formatStatementFailureMessage(statement);
+    }
+
+    template<typename F>
+    static std::string formatStatementFailureMessage(F &formatter,
+                                                     const char *statement,
+                                                     Fallback)
+    {
+        std::string text;
+        MessageSink sink(text);
+        formatter.formatStatementFailureMessage(sink, statement);
+        return text;
+    }
+
+    template<typename F>
+    static auto formatStreamedMessage(F &formatter, MessageSink &sink,
+                                      const AssertionMessage &message,
+                                      Preferred)
+        -> decltype(formatter.formatStreamedMessage(sink, message), void())
+    {
+        formatter.formatStreamedMessage(sink, message);
+    }
+
+    template<typename F>
+    static void formatStreamedMessage(F &formatter, MessageSink &sink,
+                                      const AssertionMessage &message,
+                                      Fallback)
+    {
+        sink<<formatter.formatStreamedMessage(message.str());
+    }
+
+    template<typename F>
+    static auto formatStreamedMessage(F &formatter,
+                                      const std::string &message,
+                                      Preferred)
+        -> decltype(std::string(formatter.formatStreamedMessage(message)))
+    {
+        return formatter.formatStreamedMessage(message);
+    }
+
+    template<typename F>
+    static std::string formatStreamedMessage(F &formatter,
+                                             const std::string &message,
+                                             Fallback)
+    {
+        AssertionMessage streamed;
+        streamed<<message;
+        std::string text;
+        MessageSink sink(text);
+        formatter.formatStreamedMessage(sink, streamed);
+        return text;
+    }
+
+    template<typename F>
+    static auto formatFrame(F &formatter, MessageSink &sink,
+                            std::uint32_t frameNumber, const void *address,
+                            const char *symbol, Preferred)
+        -> decltype(formatter.formatFrame(sink, frameNumber, address, symbol)
+                    , void())
+    {
+        formatter.formatFrame(sink, frameNumber, address, symbol);
+    }
+
+    template<typename F>
+    static void formatFrame(F &formatter, MessageSink &sink,
+                            std::uint32_t frameNumber, const void *address,
+                            const char *symbol, Fallback)
+    {
+        sink<<formatter.formatFrame(frameNumber, address, symbol);
+    }
+
+    template<typename F>
+    static auto formatFrame(F &formatter, std::uint32_t frameNumber,
+                            const void *address, const char *symbol,
+                            Preferred)
+        -> decltype(std::string(formatter.formatFrame(frameNumber, address
+                                                      , symbol)))
+    {
+        return formatter.formatFrame(frameNumber, address, symbol);
+    }
+
+    template<typename F>
+    static std::string formatFrame(F &formatter, std::uint32_t frameNumber,
+                                   const void *address, const char *symbol,
+                                   Fallback)
+    {
+        std::string text;
+        MessageSink sink(text);
+        formatter.formatFrame(sink, frameNumber, address, symbol);
+        return text;
+    }
+
+    Formatter &formatter_;
+};
+
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_FORMATTERADAPTER_HPP */
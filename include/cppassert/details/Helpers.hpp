@@ -2,6 +2,11 @@
 #ifndef CPP_ASSERT_HELPERS_HPP
 #define	CPP_ASSERT_HELPERS_HPP
 #include "AssertionMessage.hpp"
+#include "TypeTraits.hpp"
+#include "../AssertionSite.hpp"
+#include "../ValuePrinter.hpp"
+#include "Atomic.hpp"
+#include <cstdint>
 
 #define CPP_ASSERT_CONCAT(FIRST_TOKEN, SECOND_TOKEN) \
  CPP_ASSERT_CONCAT_IMPL(FIRST_TOKEN, SECOND_TOKEN)
@@ -26,45 +31,382 @@
 #define CPP_ASSERT_CALL_OVERLOAD(name, ...) \
 	CPP_ASSERT_GLUE(CPP_ASSERT_OVERLOAD_MACRO(name, CPP_ASSERT_COUNT_ARGS(__VA_ARGS__)), (__VA_ARGS__))
 
+/*
+ * Failure path of every CPP_ASSERT_* macro is moved out of line to
+ * functions marked as cold, compiler places them in .text.unlikely and
+ * assertion site is reduced to a compare and a (predicted not taken) jump.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#   define CPP_ASSERT_COLD [[gnu::cold, gnu::noinline]]
+#   define CPP_ASSERT_COLD_LAMBDA __attribute__((cold, noinline))
+#   define CPP_ASSERT_LIKELY(condition) __builtin_expect(!!(condition), 1)
+#   define CPP_ASSERT_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#elif defined(_MSC_VER)
+#   define CPP_ASSERT_COLD __declspec(noinline)
+#   define CPP_ASSERT_COLD_LAMBDA
+#   define CPP_ASSERT_LIKELY(condition) (condition)
+#   define CPP_ASSERT_UNLIKELY(condition) (condition)
+#else
+#   define CPP_ASSERT_COLD
+#   define CPP_ASSERT_COLD_LAMBDA
+#   define CPP_ASSERT_LIKELY(condition) (condition)
+#   define CPP_ASSERT_UNLIKELY(condition) (condition)
+#endif
+
+/*
+ * Out of line failure path defined in headers, onPredicateAssertionFailure()
+ * instantiations, joins library code in `cppassert_text` section where
+ * compiler honours section of functions in comdat groups. Clang does, GCC
+ * ignores it, frames of the instantiations are skipped by count then, see
+ * source/details/Helpers.cpp.
+ */
+#if defined(__clang__) && defined(__ELF__)
+#   define CPP_ASSERT_HAVE_HEADER_LIBRARY_SECTION 1
+#   define CPP_ASSERT_HEADER_LIBRARY_CODE \
+    __attribute__((section("cppassert_text")))
+#else
+#   define CPP_ASSERT_HEADER_LIBRARY_CODE
+#endif
+
+/*
+ * Every assertion site is described by a static AssertionSite record,
+ * hot path refers to it only on failure. Where toolchain allows it, pointer
+ * to the record is stored in `cppassert_sites` section so that library can
+ * enumerate all the sites linked into executable. Records can't be placed
+ * in the section directly because GCC refuses to mix section attribute of
+ * statics from inline (comdat) and non inline functions in a single
+ * translation unit. Pointers are emitted by assembler instead, which
+ * requires symbol address to be a link time constant so it is not
+ * available in position independent code of shared libraries.
+ * Registration emits no instructions, it is placed before the condition
+ * because GCC doesn't move a branch containing asm statement to cold
+ * section.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__ELF__) \
+    && (!defined(__PIC__) || defined(__PIE__))
+#   define CPP_ASSERT_HAVE_SITE_SECTION 1
+#   if defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ == 8
+#       define CPP_ASSERT_SITE_POINTER_DIRECTIVE ".quad"
+#   else
+#       define CPP_ASSERT_SITE_POINTER_DIRECTIVE ".long"
+#   endif
+#   define CPP_ASSERT_REGISTER_SITE(site) \
+    __asm__ __volatile__(".pushsection cppassert_sites,\"aw\"\n\t" \
+                         ".balign %c1\n\t" \
+                         CPP_ASSERT_SITE_POINTER_DIRECTIVE " %c0\n\t" \
+                         ".popsection" \
+                         : : "i"(&site), "i"(sizeof(void *)))
+#else
+#   define CPP_ASSERT_REGISTER_SITE(site) CPP_ASSERT_MARK_UNUSED(site)
+#endif
+
+#define CPP_ASSERT_SITE_KIND_true   True
+#define CPP_ASSERT_SITE_KIND_false  False
+
+/*
+ * Comparison of EQ/NE/LT/LE/GT/GE assertions, arguments are bound once at
+ * assertion site and the same values are reported on failure. Other types
+ * than scalars are bound to forwarding references. Scalars are bound and
+ * passed to failure path by value, because GCC doesn't sink the store of
+ * a local which address is taken to the cold branch. Failure function
+ * with explicit template arguments is parenthesized so that expansion
+ * can be passed to other macros.
+ */
+#define CPP_ASSERT_BIND_ARGUMENT(name, failureType, value) \
+    ::cppassert::internal::PredicateArgument<decltype((value))>::type \
+        name = value; \
+    typedef ::cppassert::internal::PredicateArgument< \
+        decltype((value))>::FailureType failureType
+
+#define CPP_ASSERT_COMPARE(predicate, value1, value2) \
+    ::cppassert::internal::Comparator< \
+        ::cppassert::AssertionKind::predicate>::compare(value1, value2)
+
+/*
+ * Site record can't be const because it holds runtime state of the site,
+ * it's constant initialized though so there is no guard variable.
+ */
+#define CPP_ASSERT_SITE(level, kind, expression, secondExpression) \
+    static ::cppassert::AssertionSite cppAssertSite_( \
+                                    __FILE__, \
+                                    __LINE__, \
+                                    CPP_ASSERT_FUNCTION_NAME, \
+                                    expression, \
+                                    secondExpression, \
+                                    ::cppassert::AssertionKind::kind, \
+                                    ::cppassert::AssertionLevel::level)
+
+/*
+ * Opt-in static keys mode, modeled on Linux kernel static keys. Runtime
+ * site state isn't loaded at all, instead every site starts with a 5 byte
+ * jump to the check which is patched to a 5 byte NOP when site is
+ * disabled, see source/details/StaticKeys.cpp. Patch table entry
+ * (instruction address, jump target, site) is emitted into
+ * `cppassert_static_keys` section, in the section group of the function
+ * so that entries of discarded inline function copies are dropped by the
+ * linker. Sites may run while they are patched, so instruction is
+ * rewritten under a breakpoint the way Linux text_poke_bp does it.
+ */
+#if defined(CPP_ASSERT_STATIC_KEYS) && defined(CPP_ASSERT_HAVE_SITE_SECTION) \
+    && defined(__x86_64__) && defined(__linux__)
+#   define CPP_ASSERT_HAVE_STATIC_KEYS 1
+#   define CPP_ASSERT_STATIC_KEY_LABEL __label__ cppAssertCheck_;
+#   define CPP_ASSERT_STATIC_KEY(site) \
+    __asm__ goto(".pushsection cppassert_static_keys,\"aw?\"\n\t" \
+                 ".balign 8\n\t" \
+                 ".quad 1f, %l[cppAssertCheck_], %c0\n\t" \
+                 ".popsection\n" \
+                 "1:\n\t" \
+                 ".byte 0xe9\n\t" \
+                 ".long %l[cppAssertCheck_] - 2f\n" \
+                 "2:" \
+                 : : "i"(&site) : : cppAssertCheck_); \
+    break; \
+    cppAssertCheck_:
+#else
+#   define CPP_ASSERT_STATIC_KEY_LABEL
+#   define CPP_ASSERT_STATIC_KEY(site)
+#endif
+
+/*
+ * Runtime site state is checked with single relaxed load before predicate
+ * is evaluated. Defining CPP_ASSERT_DISABLE_SITE_STATE removes the check,
+ * sites can't be disabled at runtime then. In static keys mode the check
+ * is replaced by the patched jump above.
+ */
+#if defined(CPP_ASSERT_DISABLE_SITE_STATE) || defined(CPP_ASSERT_HAVE_STATIC_KEYS)
+#   define CPP_ASSERT_SITE_DISABLED(site) false
+#else
+#   define CPP_ASSERT_SITE_DISABLED(site) \
+    CPP_ASSERT_UNLIKELY(!(site).isEnabled())
+#endif
+
+/*
+ * Sites of CPP_ASSERT_{CHEAP|AUDIT} and CPP_ASSERT_* macros also check
+ * runtime level threshold with a relaxed load, CPP_ASSERT_ALWAYS_* sites
+ * don't. Defining CPP_ASSERT_DISABLE_SITE_STATE removes this check too,
+ * only compile time threshold CPP_ASSERT_LEVEL applies then.
+ */
+#define CPP_ASSERT_LEVEL_DISABLED_Always false
+#ifdef CPP_ASSERT_DISABLE_SITE_STATE
+#   define CPP_ASSERT_LEVEL_DISABLED_Cheap false
+#   define CPP_ASSERT_LEVEL_DISABLED_Debug false
+#   define CPP_ASSERT_LEVEL_DISABLED_Audit false
+#else
+#   define CPP_ASSERT_LEVEL_DISABLED_Cheap \
+    CPP_ASSERT_UNLIKELY(::cppassert::internal::isLevelDisabled( \
+                                    ::cppassert::AssertionLevel::Cheap))
+#   define CPP_ASSERT_LEVEL_DISABLED_Debug \
+    CPP_ASSERT_UNLIKELY(::cppassert::internal::isLevelDisabled( \
+                                    ::cppassert::AssertionLevel::Debug))
+#   define CPP_ASSERT_LEVEL_DISABLED_Audit \
+    CPP_ASSERT_UNLIKELY(::cppassert::internal::isLevelDisabled( \
+                                    ::cppassert::AssertionLevel::Audit))
+#endif
+#define CPP_ASSERT_LEVEL_DISABLED(level) CPP_ASSERT_LEVEL_DISABLED_##level
+
+/*
+ * Site is skipped when it's disabled or its level is above runtime
+ * threshold
+ */
+#define CPP_ASSERT_SKIPPED(level, site) \
+    (CPP_ASSERT_SITE_DISABLED(site) || CPP_ASSERT_LEVEL_DISABLED(level))
+
+/*
+ * Common beginning of every assertion site, it has to be the first thing
+ * in the block because of local label of static keys mode.
+ */
+#define CPP_ASSERT_SITE_PROLOGUE(level, kind, expression, secondExpression) \
+    CPP_ASSERT_STATIC_KEY_LABEL \
+    CPP_ASSERT_SITE(level, kind, expression, secondExpression); \
+    CPP_ASSERT_REGISTER_SITE(cppAssertSite_); \
+    CPP_ASSERT_STATIC_KEY(cppAssertSite_)
+
+/*
+ * Streamed message may refer to any variable visible at assertion site,
+ * so it has to be built there. It is wrapped in a cold lambda to keep
+ * streaming code out of the hot path as well.
+ */
+#define CPP_ASSERT_COLD_CALL(function, ...) \
+    [&]() CPP_ASSERT_COLD_LAMBDA \
+    { \
+        function(&cppAssertSite_, __VA_ARGS__); \
+    }()
+
 namespace cppassert
 {
 namespace internal
 {
 /**
- * Returns a message for a bool assertion failures i.e. ASSERT_{TRUE|FALSE}
+ * Type of variable that holds evaluated argument of EQ/NE/LT/LE/GT/GE
+ * assertion, copy for scalars and forwarding reference for other types
+ */
+template<typename T>
+struct PredicateArgument
+{
+    using DecayedType = typename Decay<T>::type;
+    using type = typename Conditional<
+                            IsScalar<DecayedType>::value,
+                            const DecayedType,
+                            T &&>::type;
+    using FailureType = typename Conditional<
+                            IsScalar<DecayedType>::value,
+                            DecayedType,
+                            const typename RemoveReference<T>::type &
+                            >::type;
+};
+
+/**
+ * Compares arguments of EQ/NE/LT/LE/GT/GE assertions with operator
+ * corresponding to kind of assertion
+ */
+template<AssertionKind kind>
+struct Comparator;
+
+#define CPP_ASSERT_DEFINE_COMPARATOR(kind, operator_) \
+template<> \
+struct Comparator<AssertionKind::kind> \
+{ \
+    template<typename T1, typename T2> \
+    static bool compare(T1 &&value1, T2 &&value2) \
+    { \
+        return (value1 operator_ value2); \
+    } \
+}
+
+CPP_ASSERT_DEFINE_COMPARATOR(Eq, ==);
+CPP_ASSERT_DEFINE_COMPARATOR(Ne, !=);
+CPP_ASSERT_DEFINE_COMPARATOR(Lt, <);
+CPP_ASSERT_DEFINE_COMPARATOR(Le, <=);
+CPP_ASSERT_DEFINE_COMPARATOR(Gt, >);
+CPP_ASSERT_DEFINE_COMPARATOR(Ge, >=);
+
+#undef CPP_ASSERT_DEFINE_COMPARATOR
+
+/**
+ * Runtime level threshold, sites which level is above it are not
+ * evaluated. Holds AssertionLevel value.
+ */
+extern std::uint8_t assertionLevelThreshold;
+
+/**
+ * Returns true if sites of given level are above runtime threshold
+ *
+ * @param   level   Level of assertion site
+ * @return  true if sites of given level should not be evaluated
+ */
+inline bool isLevelDisabled(AssertionLevel level)
+{
+    return (static_cast<std::uint8_t>(level)
+            >loadRelaxed(assertionLevelThreshold));
+}
+
+/**
+ * Out of line failure path of `CPP_ASSERT[_ALWAYS]` macros
+ *
+ * @param   site        Assertion site that failed
+ */
+CPP_ASSERT_COLD void onAssertionFailure(const AssertionSite *site);
+
+/**
+ * Out of line failure path of `CPP_ASSERT[_ALWAYS]` macros
+ * with a streamed message
+ *
+ * @param   site        Assertion site that failed
+ * @param   message     Message streamed by library client
+ */
+CPP_ASSERT_COLD void onAssertionFailure(const AssertionSite *site,
+    const AssertionMessage &message);
+
+/**
+ * Out of line failure path of `CPP_ASSERT[_ALWAYS]_{TRUE|FALSE}` macros
+ *
+ * @param   site        Assertion site that failed
+ */
+CPP_ASSERT_COLD void onBoolAssertionFailure(const AssertionSite *site);
+
+/**
+ * Out of line failure path of `CPP_ASSERT[_ALWAYS]_{TRUE|FALSE}` macros
+ * with a streamed message
  *
- * @param expressionText
- * @param actualPredicateValue
- * @param expectedPredicateValue
- * @return
+ * @param   site        Assertion site that failed
+ * @param   message     Message streamed by library client
  */
-std::string getBoolAssertionFailureMessage(
-    const char* expressionText,
-    const char* actualPredicateValue,
-    const char* expectedPredicateValue);
+CPP_ASSERT_COLD void onBoolAssertionFailure(const AssertionSite *site,
+    const AssertionMessage &message);
+
 /**
- * Returns a message for a predicate assertion failures
+ * Reports failure of `CPP_ASSERT[_ALWAYS]_{EQ|NE|LE|LT|GE|GT}` macros
+ * which arguments were already streamed
  *
- * @param   predicate       Predicate text i.e. (value1 predicate value2)
- * @param   value1AsText    value1 as text i.e. variable name etc
- * @param   value2AsText    value2 as text i.e.
- * @param   value1          value1 evaluated to string using operator<<
- * @param   value2          value1 evaluated to string using operator<<
- * @return  String that should be displayed to user
+ * @param   site        Assertion site that failed
+ * @param   value1      First argument of predicate as text
+ * @param   value2      Second argument of predicate as text
  */
-std::string getPredicateAssertionFailureMessage(
-    const char* predicate,
-    const char* value1AsText,
-    const char* value2AsText,
-    AssertionMessage &&value1,
-    AssertionMessage &&value2);
+CPP_ASSERT_COLD void reportPredicateAssertionFailure(const AssertionSite *site,
+    const AssertionMessage &value1,
+    const AssertionMessage &value2);
 
 /**
- * Returns a message tor `CPP_ASSERT[_ALWAYS]` failures
- * @param   statement   Statement that failed
- * @return  String that should contain user readable message that statement failed
+ * Reports failure of `CPP_ASSERT[_ALWAYS]_{EQ|NE|LE|LT|GE|GT}` macros
+ * with a streamed message which arguments were already streamed
+ *
+ * @param   site        Assertion site that failed
+ * @param   value1      First argument of predicate as text
+ * @param   value2      Second argument of predicate as text
+ * @param   message     Message streamed by library client
  */
-std::string getAssertionFailureMessage(const char *statement);
+CPP_ASSERT_COLD void reportPredicateAssertionFailure(const AssertionSite *site,
+    const AssertionMessage &value1,
+    const AssertionMessage &value2,
+    const AssertionMessage &message);
+
+/**
+ * Out of line failure path of `CPP_ASSERT[_ALWAYS]_{EQ|NE|LE|LT|GE|GT}`
+ * macros. It is instantiated once per pair of argument types, not once per
+ * assertion site, and only prints arguments with ValuePrinter, failure is
+ * reported by the library. Scalar arguments are passed by value, other by const
+ * reference, see PredicateArgument.
+ *
+ * @param   site        Assertion site that failed
+ * @param   value1      First argument of predicate
+ * @param   value2      Second argument of predicate
+ */
+template<typename T1, typename T2>
+CPP_ASSERT_COLD CPP_ASSERT_HEADER_LIBRARY_CODE
+void onPredicateAssertionFailure(const AssertionSite *site,
+    T1 value1,
+    T2 value2)
+{
+    AssertionMessage value1Text;
+    AssertionMessage value2Text;
+    printValue<T1>(value1Text, value1);
+    printValue<T2>(value2Text, value2);
+    reportPredicateAssertionFailure(site, value1Text, value2Text);
+}
+
+/**
+ * Out of line failure path of `CPP_ASSERT[_ALWAYS]_{EQ|NE|LE|LT|GE|GT}`
+ * macros with a streamed message.
+ *
+ * @param   site        Assertion site that failed
+ * @param   value1      First argument of predicate
+ * @param   value2      Second argument of predicate
+ * @param   message     Message streamed by library client
+ */
+template<typename T1, typename T2>
+CPP_ASSERT_COLD CPP_ASSERT_HEADER_LIBRARY_CODE
+void onPredicateAssertionFailure(const AssertionSite *site,
+    T1 value1,
+    T2 value2,
+    const AssertionMessage &message)
+{
+    AssertionMessage value1Text;
+    AssertionMessage value2Text;
+    printValue<T1>(value1Text, value1);
+    printValue<T2>(value2Text, value2);
+    reportPredicateAssertionFailure(site, value1Text, value2Text, message);
+}
 } //internal
 } //asrt
 
@@ -88,120 +430,159 @@ std::string getAssertionFailureMessage(const char *statement);
 #define CPP_ASSERT_VOID_CAST static_cast<void>
 #define CPP_ASSERT_MARK_UNUSED(variable) static_cast<void>(variable)
 
-#ifndef NDEBUG
+/*
+ * Compile time level threshold, sites of levels above it generate no code.
+ * By default it's CPP_ASSERT_LEVEL_DEBUG, or CPP_ASSERT_LEVEL_ALWAYS when
+ * NDEBUG is defined.
+ */
+#define CPP_ASSERT_LEVEL_ALWAYS 0
+#define CPP_ASSERT_LEVEL_CHEAP  1
+#define CPP_ASSERT_LEVEL_DEBUG  2
+#define CPP_ASSERT_LEVEL_AUDIT  3
+
+#ifndef CPP_ASSERT_LEVEL
+# ifdef NDEBUG
+#  define CPP_ASSERT_LEVEL CPP_ASSERT_LEVEL_ALWAYS
+# else
+#  define CPP_ASSERT_LEVEL CPP_ASSERT_LEVEL_DEBUG
+# endif
+#endif
+
+#if CPP_ASSERT_LEVEL >= CPP_ASSERT_LEVEL_CHEAP
+# define CPP_ASSERT_CHEAP_ENABLED 1
+#endif
+
+#if CPP_ASSERT_LEVEL >= CPP_ASSERT_LEVEL_DEBUG
 # define CPP_ASSERT_ENABLED 1
 #endif
 
+#if CPP_ASSERT_LEVEL >= CPP_ASSERT_LEVEL_AUDIT
+# define CPP_ASSERT_AUDIT_ENABLED 1
+#endif
+
 
 #ifndef CPP_ASSERT_DISABLE_ALL
 
-# define CPP_ASSERT_BOOL_IMPL_0_(expression, text, actual, expected) \
+# define CPP_ASSERT_BOOL_IMPL_0_(level, expression, text, actual, expected) \
     do \
     { \
-        if((expression)==expected) \
+        CPP_ASSERT_SITE_PROLOGUE(level, \
+                        CPP_ASSERT_CONCAT(CPP_ASSERT_SITE_KIND_, expected), \
+                        text, nullptr) \
+        if(CPP_ASSERT_SKIPPED(level, cppAssertSite_) \
+           || CPP_ASSERT_LIKELY((expression)==expected))  \
         { \
             ; \
         }\
         else \
         { \
-            ::cppassert::AssertionFailure(__LINE__, __FILE__, \
-                                    CPP_ASSERT_FUNCTION_NAME, \
-                ::cppassert::internal::getBoolAssertionFailureMessage(text, \
-                                            CPP_ASSERT_STRING(actual), \
-                                            CPP_ASSERT_STRING(expected))).onAssertionFailure(::cppassert::AssertionMessage()); \
+            ::cppassert::internal::onBoolAssertionFailure(&cppAssertSite_); \
         } \
     } CPP_ASSERT_WHILE_FALSE
 
-# define CPP_ASSERT_BOOL_IMPL_1_(expression, text, actual, expected, message) \
+# define CPP_ASSERT_BOOL_IMPL_1_(level, expression, text, actual, expected, message) \
     do \
     {   \
-        if((expression)==expected) \
+        CPP_ASSERT_SITE_PROLOGUE(level, \
+                        CPP_ASSERT_CONCAT(CPP_ASSERT_SITE_KIND_, expected), \
+                        text, nullptr) \
+        if(CPP_ASSERT_SKIPPED(level, cppAssertSite_) \
+           || CPP_ASSERT_LIKELY((expression)==expected))  \
         { \
             ; \
         } \
         else \
         { \
-            ::cppassert::AssertionFailure(__LINE__, __FILE__, \
-                                    CPP_ASSERT_FUNCTION_NAME, \
-                ::cppassert::internal::getBoolAssertionFailureMessage(text, \
-                                            CPP_ASSERT_STRING(actual), \
-                                            CPP_ASSERT_STRING(expected))).onAssertionFailure(::cppassert::AssertionMessage()<<message); \
+            CPP_ASSERT_COLD_CALL(::cppassert::internal::onBoolAssertionFailure, \
+                                    ::cppassert::AssertionMessage()<<message); \
         } \
     } CPP_ASSERT_WHILE_FALSE
 
-# define CPP_ASSERT_IMPL_0_(statement) \
+# define CPP_ASSERT_IMPL_0_(level, statement) \
     do \
     {   \
-        if(statement) \
+        CPP_ASSERT_SITE_PROLOGUE(level, Statement, CPP_ASSERT_STRING(statement), nullptr) \
+        if(CPP_ASSERT_SKIPPED(level, cppAssertSite_) \
+           || CPP_ASSERT_LIKELY(statement)) \
         {   \
             ; \
         } \
         else \
         { \
-            ::cppassert::AssertionFailure(__LINE__, __FILE__, \
-                                    CPP_ASSERT_FUNCTION_NAME, \
-                ::cppassert::internal::getAssertionFailureMessage( \
-                                        CPP_ASSERT_STRING(statement) \
-                                        ) ).onAssertionFailure(::cppassert::AssertionMessage()); \
+            ::cppassert::internal::onAssertionFailure(&cppAssertSite_); \
         } \
     } CPP_ASSERT_WHILE_FALSE
 
-# define CPP_ASSERT_IMPL_1_(statement, message) \
+# define CPP_ASSERT_IMPL_1_(level, statement, message) \
     do                  \
     {                   \
-        if(statement)   \
+        CPP_ASSERT_SITE_PROLOGUE(level, Statement, CPP_ASSERT_STRING(statement), nullptr) \
+        if(CPP_ASSERT_SKIPPED(level, cppAssertSite_) \
+           || CPP_ASSERT_LIKELY(statement))   \
         {               \
             ;           \
         }               \
         else            \
         {               \
-            ::cppassert::AssertionFailure(__LINE__, __FILE__, \
-                                    CPP_ASSERT_FUNCTION_NAME, \
-                ::cppassert::internal::getAssertionFailureMessage( \
-                                        CPP_ASSERT_STRING(statement) \
-                                        ) ).onAssertionFailure(::cppassert::AssertionMessage()<<message); \
+            CPP_ASSERT_COLD_CALL(::cppassert::internal::onAssertionFailure, \
+                                    ::cppassert::AssertionMessage()<<message); \
         } \
     } CPP_ASSERT_WHILE_FALSE
 
 
-# define CPP_ASSERT_PRED_IMPL_0_(val1, val2, val1Text, val2Text, predicate) \
+# define CPP_ASSERT_PRED_IMPL_0_(level, val1, val2, val1Text, val2Text, predicate) \
     do \
     {   \
-        if((val1) predicate (val2)) \
+        CPP_ASSERT_SITE_PROLOGUE(level, predicate, val1Text, val2Text) \
+        if(CPP_ASSERT_SKIPPED(level, cppAssertSite_)) \
+        {   \
+            break; \
+        } \
+        CPP_ASSERT_BIND_ARGUMENT(cppAssertValue1_, CppAssertType1_, val1); \
+        CPP_ASSERT_BIND_ARGUMENT(cppAssertValue2_, CppAssertType2_, val2); \
+        if(CPP_ASSERT_LIKELY(CPP_ASSERT_COMPARE(predicate, \
+                                    cppAssertValue1_, cppAssertValue2_))) \
         {   \
             ; \
         }\
         else \
-        {    ::cppassert::AssertionFailure(__LINE__, __FILE__, \
-                                    CPP_ASSERT_FUNCTION_NAME, \
-                ::cppassert::internal::getPredicateAssertionFailureMessage( \
-                                        CPP_ASSERT_STRING(predicate), \
-                                        val1Text, \
-                                        val2Text, \
-                                        std::move(::cppassert::AssertionMessage()<<val1), \
-                                        std::move(::cppassert::AssertionMessage()<<val2))).onAssertionFailure(::cppassert::AssertionMessage()); \
+        { \
+            (::cppassert::internal::onPredicateAssertionFailure< \
+                                    CppAssertType1_, CppAssertType2_>)( \
+                                    &cppAssertSite_, \
+                                    cppAssertValue1_, \
+                                    cppAssertValue2_); \
         } \
     } CPP_ASSERT_WHILE_FALSE
 
 
-# define CPP_ASSERT_PRED_IMPL_1_(val1, val2, val1Text, val2Text, predicate, message) \
+# define CPP_ASSERT_PRED_IMPL_1_(level, val1, val2, val1Text, val2Text, predicate, message) \
     do \
     {   \
-        if((val1) predicate (val2)) \
+        CPP_ASSERT_SITE_PROLOGUE(level, predicate, val1Text, val2Text) \
+        if(CPP_ASSERT_SKIPPED(level, cppAssertSite_)) \
+        {   \
+            break; \
+        } \
+        CPP_ASSERT_BIND_ARGUMENT(cppAssertValue1_, CppAssertType1_, val1); \
+        CPP_ASSERT_BIND_ARGUMENT(cppAssertValue2_, CppAssertType2_, val2); \
+        if(CPP_ASSERT_LIKELY(CPP_ASSERT_COMPARE(predicate, \
+                                    cppAssertValue1_, cppAssertValue2_))) \
         { \
             ; \
         } \
         else \
         { \
-            ::cppassert::AssertionFailure(__LINE__, __FILE__, \
-                                    CPP_ASSERT_FUNCTION_NAME, \
-                ::cppassert::internal::getPredicateAssertionFailureMessage( \
-                                        CPP_ASSERT_STRING(predicate), \
-                                        val1Text, \
-                                        val2Text, \
-                                        std::move(::cppassert::AssertionMessage()<<val1), \
-                                        std::move(::cppassert::AssertionMessage()<<val2)) \
-                                        ).onAssertionFailure(::cppassert::AssertionMessage()<<message); \
+            [&](CppAssertType1_ cppAssertFailedValue1_, \
+                CppAssertType2_ cppAssertFailedValue2_) CPP_ASSERT_COLD_LAMBDA \
+            { \
+                (::cppassert::internal::onPredicateAssertionFailure< \
+                                    CppAssertType1_, CppAssertType2_>)( \
+                                    &cppAssertSite_, \
+                                    cppAssertFailedValue1_, \
+                                    cppAssertFailedValue2_, \
+                                    ::cppassert::AssertionMessage()<<message); \
+            }(cppAssertValue1_, cppAssertValue2_); \
         } \
     } CPP_ASSERT_WHILE_FALSE
 
@@ -209,17 +590,17 @@ std::string getAssertionFailureMessage(const char *statement);
 
 #else
 
-# define CPP_ASSERT_IMPL_0_(statement)
+# define CPP_ASSERT_IMPL_0_(level, statement)
 
-# define CPP_ASSERT_IMPL_1_(statement, message)
+# define CPP_ASSERT_IMPL_1_(level, statement, message)
 
-# define CPP_ASSERT_BOOL_IMPL_0_(expression, text, actual, expected)
+# define CPP_ASSERT_BOOL_IMPL_0_(level, expression, text, actual, expected)
 
-# define CPP_ASSERT_BOOL_IMPL_1_(expression, text, actual, expected, message)
+# define CPP_ASSERT_BOOL_IMPL_1_(level, expression, text, actual, expected, message)
 
-# define CPP_ASSERT_PRED_IMPL_0_(val1, val2, val1Text, val2Text, predicate)
+# define CPP_ASSERT_PRED_IMPL_0_(level, val1, val2, val1Text, val2Text, predicate)
 
-# define CPP_ASSERT_PRED_IMPL_1_(val1, val2, val1Text, val2Text, predicate, message)
+# define CPP_ASSERT_PRED_IMPL_1_(level, val1, val2, val1Text, val2Text, predicate, message)
 
 
 #endif
@@ -228,22 +609,22 @@ std::string getAssertionFailureMessage(const char *statement);
 #ifdef CPP_ASSERT_ENABLED
 
 # define CPP_ASSERT_IMPL_1(statement) \
-    CPP_ASSERT_IMPL_0_(statement)
+    CPP_ASSERT_IMPL_0_(Debug, statement)
 
 # define CPP_ASSERT_IMPL_2(statement, message) \
-    CPP_ASSERT_IMPL_1_(statement, message)
+    CPP_ASSERT_IMPL_1_(Debug, statement, message)
 
 # define CPP_ASSERT_BOOL_IMPL_0(expression, text, actual, expected) \
-    CPP_ASSERT_BOOL_IMPL_0_(expression, text, actual, expected)
+    CPP_ASSERT_BOOL_IMPL_0_(Debug, expression, text, actual, expected)
 
 # define CPP_ASSERT_BOOL_IMPL_1(expression, text, actual, expected, message) \
-    CPP_ASSERT_BOOL_IMPL_1_(expression, text, actual, expected, message)
+    CPP_ASSERT_BOOL_IMPL_1_(Debug, expression, text, actual, expected, message)
 
 # define CPP_ASSERT_PRED_IMPL_0(val1, val2, val1Text, val2Text, predicate) \
-    CPP_ASSERT_PRED_IMPL_0_(val1, val2, val1Text, val2Text, predicate)
+    CPP_ASSERT_PRED_IMPL_0_(Debug, val1, val2, val1Text, val2Text, predicate)
 
 # define CPP_ASSERT_PRED_IMPL_1(val1, val2, val1Text, val2Text, predicate, message) \
-    CPP_ASSERT_PRED_IMPL_1_(val1, val2, val1Text, val2Text, predicate, message)
+    CPP_ASSERT_PRED_IMPL_1_(Debug, val1, val2, val1Text, val2Text, predicate, message)
 
 #else
 
@@ -262,23 +643,56 @@ std::string getAssertionFailureMessage(const char *statement);
 #endif
 
 
+#ifdef CPP_ASSERT_CHEAP_ENABLED
+
+# define CPP_ASSERT_CHEAP_IMPL_1(statement) \
+    CPP_ASSERT_IMPL_0_(Cheap, statement)
+
+# define CPP_ASSERT_CHEAP_IMPL_2(statement, message) \
+    CPP_ASSERT_IMPL_1_(Cheap, statement, message)
+
+#else
+
+# define CPP_ASSERT_CHEAP_IMPL_1(statement)
+
+# define CPP_ASSERT_CHEAP_IMPL_2(statement, message)
+
+#endif
+
+
+#ifdef CPP_ASSERT_AUDIT_ENABLED
+
+# define CPP_ASSERT_AUDIT_IMPL_1(statement) \
+    CPP_ASSERT_IMPL_0_(Audit, statement)
+
+# define CPP_ASSERT_AUDIT_IMPL_2(statement, message) \
+    CPP_ASSERT_IMPL_1_(Audit, statement, message)
+
+#else
+
+# define CPP_ASSERT_AUDIT_IMPL_1(statement)
+
+# define CPP_ASSERT_AUDIT_IMPL_2(statement, message)
+
+#endif
+
+
 #define CPP_ASSERT_ALWAYS_IMPL_1(statement) \
-    CPP_ASSERT_IMPL_0_(statement)
+    CPP_ASSERT_IMPL_0_(Always, statement)
 
 #define CPP_ASSERT_ALWAYS_IMPL_2(statement, message) \
-    CPP_ASSERT_IMPL_1_(statement, message)
+    CPP_ASSERT_IMPL_1_(Always, statement, message)
 
 #define CPP_ASSERT_ALWAYS_BOOL_0(expression, text, actual, expected) \
-    CPP_ASSERT_BOOL_IMPL_0_(expression, text, actual, expected)
+    CPP_ASSERT_BOOL_IMPL_0_(Always, expression, text, actual, expected)
 
 #define CPP_ASSERT_ALWAYS_BOOL_1(expression, text, actual, expected, message) \
-    CPP_ASSERT_BOOL_IMPL_1_(expression, text, actual, expected, message)
+    CPP_ASSERT_BOOL_IMPL_1_(Always, expression, text, actual, expected, message)
 
 #define CPP_ASSERT_ALWAYS_PRED_IMPL_0(val1, val2, val1Text, val2Text, predicate) \
-   CPP_ASSERT_PRED_IMPL_0_(val1, val2, val1Text, val2Text, predicate)
+   CPP_ASSERT_PRED_IMPL_0_(Always, val1, val2, val1Text, val2Text, predicate)
 
 #define CPP_ASSERT_ALWAYS_PRED_IMPL_1(val1, val2, val1Text, val2Text, predicate, message) \
-   CPP_ASSERT_PRED_IMPL_1_(val1, val2, val1Text, val2Text, predicate, message)
+   CPP_ASSERT_PRED_IMPL_1_(Always, val1, val2, val1Text, val2Text, predicate, message)
 
 #endif	/* CPP_ASSERT_HELPERS_HPP */
-
@@ -0,0 +1,139 @@
+#pragma once
+#ifndef CPP_ASSERT_MODULEMAP_HPP
+#define	CPP_ASSERT_MODULEMAP_HPP
+#include <cppassert/MessageSink.hpp>
+#include <cppassert/details/StackTrace.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) && defined(__ELF__)
+#   define CPP_ASSERT_HAVE_MODULE_MAP 1
+#endif
+
+namespace cppassert
+{
+namespace internal
+{
+
+/**
+ * Snapshot of modules, executable and shared libraries, loaded into the
+ * process. Addresses of stack frames are translated to module index and
+ * offset from module load address, which together with GNU build-id of
+ * the module identify an instruction across processes, so traces can be
+ * symbolized offline against debug files stored by build-id, see
+ * `cppassert-symbolize`. Snapshot is immutable, it's taken once and
+ * replaced only when `dlopen` or `dlclose` changes set of loaded modules.
+ */
+class ModuleMap
+{
+    ModuleMap(const ModuleMap &) = delete;
+    ModuleMap &operator=(const ModuleMap &) = delete;
+public:
+    /**
+     * Executable segment of a module, addresses are the ones in process
+     */
+    struct Segment
+    {
+        std::uintptr_t begin;
+        std::uintptr_t end;
+        std::uint32_t module;
+    };
+
+    /**
+     * Loaded module
+     */
+    struct Module
+    {
+        std::string path;           ///< Path of module file
+        std::uintptr_t base = 0;    ///< Load address, 0 for non-PIE
+        std::string buildId;        ///< Hex encoded GNU build-id or empty
+    };
+
+    /**
+     * Frame address relative to its module
+     */
+    struct Frame
+    {
+        std::uint32_t module = UnknownModule;   ///< Index of module
+        /**
+         * Offset from module load address, it's the address in module
+         * file. Absolute address if module is UnknownModule.
+         */
+        std::uintptr_t offset = 0;
+    };
+
+    static const std::uint32_t UnknownModule = UINT32_MAX;
+
+    /**
+     * Returns snapshot of currently loaded modules. Modules are listed
+     * with `dl_iterate_phdr` on first call and again only when its
+     * counters of loaded and unloaded modules change.
+     *
+     * @return  Current snapshot, never nullptr
+     */
+    static std::shared_ptr<const ModuleMap> getCurrent();
+
+    /**
+     * Returns number of modules
+     * @return  Number of modules
+     */
+    std::size_t getModuleCount() const;
+
+    /**
+     * Returns module at \p index, if index is out of range
+     * std::out_of_range exception is thrown
+     * @param   index   Module index
+     * @return  Module
+     */
+    const Module &getModule(std::size_t index) const;
+
+    /**
+     * Finds module of an address, it's a binary search over executable
+     * segments
+     * @param   address     Return address of stack frame
+     * @return  Module index and offset
+     */
+    Frame findFrame(const void *address) const;
+
+    /**
+     * Formats stack frames as a raw record that can be symbolized
+     * offline. Only modules with frames are listed, i.e.
+     * @code
+        cppassert-frames 2
+        module 0 3f1c0e5a... 0x55d2c3a00000 /usr/bin/app
+        frame 0 0x1a2b
+        frame - 0x7f0011223344
+        end
+     * @endcode
+     * where frame of unknown module has `-` and absolute address.
+     *
+     * @param   frames  Stack frames captured while this map is current
+     * @return  Raw record, empty if there are no frames
+     */
+    std::string formatFrames(const StackTrace &frames) const;
+
+    /**
+     * Appends raw record of stack frames to \p sink, see formatFrames
+     *
+     * @param   frames  Stack frames captured while this map is current
+     * @param   sink    Output the record is appended to
+     */
+    void appendFrames(const StackTrace &frames, MessageSink &sink) const;
+
+    ~ModuleMap();
+private:
+    ModuleMap();
+
+    class Loader;
+
+    std::vector<Module> modules_;
+    std::vector<Segment> segments_;
+};
+
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_MODULEMAP_HPP */
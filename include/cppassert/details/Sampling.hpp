@@ -0,0 +1,147 @@
+#pragma once
+#ifndef CPP_ASSERT_SAMPLING_HPP
+#define	CPP_ASSERT_SAMPLING_HPP
+#include "Helpers.hpp"
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+#if !defined(__x86_64__) && !defined(__i386__) \
+    && !defined(_M_X64) && !defined(_M_IX86)
+#   include <chrono>
+#endif
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#   define CPP_ASSERT_THREAD_LOCAL __declspec(thread)
+#else
+#   define CPP_ASSERT_THREAD_LOCAL thread_local
+#endif
+
+namespace cppassert
+{
+namespace internal
+{
+
+/**
+ * Returns current value of cheap monotonic clock. On x86 it's time stamp
+ * counter, on other platforms steady clock in nanoseconds.
+ *
+ * @return  Current clock value in ticks
+ */
+inline std::uint64_t readSamplingClock()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * Returns number of readSamplingClock() ticks in given number of
+ * milliseconds. Time stamp counter frequency is calibrated against steady
+ * clock on first call.
+ *
+ * @param   milliseconds    Interval in milliseconds
+ * @return  Interval in ticks
+ */
+std::uint64_t getSamplingClockTicks(std::uint64_t milliseconds);
+
+/**
+ * Returns number of calls to skip before next evaluation of
+ * CPP_ASSERT_SAMPLED predicate. It's uniformly distributed in
+ * [1, 2*n-1] so that on average 1 in n calls is evaluated. Uses per thread
+ * xorshift generator.
+ *
+ * @param   n   Average sampling interval
+ * @return  Calls till next evaluation
+ */
+std::uint32_t getSampledCountdown(std::uint32_t n);
+
+/**
+ * Returns number of calls to next evaluation of
+ * CPP_ASSERT_EVERY_N predicate
+ *
+ * @param   n   Sampling interval
+ * @return  Calls till next evaluation
+ */
+inline std::uint32_t getEveryNCountdown(std::uint32_t n)
+{
+    return (n!=0) ? n : 1;
+}
+
+} //internal
+} //cppassert
+
+/*
+ * Sampled assertions wrap regular CPP_ASSERT_ALWAYS site. Countdown and
+ * deadline are per site and per thread so skipped evaluation never
+ * touches shared cache line. First call in every thread is evaluated.
+ */
+#ifndef CPP_ASSERT_DISABLE_ALL
+
+# define CPP_ASSERT_COUNTDOWN_IMPL_(countdown, assertion) \
+    do \
+    { \
+        static CPP_ASSERT_THREAD_LOCAL std::uint32_t cppAssertCountdown_ = 1; \
+        if(CPP_ASSERT_LIKELY(--cppAssertCountdown_!=0)) \
+        { \
+            break; \
+        } \
+        cppAssertCountdown_ = countdown; \
+        assertion; \
+    } CPP_ASSERT_WHILE_FALSE
+
+# define CPP_ASSERT_EVERY_MS_IMPL_(milliseconds, assertion) \
+    do \
+    { \
+        static CPP_ASSERT_THREAD_LOCAL std::uint64_t cppAssertDeadline_ = 0; \
+        const std::uint64_t cppAssertNow_ \
+                = ::cppassert::internal::readSamplingClock(); \
+        if(CPP_ASSERT_LIKELY(cppAssertNow_<cppAssertDeadline_)) \
+        { \
+            break; \
+        } \
+        cppAssertDeadline_ = cppAssertNow_ \
+            + ::cppassert::internal::getSamplingClockTicks(milliseconds); \
+        assertion; \
+    } CPP_ASSERT_WHILE_FALSE
+
+#else
+
+# define CPP_ASSERT_COUNTDOWN_IMPL_(countdown, assertion)
+
+# define CPP_ASSERT_EVERY_MS_IMPL_(milliseconds, assertion)
+
+#endif
+
+#define CPP_ASSERT_SAMPLED_2(n, condition) \
+    CPP_ASSERT_COUNTDOWN_IMPL_(::cppassert::internal::getSampledCountdown(n), \
+                               CPP_ASSERT_IMPL_0_(Always, condition))
+
+#define CPP_ASSERT_SAMPLED_3(n, condition, message) \
+    CPP_ASSERT_COUNTDOWN_IMPL_(::cppassert::internal::getSampledCountdown(n), \
+                               CPP_ASSERT_IMPL_1_(Always, condition, message))
+
+#define CPP_ASSERT_EVERY_N_2(n, condition) \
+    CPP_ASSERT_COUNTDOWN_IMPL_(::cppassert::internal::getEveryNCountdown(n), \
+                               CPP_ASSERT_IMPL_0_(Always, condition))
+
+#define CPP_ASSERT_EVERY_N_3(n, condition, message) \
+    CPP_ASSERT_COUNTDOWN_IMPL_(::cppassert::internal::getEveryNCountdown(n), \
+                               CPP_ASSERT_IMPL_1_(Always, condition, message))
+
+#define CPP_ASSERT_EVERY_MS_2(milliseconds, condition) \
+    CPP_ASSERT_EVERY_MS_IMPL_(milliseconds, \
+                              CPP_ASSERT_IMPL_0_(Always, condition))
+
+#define CPP_ASSERT_EVERY_MS_3(milliseconds, condition, message) \
+    CPP_ASSERT_EVERY_MS_IMPL_(milliseconds, \
+                              CPP_ASSERT_IMPL_1_(Always, condition, message))
+
+#endif	/* CPP_ASSERT_SAMPLING_HPP */
@@ -1,10 +1,34 @@
 #pragma once
 #ifndef CPP_ASSERT_STACKTRACE_HPP
 #define	CPP_ASSERT_STACKTRACE_HPP
-#include <vector>
 #include <memory>
+#include <cstddef>
 #include <cstdint>
 
+/*
+ * Functions of the library that collect stack traces are placed in
+ * `cppassert_text` section, so that their frames are recognized by address
+ * and removed from the top of collected traces, however many of them were
+ * inlined or merged by LTO. Where sections aren't available frames of the
+ * library are skipped by count, so these functions are kept out of line.
+ * Functions defined in headers would land in comdat sections, which can't
+ * share the section with other functions, they are always inlined instead.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__ELF__)
+#   define CPP_ASSERT_HAVE_LIBRARY_SECTION 1
+#   define CPP_ASSERT_LIBRARY_CODE __attribute__((section("cppassert_text")))
+#   define CPP_ASSERT_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#   define CPP_ASSERT_LIBRARY_CODE __declspec(noinline)
+#   define CPP_ASSERT_ALWAYS_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#   define CPP_ASSERT_LIBRARY_CODE __attribute__((noinline))
+#   define CPP_ASSERT_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#   define CPP_ASSERT_LIBRARY_CODE
+#   define CPP_ASSERT_ALWAYS_INLINE inline
+#endif
+
 namespace cppassert
 {
 namespace internal
@@ -12,8 +36,69 @@ namespace internal
 
 class StackTraceImpl;
 
+void setMaxStackDepth(std::size_t depth);
+std::size_t getMaxStackDepth();
+
+/**
+ * Tests whether return address belongs to a function of the library
+ * marked with CPP_ASSERT_LIBRARY_CODE
+ *
+ * @param   address     Return address of stack frame
+ * @return  false if the address is outside of the library or sections
+ *          aren't available
+ */
+bool isLibraryCode(const void *address);
+
+/**
+ * Returns number of frames of the library on top of collected addresses
+ *
+ * @param   addresses       Return addresses, the innermost frame first
+ * @param   size            Number of addresses
+ * @param   libraryFrames   Number of frames of the library when they can't
+ *                          be recognized by address
+ * @return  Number of leading frames to be skipped
+ */
+std::size_t countLibraryFrames(const void *const *addresses,
+                               std::size_t size,
+                               std::size_t libraryFrames);
+
+/**
+ * Returns \p frames when frames of the library are skipped by count and
+ * 0 when they are recognized by address, it's used by functions of the
+ * library which pass their own frames to StackTrace::getStackTrace
+ *
+ * @param   frames      Number of frames of the caller
+ * @return  Number of frames to be skipped
+ */
+constexpr std::size_t getLibraryFrames(std::size_t frames)
+{
+#ifdef CPP_ASSERT_HAVE_LIBRARY_SECTION
+    return (static_cast<void>(frames), std::size_t(0));
+#else
+    return frames;
+#endif
+}
+
 /**
- * Portable wrapper for stack trace collection
+ * Source file and line of code that a stack frame belongs to
+ */
+struct SourceLocation
+{
+    const char *file = nullptr;         ///< Path of source file
+    std::uint32_t line = 0;             ///< Line number, 0 if unknown
+    /**
+     * Name of inlined function that contains the location or nullptr
+     * if the location belongs to function of frame symbol
+     */
+    const char *function = nullptr;
+};
+
+/**
+ * Portable wrapper for stack trace collection. Only return addresses are
+ * captured, frames are symbolized on demand, either one by one with
+ * StackFrame::getSymbol() or all at once with symbolize(). Symbolization
+ * modifies the trace, it's not safe to symbolize the same trace from
+ * several threads at the same time.
  */
 class StackTrace
 {
@@ -31,18 +116,63 @@ public:
         const void *getAddress() const;
         /**
          * Returns string that describe the address
-         * symbolically
+         * symbolically, frame is symbolized on first call
          *
-         * @return symbol name or nu
+         * @return symbol name or nullptr if not available
          */
         const char *getSymbol() const;
+
+        /**
+         * Tests whether frame was already symbolized
+         *
+         * @return  true if getSymbol() doesn't need to resolve the address
+         */
+        bool isSymbolized() const;
+
+        /**
+         * Returns number of source locations of the frame, frame is
+         * symbolized on first call. The first location is the one of
+         * frame address, each next one is a call site of inlined function
+         * that contains the previous location. It's 0 if debug
+         * information is not available.
+         *
+         * @return  Number of source locations
+         */
+        std::size_t getSourceLocationCount() const;
+
+        /**
+         * Returns source location at \p position, if position is greater
+         * than number of locations std::out_of_range exception is thrown
+         *
+         * @param   position    Number of location, 0 is innermost one
+         * @return  Source location
+         */
+        const SourceLocation &getSourceLocation(std::size_t position) const;
     protected:
-        StackFrame(const void *address, const char *symbol);
+        StackFrame(const void *address, StackTraceImpl *trace,
+                   std::size_t position);
         StackFrame() = default;
         const void *address_ = nullptr;
         const char *symbol_ = nullptr;
+        StackTraceImpl *trace_ = nullptr;
+        const SourceLocation *locations_ = nullptr;
+        std::uint32_t position_ = 0;
+        std::uint32_t locationCount_ = 0;
     };
 
+    enum : std::size_t
+    {
+        /**
+         * Maximal number of frames of a stack trace
+         */
+        MaxDepth = 256
+    };
+
+    /**
+     * Creates empty stack trace, it doesn't allocate
+     */
+    StackTrace();
+
     /**
      * Move constructor
      * @param   other   stack trace to be moved
@@ -59,10 +189,46 @@ public:
     ~StackTrace();
 
     /**
-     * Collects and returns current stack trace
+     * Collects and returns current stack trace, frames are not
+     * symbolized. Frames are stored inline in the trace for typical
+     * depths, deeper traces allocate storage of their actual size.
+     * Frames of the library are never included, see isLibraryCode.
+     * @param   framesToSkip    Number of frames below the caller that
+     *                          shouldn't be included, 0 means that the
+     *                          first frame is the caller
+     * @param   maxDepth        Maximal number of frames to be collected,
+     *                          0 means getMaxStackDepth(), it's limited
+     *                          to MaxDepth
      * @return  Stack trace
      */
-    static StackTrace getStackTrace();
+    CPP_ASSERT_LIBRARY_CODE
+    static StackTrace getStackTrace(std::size_t framesToSkip = 0,
+                                    std::size_t maxDepth = 0);
+
+    /**
+     * Collects return addresses of current stack without creating a
+     * trace, it doesn't allocate
+     * @param[out]  addresses       Buffer for at least \p maxDepth addresses
+     * @param[in]   maxDepth        Size of \p addresses, unwinding stops
+     *                              there, it's limited to MaxDepth
+     * @param[in]   framesToSkip    Number of frames below the caller that
+     *                              shouldn't be included
+     * @return  Number of addresses written to \p addresses
+     */
+    CPP_ASSERT_LIBRARY_CODE
+    static std::size_t getReturnAddresses(void **addresses,
+                                          std::size_t maxDepth,
+                                          std::size_t framesToSkip = 0);
+
+    /**
+     * Creates stack trace from return addresses collected earlier i.e.
+     * with getReturnAddresses, frames are not symbolized
+     * @param   addresses   Return addresses, the innermost frame first
+     * @param   size        Number of addresses
+     * @return  Stack trace
+     */
+    static StackTrace fromReturnAddresses(const void *const *addresses,
+                                          std::size_t size);
 
     /**
      * Returns number of frames
@@ -77,8 +243,13 @@ public:
      * @return StackFrame at \p position
      */
     const StackFrame &operator[](std::size_t position) const;
+
+    /**
+     * Symbolizes all frames which weren't symbolized yet, it's cheaper
+     * than symbolizing frames one by one.
+     */
+    void symbolize() const;
 private:
-    StackTrace();
     StackTrace(const StackTrace &) = delete;
     StackTrace &operator=(const StackTrace &) = delete;
 
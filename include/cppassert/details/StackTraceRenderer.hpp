@@ -0,0 +1,113 @@
+#pragma once
+#ifndef CPP_ASSERT_STACKTRACERENDERER_HPP
+#define	CPP_ASSERT_STACKTRACERENDERER_HPP
+#include <cppassert/MessageSink.hpp>
+#include <cppassert/details/StackTrace.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cppassert
+{
+
+/**
+ * Rules that bound size of rendered stack traces, see
+ * CppAssert::setStackTraceFilter. Frames keep numbers of their position
+ * in the trace, so that hidden frames leave a gap.
+ */
+struct StackTraceFilter
+{
+    /**
+     * Maximal number of rendered frames, 0 means all of them. Frames
+     * below are neither symbolized nor formatted, they are summarized by
+     * a single line.
+     */
+    std::size_t maxFrames = 0;
+
+    /**
+     * Frames which function name starts with one of prefixes, i.e.
+     * "std::" or "__gnu_cxx::", are hidden, every run of consecutive
+     * hidden frames is collapsed into a single line
+     */
+    std::vector<std::string> hiddenPrefixes;
+};
+
+namespace internal
+{
+
+void setStackTraceFilter(StackTraceFilter filter);
+std::shared_ptr<const StackTraceFilter> getStackTraceFilter();
+
+/**
+ * Renders frames of stack trace one by one into a single output sink,
+ * no intermediate message is built. All frames are symbolized at once
+ * unless number of rendered frames is bounded, then only rendered frames
+ * and hidden frames above them are.
+ */
+class StackTraceRenderer
+{
+public:
+    /**
+     * Creates renderer
+     * @param   filter  Rules to be applied, nullptr renders all frames
+     */
+    explicit StackTraceRenderer(std::shared_ptr<const StackTraceFilter> filter);
+
+    /**
+     * Appends frames of stack trace to \p output
+     * @param   frames          Stack trace to be rendered
+     * @param   output          Output frames are appended to
+     * @param   formatFrame     Appends a single frame, it's called as
+     *                          `formatFrame(output, frameNumber, address,
+     *                          symbol)`
+     */
+    template<typename FrameFormatter>
+    void render(const StackTrace &frames,
+                MessageSink &output,
+                FrameFormatter &&formatFrame) const
+    {
+        const std::size_t maxFrames = filter_ ? filter_->maxFrames : 0;
+        if(maxFrames==0)
+        {
+            frames.symbolize();
+        }
+        std::size_t rendered = 0;
+        std::size_t hidden = 0;
+        std::size_t position = 0;
+        for(; position<frames.size()
+              && (maxFrames==0 || rendered<maxFrames); ++position)
+        {
+            const StackTrace::StackFrame &frame = frames[position];
+            const char *symbol = frame.getSymbol();
+            if(isHidden(symbol))
+            {
+                ++hidden;
+                continue;
+            }
+            appendHidden(output, hidden);
+            hidden = 0;
+            formatFrame(output, static_cast<std::uint32_t>(position)
+                        , frame.getAddress(), symbol);
+            ++rendered;
+        }
+        appendHidden(output, hidden);
+        appendElided(output, frames.size()-position);
+    }
+private:
+    /*
+     * Function name follows module name and opening parenthesis in
+     * symbols of backtrace_symbols format
+     */
+    bool isHidden(const char *symbol) const;
+    static void appendHidden(MessageSink &output, std::size_t frames);
+    static void appendElided(MessageSink &output, std::size_t frames);
+
+    std::shared_ptr<const StackTraceFilter> filter_;
+};
+
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_STACKTRACERENDERER_HPP */
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef CPP_ASSERT_STACKUNWINDER_HPP
+#define	CPP_ASSERT_STACKUNWINDER_HPP
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__GNUC__) && !defined(_WIN32)
+#   define CPP_ASSERT_HAVE_UNWIND_BACKTRACE 1
+#   if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+#       define CPP_ASSERT_HAVE_FRAME_POINTER_UNWINDER 1
+#   endif
+#endif
+
+namespace cppassert
+{
+
+/**
+ * Method used to collect return addresses of stack frames. Unwinders
+ * that aren't available on the platform, or fail to collect any frame,
+ * fall back to StackUnwinder::Backtrace.
+ */
+enum class StackUnwinder : std::uint8_t
+{
+    /**
+     * `backtrace` of libc, it goes through libgcc unwinder, its first
+     * call loads `libgcc_s`
+     */
+    Backtrace,
+    /**
+     * `_Unwind_Backtrace` of libgcc called directly, it parses unwind
+     * tables of each frame and stops at maximal depth
+     */
+    UnwindBacktrace,
+    /**
+     * Walks chain of frame pointers bounded by stack of calling thread,
+     * it's the fastest one and doesn't lock, but it requires code to be
+     * compiled with `-fno-omit-frame-pointer`, frames of functions
+     * without frame pointer are missing
+     */
+    FramePointer
+};
+
+namespace internal
+{
+    void setStackUnwinder(StackUnwinder unwinder);
+    StackUnwinder getStackUnwinder();
+
+    /**
+     * Collects return addresses with `_Unwind_Backtrace`, frame 0 is
+     * the caller
+     *
+     * @param   frames      Buffer for return addresses
+     * @param   maxFrames   Size of \p frames, unwinding stops there
+     * @return  Number of collected frames, 0 if unwinder isn't available
+     */
+    std::size_t captureWithUnwind(void **frames, std::size_t maxFrames);
+
+    /**
+     * Collects return addresses by walking frame pointers, frame 0 is
+     * the caller. Frames outside of stack of calling thread are not
+     * followed, stack bounds are read once per thread on first call.
+     *
+     * @param   frames      Buffer for return addresses
+     * @param   maxFrames   Size of \p frames, walk stops there
+     * @return  Number of collected frames, 0 if unwinder isn't available
+     */
+    std::size_t captureWithFramePointers(void **frames,
+                                         std::size_t maxFrames);
+}
+} //cppassert
+
+#endif	/* CPP_ASSERT_STACKUNWINDER_HPP */
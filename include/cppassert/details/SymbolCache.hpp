@@ -0,0 +1,184 @@
+#pragma once
+#ifndef CPP_ASSERT_SYMBOLCACHE_HPP
+#define	CPP_ASSERT_SYMBOLCACHE_HPP
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cppassert
+{
+namespace internal
+{
+
+/**
+ * Memory mapped cache file of symbol index or line table of a module,
+ * named by GNU build-id of the module, i.e. `<directory>/<build-id>.sym`.
+ * File has a header followed by sections aligned to 8 bytes, which are
+ * arrays of the in-memory layout, so they are searched in place. Cache is
+ * used only if its header matches build-id, kind, byte order and pointer
+ * size of the process, modules without build-id are never cached.
+ * Caching is disabled until a directory is set with setDirectory() or
+ * with `CPPASSERT_SYMBOL_CACHE` environment variable.
+ */
+class SymbolCacheFile
+{
+    SymbolCacheFile(const SymbolCacheFile &) = delete;
+    SymbolCacheFile &operator=(const SymbolCacheFile &) = delete;
+public:
+    /**
+     * Contents of the file
+     */
+    enum class Kind : std::uint32_t
+    {
+        Symbols = 1,    ///< ElfSymbolIndex
+        Lines = 2       ///< DwarfLineTable
+    };
+
+    enum : std::size_t { MaxSections = 5 };
+
+    /**
+     * Section of the file
+     */
+    struct Section
+    {
+        const char *data = nullptr;     ///< Contents
+        std::size_t size = 0;           ///< Size in bytes
+    };
+
+    /**
+     * Creates file that isn't mapped
+     */
+    SymbolCacheFile() = default;
+
+    SymbolCacheFile(SymbolCacheFile &&other) noexcept;
+    SymbolCacheFile &operator=(SymbolCacheFile &&other) noexcept;
+    ~SymbolCacheFile();
+
+    /**
+     * Maps cache file of module with \p buildId
+     * @param   buildId     Hex encoded build-id of module
+     * @param   kind        Contents of the file
+     * @return  Mapped file, invalid if caching is disabled, build-id is
+     *          empty or file is missing or doesn't match
+     */
+    static SymbolCacheFile open(const std::string &buildId, Kind kind);
+
+    /**
+     * Writes cache file of module with \p buildId, file is written under
+     * temporary name and renamed so that readers never see partial file
+     * @param   buildId     Hex encoded build-id of module
+     * @param   kind        Contents of the file
+     * @param   sections    Sections to write
+     * @param   count       Number of sections, at most MaxSections
+     * @return  false if caching is disabled or file couldn't be written
+     */
+    static bool write(const std::string &buildId, Kind kind,
+                      const Section *sections, std::size_t count);
+
+    /**
+     * Sets directory of cache files, it's created if it doesn't exist
+     * @param   directory   Cache directory, empty disables caching
+     */
+    static void setDirectory(const std::string &directory);
+
+    /**
+     * Returns directory of cache files
+     * @return  Cache directory, empty if caching is disabled
+     */
+    static std::string getDirectory();
+
+    /**
+     * Tests whether file was mapped and validated
+     * @return  true if file can be used
+     */
+    bool isValid() const;
+
+    /**
+     * Returns section at \p index
+     * @param   index   Index of section
+     * @return  Section, empty if there is no such section
+     */
+    Section getSection(std::size_t index) const;
+private:
+    void unmap();
+
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * Array which elements are either owned or stored in a mapped cache file
+ */
+template <typename T>
+class CachedArray
+{
+public:
+    /**
+     * Returns owned elements, they are used until array is mapped
+     * @return  Owned elements
+     */
+    std::vector<T> &getStorage()
+    {
+        return storage_;
+    }
+
+    /**
+     * Makes array refer to elements of cache section
+     * @param   section     Section, its size has to be multiple of
+     *                      element size
+     */
+    void map(const SymbolCacheFile::Section &section)
+    {
+        storage_.clear();
+        storage_.shrink_to_fit();
+        mapped_ = reinterpret_cast<const T *>(section.data);
+        mappedSize_ = section.size/sizeof(T);
+    }
+
+    /**
+     * Returns section of elements that can be written to cache file
+     * @return  Section of elements
+     */
+    SymbolCacheFile::Section getSection() const
+    {
+        SymbolCacheFile::Section section;
+        section.data = reinterpret_cast<const char *>(begin());
+        section.size = size()*sizeof(T);
+        return section;
+    }
+
+    const T *begin() const
+    {
+        return mapped_ ? mapped_ : storage_.data();
+    }
+
+    const T *end() const
+    {
+        return begin()+size();
+    }
+
+    std::size_t size() const
+    {
+        return mapped_ ? mappedSize_ : storage_.size();
+    }
+
+    bool empty() const
+    {
+        return (size()==0);
+    }
+
+    const T &operator[](std::size_t index) const
+    {
+        return begin()[index];
+    }
+private:
+    std::vector<T> storage_;
+    const T *mapped_ = nullptr;
+    std::size_t mappedSize_ = 0;
+};
+
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_SYMBOLCACHE_HPP */
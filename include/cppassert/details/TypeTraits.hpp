@@ -0,0 +1,181 @@
+#pragma once
+#ifndef CPP_ASSERT_TYPETRAITS_HPP
+#define	CPP_ASSERT_TYPETRAITS_HPP
+
+/*
+ * Minimal type traits used by assertion macros. They are defined here
+ * instead of including <type_traits> to keep cppassert/Assert.hpp cheap
+ * to compile. Class, union and enum detection relies on compiler
+ * intrinsics available in GCC, Clang and Visual C++.
+ */
+namespace cppassert
+{
+namespace internal
+{
+
+template<bool condition, typename TrueType, typename FalseType>
+struct Conditional
+{
+    using type = TrueType;
+};
+
+template<typename TrueType, typename FalseType>
+struct Conditional<false, TrueType, FalseType>
+{
+    using type = FalseType;
+};
+
+template<typename T>
+struct RemoveReference
+{
+    using type = T;
+};
+
+template<typename T>
+struct RemoveReference<T &>
+{
+    using type = T;
+};
+
+template<typename T>
+struct RemoveReference<T &&>
+{
+    using type = T;
+};
+
+template<typename T>
+struct RemoveCv
+{
+    using type = T;
+};
+
+template<typename T>
+struct RemoveCv<const T>
+{
+    using type = T;
+};
+
+template<typename T>
+struct RemoveCv<volatile T>
+{
+    using type = T;
+};
+
+template<typename T>
+struct RemoveCv<const volatile T>
+{
+    using type = T;
+};
+
+/**
+ * Type of a value passed by value, arrays and functions decay to pointers
+ */
+template<typename T>
+struct DecayValue
+{
+    using type = typename RemoveCv<T>::type;
+};
+
+template<typename T, decltype(sizeof(0)) size>
+struct DecayValue<T[size]>
+{
+    using type = T *;
+};
+
+template<typename T>
+struct DecayValue<T[]>
+{
+    using type = T *;
+};
+
+template<typename Result, typename... Arguments>
+struct DecayValue<Result(Arguments...)>
+{
+    using type = Result (*)(Arguments...);
+};
+
+template<typename Result, typename... Arguments>
+struct DecayValue<Result(Arguments..., ...)>
+{
+    using type = Result (*)(Arguments..., ...);
+};
+
+template<typename T>
+struct Decay
+{
+    using type = typename DecayValue<
+                            typename RemoveReference<T>::type>::type;
+};
+
+/**
+ * Tests whether decayed type is a scalar. After decay the only non scalar
+ * object types left are classes and unions.
+ */
+template<typename T>
+struct IsScalar
+{
+    static const bool value = !__is_class(T) && !__is_union(T);
+};
+
+template<typename T>
+struct IsEnum
+{
+    static const bool value = __is_enum(T);
+};
+
+template<bool condition, typename T = void>
+struct EnableIf
+{
+};
+
+template<typename T>
+struct EnableIf<true, T>
+{
+    using type = T;
+};
+
+template<typename T>
+struct UnderlyingType
+{
+    using type = __underlying_type(T);
+};
+
+/**
+ * Tests whether arithmetic type is signed
+ */
+template<typename T>
+struct IsSigned
+{
+    static const bool value = (T(-1)<T(0));
+};
+
+/**
+ * Same as std::declval, used in unevaluated operands only
+ */
+template<typename T>
+T &&declareValue();
+
+/**
+ * Tests whether type is an unscoped enumeration, only those convert
+ * implicitly to their underlying type
+ */
+template<typename T, bool isEnum = __is_enum(T)>
+struct IsUnscopedEnum
+{
+    static const bool value = false;
+};
+
+template<typename T>
+struct IsUnscopedEnum<T, true>
+{
+private:
+    static char test(typename UnderlyingType<T>::type);
+    static char (&test(...))[2];
+public:
+    static const bool value = (sizeof(test(declareValue<T>()))==1);
+};
+
+} //internal
+} //cppassert
+
+#endif	/* CPP_ASSERT_TYPETRAITS_HPP */
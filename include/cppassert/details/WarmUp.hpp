@@ -0,0 +1,45 @@
+#pragma once
+#ifndef CPP_ASSERT_WARMUP_HPP
+#define	CPP_ASSERT_WARMUP_HPP
+#include <chrono>
+
+namespace cppassert
+{
+
+/**
+ * Time spent by steps of CppAssert::warmUp
+ */
+struct WarmUpTimes
+{
+    /**
+     * Loading of unwinder i.e. `libgcc_s` and the first stack capture
+     */
+    std::chrono::nanoseconds capture{0};
+    /**
+     * Building of symbol table and source line tables of modules on stack
+     */
+    std::chrono::nanoseconds symbolIndex{0};
+    /**
+     * Symbolization of captured stack including demangling
+     */
+    std::chrono::nanoseconds symbolization{0};
+    /**
+     * Formatting of captured stack and creation of process wide objects
+     * used on failure path
+     */
+    std::chrono::nanoseconds formatting{0};
+    /**
+     * Whole warm up, it's 0 if warm up didn't run yet
+     */
+    std::chrono::nanoseconds total{0};
+};
+
+namespace internal
+{
+    WarmUpTimes warmUp();
+    WarmUpTimes getWarmUpTimes();
+    void warmUpFromEnvironment();
+}
+} //cppassert
+
+#endif	/* CPP_ASSERT_WARMUP_HPP */
@@ -0,0 +1,89 @@
+#!/bin/sh
+#
+# Measures preprocessed line count and compile time of translation units
+# using cppassert headers. For every header a translation unit expanding
+# SITES assertion macros is generated, plain `assert` is used as baseline.
+# Additional source files given as arguments are measured as well.
+#
+# Usage: scripts/compileTime.sh [source.cpp ...]
+#
+#   CXX           compiler, c++ by default
+#   CXXFLAGS      compiler flags, "-std=c++11 -O2" by default
+#   SITES         number of assertion sites per translation unit, 100 by default
+#   REPETITIONS   compilations per translation unit, best time is reported,
+#                 5 by default
+#
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CXX=${CXX:=c++}
+CXXFLAGS=${CXXFLAGS:="-std=c++11 -O2"}
+SITES=${SITES:=100}
+REPETITIONS=${REPETITIONS:=5}
+
+type ${CXX} >/dev/null 2>&1 || { echo >&2 "[ERROR]: ${CXX} not found.  Aborting."; exit 1; }
+
+WORK_DIR=$(mktemp -d)
+trap 'rm -fr "${WORK_DIR}"' EXIT
+
+# generate_source <file> <headers> <assertion>, in assertion `@` is replaced
+# by site number
+generate_source()
+{
+    {
+        for HEADER in $2; do
+            echo "#include <${HEADER}>"
+        done
+        echo "int checkValues(const int *values)"
+        echo "{"
+        i=0
+        while [ ${i} -lt ${SITES} ]; do
+            echo "    $3" | sed "s/@/${i}/g"
+            i=$((i+1))
+        done
+        echo "    return values[0];"
+        echo "}"
+    } > "$1"
+}
+
+now_ms()
+{
+    echo $(($(date +%s%N)/1000000))
+}
+
+measure()
+{
+    LINES=$(${CXX} ${CXXFLAGS} -I"${ROOT}/include" -E "$1" | wc -l)
+    BEST=""
+    i=0
+    while [ ${i} -lt ${REPETITIONS} ]; do
+        START=$(now_ms)
+        ${CXX} ${CXXFLAGS} -I"${ROOT}/include" -c "$1" -o "${WORK_DIR}/tu.o" \
+            || { echo >&2 "[ERROR]: Unable to compile $1"; exit 1; }
+        TIME=$(($(now_ms)-START))
+        if [ -z "${BEST}" ] || [ ${TIME} -lt ${BEST} ]; then
+            BEST=${TIME}
+        fi
+        i=$((i+1))
+    done
+    printf "%-40s %12s %10s\n" "$2" "${LINES}" "${BEST}"
+}
+
+generate_source "${WORK_DIR}/assert.cpp" cassert \
+    'assert(values[@]==@);'
+generate_source "${WORK_DIR}/Assert.cpp" cppassert/Assert.hpp \
+    'CPP_ASSERT_ALWAYS_EQ(values[@], @, "value "<<@);'
+generate_source "${WORK_DIR}/Assertion.cpp" cppassert/Assertion.hpp \
+    'CPP_ASSERT_ALWAYS_EQ(values[@], @, "value "<<@);'
+generate_source "${WORK_DIR}/CppAssert.cpp" \
+    "cppassert/Assertion.hpp cppassert/CppAssert.hpp" \
+    'CPP_ASSERT_ALWAYS_EQ(values[@], @, "value "<<@);'
+
+echo "[INFO]: ${CXX} ${CXXFLAGS}, ${SITES} sites, best of ${REPETITIONS}"
+printf "%-40s %12s %10s\n" "Translation unit" "Lines" "Time [ms]"
+measure "${WORK_DIR}/assert.cpp" "<cassert>"
+measure "${WORK_DIR}/Assert.cpp" "<cppassert/Assert.hpp>"
+measure "${WORK_DIR}/Assertion.cpp" "<cppassert/Assertion.hpp>"
+measure "${WORK_DIR}/CppAssert.cpp" "<cppassert/CppAssert.hpp> as well"
+for SOURCE in "$@"; do
+    measure "${SOURCE}" "${SOURCE}"
+done
@@ -13,14 +13,37 @@ AssertionFailure::AssertionFailure(std::uint32_t line
     message_<<message;
 }
 
+AssertionFailure::AssertionFailure(const AssertionSite *site
+                    , std::string &&message)
+:sourceFileLine_(site->getLine()), sourceFileName_(site->getFile())
+, functionName_(site->getFunction()), site_(site)
+{
+    message_<<message;
+}
+
 
-void AssertionFailure::onAssertionFailure(const AssertionMessage &message)
+AssertionFailure::AssertionFailure(const AssertionSite *site
+                    , AssertionMessage &&message)
+:sourceFileLine_(site->getLine()), sourceFileName_(site->getFile())
+, functionName_(site->getFunction()), site_(site)
+, message_(std::move(message))
+{
+}
+
+void AssertionFailure::onAssertionFailure(const AssertionMessage &message,
+                                          std::uint32_t framesToSkip)
 {
     if(!message.empty())
     {
-        message_<<CppAssert::getInstance()->formatStreamedMessage(message.str());
+        MessageSink sink(message_);
+        CppAssert::getInstance()->formatStreamedMessage(sink, message);
     }
-    stackTrace_ = CppAssert::getInstance()->getStackTraceExceptTop(1);
+    //frames are symbolized on demand, see getStackTrace()
+    stackTrace_ = internal::StackTrace::getStackTrace(
+                                    internal::getLibraryFrames(1)+framesToSkip
+                                    , site_ ? site_->getStackDepth() : 0);
+    moduleMap_ = internal::ModuleMap::getCurrent();
+    stackTraceRendered_ = false;
     CppAssert::getInstance()->onAssertionFailure((*this));
 }
 
@@ -39,19 +62,82 @@ const char *AssertionFailure::getFunctionName() const
     return functionName_;
 }
 
+const AssertionSite *AssertionFailure::getAssertionSite() const
+{
+    return site_;
+}
+
 const std::string &AssertionFailure::getStackTrace() const
+{
+    if(!stackTraceRendered_)
+    {
+        stackTraceRendered_ = true;
+        stackTraceText_.clear();
+        if(stackTrace_.size()>0)
+        {
+            MessageSink sink(stackTraceText_);
+            CppAssert::getInstance()->appendStackTrace(stackTrace_, sink);
+        }
+    }
+    return stackTraceText_;
+}
+
+const internal::StackTrace &AssertionFailure::getStackFrames() const
 {
     return stackTrace_;
 }
 
+const std::shared_ptr<const internal::ModuleMap> &
+AssertionFailure::getModuleMap() const
+{
+    return moduleMap_;
+}
+
+std::string AssertionFailure::getRawStackTrace() const
+{
+    if(!moduleMap_)
+    {
+        return std::string();
+    }
+    return moduleMap_->formatFrames(stackTrace_);
+}
+
 std::string AssertionFailure::getMessage() const
 {
     return message_.str();
 }
 
+void AssertionFailure::appendMessage(MessageSink &sink) const
+{
+    sink<<message_;
+}
+
+void AssertionFailure::appendStackTrace(MessageSink &sink) const
+{
+    if(stackTraceRendered_)
+    {
+        sink<<stackTraceText_;
+    }
+    else if(stackTrace_.size()>0)
+    {
+        CppAssert::getInstance()->appendStackTrace(stackTrace_, sink);
+    }
+}
+
+void AssertionFailure::appendRawStackTrace(MessageSink &sink) const
+{
+    if(moduleMap_)
+    {
+        moduleMap_->appendFrames(stackTrace_, sink);
+    }
+}
+
 std::string AssertionFailure::toString() const
 {
-    return CppAssert::getInstance()->formatAssertionMessage((*this));
+    std::string text;
+    MessageSink sink(text);
+    CppAssert::getInstance()->formatAssertionMessage(sink, (*this));
+    return text;
 }
 
 } //asrt
@@ -0,0 +1,278 @@
+#include <cppassert/AssertionSite.hpp>
+#include <cppassert/CppAssert.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#ifdef CPP_ASSERT_HAVE_SITE_SECTION
+/*
+ * Linker defines these symbols for every section which name is valid C
+ * identifier. They are declared weak so that executable that contains no
+ * assertion sites still links.
+ */
+extern "C"
+{
+extern const cppassert::AssertionSite *const __start_cppassert_sites[]
+    __attribute__((weak, visibility("hidden")));
+extern const cppassert::AssertionSite *const __stop_cppassert_sites[]
+    __attribute__((weak, visibility("hidden")));
+}
+#endif
+
+namespace cppassert
+{
+
+const char *AssertionSite::getPredicate() const
+{
+    switch(kind_)
+    {
+    case AssertionKind::Eq:
+        return "==";
+    case AssertionKind::Ne:
+        return "!=";
+    case AssertionKind::Lt:
+        return "<";
+    case AssertionKind::Le:
+        return "<=";
+    case AssertionKind::Gt:
+        return ">";
+    case AssertionKind::Ge:
+        return ">=";
+    default:
+        return nullptr;
+    }
+}
+
+static const std::uint32_t FNV_OFFSET_BASIS = 2166136261u;
+static const std::uint32_t FNV_PRIME = 16777619u;
+
+static std::uint32_t fnv1a(std::uint32_t hash, const char *text)
+{
+    for(; (*text)!='\0'; ++text)
+    {
+        hash ^= static_cast<unsigned char>(*text);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+std::uint32_t AssertionSite::getExpressionHash() const
+{
+    std::uint32_t hash = fnv1a(FNV_OFFSET_BASIS, expression_);
+    const char *predicate = getPredicate();
+    if(predicate!=nullptr)
+    {
+        hash = fnv1a(hash, " ");
+        hash = fnv1a(hash, predicate);
+        hash = fnv1a(hash, " ");
+        hash = fnv1a(hash, secondExpression_);
+    }
+    return hash;
+}
+
+namespace internal
+{
+
+static bool isSiteLess(const AssertionSite *first, const AssertionSite *second)
+{
+    const int result = std::strcmp(first->getFile(), second->getFile());
+    if(result!=0)
+    {
+        return (result<0);
+    }
+    if(first->getLine()!=second->getLine())
+    {
+        return (first->getLine()<second->getLine());
+    }
+    return std::less<const AssertionSite *>()(first, second);
+}
+
+/*
+ * Site of inline function or template used in several translation units
+ * is registered by each of them while linker keeps only one copy of the
+ * record, so section may contain duplicated pointers
+ */
+static std::vector<const AssertionSite *> collectAssertionSites()
+{
+    std::vector<const AssertionSite *> sites;
+#ifdef CPP_ASSERT_HAVE_SITE_SECTION
+    if(__start_cppassert_sites!=nullptr && __stop_cppassert_sites!=nullptr)
+    {
+        sites.assign(__start_cppassert_sites, __stop_cppassert_sites);
+    }
+#endif
+    std::sort(sites.begin(), sites.end(), isSiteLess);
+    sites.erase(std::unique(sites.begin(), sites.end()), sites.end());
+    return sites;
+}
+
+const std::vector<const AssertionSite *> &getAssertionSites()
+{
+    static const std::vector<const AssertionSite *> sites
+        = collectAssertionSites();
+    return sites;
+}
+
+/*
+ * __FILE__ may contain full or relative path, so file name matches if
+ * it's equal to trailing path components of site file name
+ */
+static bool isFileNameMatching(const char *siteFile, const char *file)
+{
+    const std::size_t siteFileLength = std::strlen(siteFile);
+    const std::size_t fileLength = std::strlen(file);
+    if(fileLength>siteFileLength)
+    {
+        return false;
+    }
+    const char *suffix = siteFile+(siteFileLength-fileLength);
+    if(std::strcmp(suffix, file)!=0)
+    {
+        return false;
+    }
+    return (suffix==siteFile || suffix[-1]=='/' || suffix[-1]=='\\');
+}
+
+static bool isGlobMatching(const char *text, const char *glob)
+{
+    const char *starGlob = nullptr;
+    const char *starText = nullptr;
+    while((*text)!='\0')
+    {
+        if((*glob)=='*')
+        {
+            starGlob = ++glob;
+            starText = text;
+        }
+        else if((*glob)=='?' || (*glob)==(*text))
+        {
+            ++glob;
+            ++text;
+        }
+        else if(starGlob!=nullptr)
+        {
+            glob = starGlob;
+            text = ++starText;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while((*glob)=='*')
+    {
+        ++glob;
+    }
+    return ((*glob)=='\0');
+}
+
+template<typename Predicate>
+static std::size_t setSitesEnabledIf(Predicate predicate, bool enabled)
+{
+    std::size_t result = 0;
+    for(const AssertionSite *site: getAssertionSites())
+    {
+        if(predicate(site) && setStaticKeysEnabled(site, enabled))
+        {
+            site->setEnabled(enabled);
+            ++result;
+        }
+    }
+    return result;
+}
+
+std::size_t setSiteEnabled(const char *file, std::uint32_t line,
+                           bool enabled)
+{
+    return setSitesEnabledIf([file, line](const AssertionSite *site)
+    {
+        return (site->getLine()==line
+                && isFileNameMatching(site->getFile(), file));
+    }, enabled);
+}
+
+std::size_t setSitesEnabled(const char *fileGlob, bool enabled)
+{
+    return setSitesEnabledIf([fileGlob](const AssertionSite *site)
+    {
+        return isGlobMatching(site->getFile(), fileGlob);
+    }, enabled);
+}
+
+std::size_t setSitesEnabledByHash(std::uint32_t expressionHash, bool enabled)
+{
+    return setSitesEnabledIf([expressionHash](const AssertionSite *site)
+    {
+        return (site->getExpressionHash()==expressionHash);
+    }, enabled);
+}
+
+std::size_t setSitesStackDepth(const char *fileGlob, std::uint8_t depth)
+{
+    std::size_t result = 0;
+    for(const AssertionSite *site: getAssertionSites())
+    {
+        if(isGlobMatching(site->getFile(), fileGlob))
+        {
+            site->setStackDepth(depth);
+            ++result;
+        }
+    }
+    return result;
+}
+
+static void disableSites(const std::string &entry)
+{
+    if(entry.empty())
+    {
+        return;
+    }
+    if(entry[0]=='#')
+    {
+        const std::uint32_t hash = static_cast<std::uint32_t>(
+                    std::strtoul(entry.c_str()+1, nullptr, 16));
+        setSitesEnabledByHash(hash, false);
+        return;
+    }
+    const std::size_t colon = entry.rfind(':');
+    if(colon!=std::string::npos && colon+1<entry.size()
+       && entry.find_first_not_of("0123456789", colon+1)==std::string::npos)
+    {
+        const std::uint32_t line = static_cast<std::uint32_t>(
+                    std::strtoul(entry.c_str()+colon+1, nullptr, 10));
+        setSiteEnabled(entry.substr(0, colon).c_str(), line, false);
+        return;
+    }
+    setSitesEnabled(entry.c_str(), false);
+}
+
+void disableSitesFromEnvironment()
+{
+    const char *variable = std::getenv("CPPASSERT_DISABLE");
+    if(variable==nullptr)
+    {
+        return;
+    }
+    const std::string entries(variable);
+    std::size_t begin = 0;
+    while(begin<=entries.size())
+    {
+        std::size_t end = entries.find(',', begin);
+        if(end==std::string::npos)
+        {
+            end = entries.size();
+        }
+        const std::size_t first = entries.find_first_not_of(" \t", begin);
+        const std::size_t last = entries.find_last_not_of(" \t", end-1);
+        if(first!=std::string::npos && first<end && last!=std::string::npos
+           && last>=first)
+        {
+            disableSites(entries.substr(first, last-first+1));
+        }
+        begin = end+1;
+    }
+}
+
+} //internal
+} //cppassert
@@ -0,0 +1,239 @@
+#include <cppassert/CodeRange.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#   define CPP_ASSERT_HAVE_PERF_MAP 1
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace cppassert
+{
+namespace internal
+{
+
+/**
+ * Interval index of dynamically generated code. Registered ranges and
+ * entries of perf map are kept in arrays sorted by address, so a frame is
+ * found by binary search like in ElfSymbolTable. Perf map is read again,
+ * on lookup of an address that isn't registered, when its size or
+ * modification time changes.
+ */
+class CodeRangeTable
+{
+    CodeRangeTable(const CodeRangeTable &) = delete;
+    CodeRangeTable &operator=(const CodeRangeTable &) = delete;
+public:
+    CodeRangeTable() = default;
+
+    /**
+     * Returns process wide table, it's never destroyed so that frames
+     * can be symbolized also by destructors of static objects
+     * @return  Code range table
+     */
+    static CodeRangeTable &getInstance()
+    {
+        static CodeRangeTable *instance = new CodeRangeTable();
+        return *instance;
+    }
+
+    void add(std::uintptr_t begin, std::uintptr_t end, const char *name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        //ranges don't overlap, so they are sorted also by their end
+        auto first = std::upper_bound(ranges_.begin(), ranges_.end(), begin,
+                                      [](std::uintptr_t address,
+                                         const Range &range)
+                                      {
+                                          return (address<range.end);
+                                      });
+        auto last = first;
+        while(last!=ranges_.end() && last->begin<end)
+        {
+            ++last;
+        }
+        first = ranges_.erase(first, last);
+        Range range;
+        range.begin = begin;
+        range.end = end;
+        range.name = std::make_shared<const std::string>(name ? name : "");
+        ranges_.insert(first, std::move(range));
+    }
+
+    bool remove(std::uintptr_t begin)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto range = findBegin(ranges_, begin);
+        if(range==ranges_.end() || range->begin!=begin)
+        {
+            return false;
+        }
+        ranges_.erase(range);
+        return true;
+    }
+
+    bool find(std::uintptr_t address, CodeRangeSymbol *symbol)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(find(ranges_, address, symbol))
+        {
+            symbol->module = "[jit]";
+            return true;
+        }
+        refreshPerfMap();
+        if(find(perfMap_, address, symbol))
+        {
+            symbol->module = "[perf-map]";
+            return true;
+        }
+        return false;
+    }
+
+    void setPerfMapPath(const char *path)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        perfMapPath_ = path ? path : "";
+        perfMap_.clear();
+        perfMapSize_ = 0;
+        perfMapTime_ = 0;
+    }
+private:
+    struct Range
+    {
+        std::uintptr_t begin;
+        std::uintptr_t end;
+        std::shared_ptr<const std::string> name;
+    };
+
+    /*
+     * Returns the last range that begins at or before address, ranges
+     * of the same address are in order of addition so it's the latest one
+     */
+    static std::vector<Range>::iterator findBegin(std::vector<Range> &ranges,
+                                                  std::uintptr_t address)
+    {
+        auto range = std::upper_bound(ranges.begin(), ranges.end(), address,
+                                      [](std::uintptr_t searched,
+                                         const Range &candidate)
+                                      {
+                                          return (searched<candidate.begin);
+                                      });
+        return (range==ranges.begin()) ? ranges.end() : --range;
+    }
+
+    /*
+     * Return address may point just past the end of function which calls
+     * noreturn function, so the range containing previous byte is searched
+     */
+    static bool find(std::vector<Range> &ranges, std::uintptr_t address,
+                     CodeRangeSymbol *symbol)
+    {
+        auto range = findBegin(ranges, address-1);
+        if(range==ranges.end() || address-1>=range->end)
+        {
+            return false;
+        }
+        symbol->owner = range->name;
+        symbol->name = range->name->c_str();
+        symbol->offset = address-range->begin;
+        return true;
+    }
+
+    /*
+     * Lines of perf map are `<start> <size> <name>` with hexadecimal
+     * start and size
+     */
+    void refreshPerfMap()
+    {
+#ifdef CPP_ASSERT_HAVE_PERF_MAP
+        const std::string path = perfMapPath_.empty()
+                ? "/tmp/perf-"+std::to_string(::getpid())+".map"
+                : perfMapPath_;
+        struct stat status;
+        if(::stat(path.c_str(), &status)!=0)
+        {
+            perfMap_.clear();
+            perfMapSize_ = 0;
+            perfMapTime_ = 0;
+            return;
+        }
+        if(static_cast<std::uint64_t>(status.st_size)==perfMapSize_
+           && static_cast<std::uint64_t>(status.st_mtime)==perfMapTime_)
+        {
+            return;
+        }
+        perfMapSize_ = static_cast<std::uint64_t>(status.st_size);
+        perfMapTime_ = static_cast<std::uint64_t>(status.st_mtime);
+        perfMap_.clear();
+        std::ifstream file(path);
+        std::string line;
+        while(std::getline(file, line))
+        {
+            char *end = nullptr;
+            const unsigned long long begin = std::strtoull(line.c_str(),
+                                                           &end, 16);
+            char *nameBegin = nullptr;
+            const unsigned long long size = std::strtoull(end, &nameBegin, 16);
+            if(end==line.c_str() || nameBegin==end || *nameBegin!=' '
+               || size==0)
+            {
+                continue;
+            }
+            Range range;
+            range.begin = static_cast<std::uintptr_t>(begin);
+            range.end = static_cast<std::uintptr_t>(begin+size);
+            range.name = std::make_shared<const std::string>(nameBegin+1);
+            perfMap_.push_back(std::move(range));
+        }
+        std::stable_sort(perfMap_.begin(), perfMap_.end(),
+                         [](const Range &first, const Range &second)
+                         {
+                             return (first.begin<second.begin);
+                         });
+#endif
+    }
+
+    std::mutex mutex_;
+    std::vector<Range> ranges_;
+    std::vector<Range> perfMap_;
+    std::string perfMapPath_;
+    std::uint64_t perfMapSize_ = 0;
+    std::uint64_t perfMapTime_ = 0;
+};
+
+bool findCodeRange(const void *address, CodeRangeSymbol *symbol)
+{
+    return CodeRangeTable::getInstance().find(
+                reinterpret_cast<std::uintptr_t>(address), symbol);
+}
+
+void setPerfMapPath(const char *path)
+{
+    CodeRangeTable::getInstance().setPerfMapPath(path);
+}
+
+} //internal
+
+void registerCodeRange(const void *begin, const void *end, const char *name)
+{
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(begin);
+    const std::uintptr_t last = reinterpret_cast<std::uintptr_t>(end);
+    if(first<last)
+    {
+        internal::CodeRangeTable::getInstance().add(first, last, name);
+    }
+}
+
+bool unregisterCodeRange(const void *begin)
+{
+    return internal::CodeRangeTable::getInstance().remove(
+                reinterpret_cast<std::uintptr_t>(begin));
+}
+
+} //cppassert
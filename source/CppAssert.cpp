@@ -3,9 +3,11 @@
 #include <cppassert/details/AssertionMessage.hpp>
 #include <cppassert/details/Helpers.hpp>
 #include <cppassert/AssertionFailure.hpp>
+#include <cppassert/MessageSink.hpp>
 #include <cppassert/details/StackTrace.hpp>
 #include <cstdlib>
 #include <cstdio>
+#include <ostream>
 
 namespace cppassert
 {
@@ -17,10 +19,13 @@ namespace internal
 
 void onAssertionFailureDefaultHandler(const AssertionFailure &assertion)
 {
-    const std::string errorAsStr
-        = CppAssert::getInstance()->formatAssertionMessage(assertion);
+    //report is formatted in place, inline buffer of the message is
+    //enough for short ones
+    AssertionMessage report;
+    MessageSink sink(report);
+    CppAssert::getInstance()->formatAssertionMessage(sink, assertion);
 
-    PrintMessageToStdErr(errorAsStr.c_str());
+    PrintMessageToStdErr(report.data(), report.size());
 
 #if defined(WIN32)
     /*
@@ -43,22 +48,85 @@ void onAssertionFailureDefaultHandler(const AssertionFailure &assertion)
 }
 } //internal
 
-std::string DefaultFormatter::formatBoolFailureMessage(const char* expressionText,
+void DefaultFormatter::formatBoolFailureMessage(MessageSink &sink,
+                                    const char* expressionText,
                                     const char* actualPredicateValue,
                                     const char* expectedPredicateValue)
 {
-    AssertionMessage msg;
-    msg << "Assertion failure value of: " << expressionText
+    sink << "Assertion failure value of: " << expressionText
         << "\n  Actual: " << actualPredicateValue;
-    msg << "\nExpected: " << expectedPredicateValue;
-    return msg.str();
+    sink << "\nExpected: " << expectedPredicateValue;
+}
+
+void DefaultFormatter::formatStreamedMessage(MessageSink &sink,
+                                             const AssertionMessage &message)
+{
+    sink<<'\n'<<message;
+}
+
+void DefaultFormatter::formatPredicateFailureMessage(MessageSink &sink,
+                                    const char* predicate,
+                                    const char* value1Text,
+                                    const char* value2Text,
+                                    const AssertionMessage &value1,
+                                    const AssertionMessage &value2)
+{
+    sink << "Assertion failure value of: ( " << value1Text <<' '<<predicate<<' '
+        << value2Text<<" )";
+    sink << "\n  "<<value1Text<<" evaluated to: "<<value1;
+    sink << "\n  "<<value2Text<<" evaluated to: "<<value2;
+}
+
+void DefaultFormatter::formatAssertionMessage(MessageSink &sink,
+                                              const AssertionFailure &assertion)
+{
+    sink<<assertion.getSourceFileName()<<':'<<assertion.getSourceFileLine()
+            <<": "<<assertion.getFunctionName()<<": ";
+    assertion.appendMessage(sink);
+    sink<<'\n';
+    assertion.appendStackTrace(sink);
+    sink<<'\n';
+    assertion.appendRawStackTrace(sink);
+}
+
+void DefaultFormatter::formatStatementFailureMessage(MessageSink &sink,
+                                                     const char *statement)
+{
+    sink<< "Assertion failure: "<<statement;
+}
+
+void DefaultFormatter::formatFrame(MessageSink &sink
+                        , std::uint32_t frameNumber
+                        , const void *address
+                        , const char *symbol )
+{
+    sink.setWidth(4);
+    sink<<frameNumber<<' '
+        <<address<<' '
+        <<symbol<<'\n';
+}
+
+/*
+ * Methods returning std::string format into a new string with methods
+ * appending to a sink
+ */
+std::string DefaultFormatter::formatBoolFailureMessage(const char* expressionText,
+                                    const char* actualPredicateValue,
+                                    const char* expectedPredicateValue)
+{
+    std::string text;
+    MessageSink sink(text);
+    formatBoolFailureMessage(sink, expressionText, actualPredicateValue
+                             , expectedPredicateValue);
+    return text;
 }
 
 std::string DefaultFormatter::formatStreamedMessage(const std::string &message)
 {
-    AssertionMessage msg;
-    msg<<'\n'<<message;
-    return msg.str();
+    std::string text;
+    MessageSink sink(text);
+    sink<<'\n'<<message;
+    return text;
 }
 
 std::string DefaultFormatter::formatPredicateFailureMessage(const char* predicate,
@@ -67,40 +135,41 @@ std::string DefaultFormatter::formatPredicateFailureMessage(const char* predicat
                                     const std::string &value1,
                                     const std::string &value2)
 {
-    AssertionMessage msg;
-    msg << "Assertion failure value of: ( " << value1Text <<' '<<predicate<<' '
-        << value2Text<<" )";
-    msg << "\n  "<<value1Text<<" evaluated to: "<<value1;
-    msg << "\n  "<<value2Text<<" evaluated to: "<<value2;
-    return msg.str();
+    AssertionMessage value1Message;
+    AssertionMessage value2Message;
+    value1Message<<value1;
+    value2Message<<value2;
+    std::string text;
+    MessageSink sink(text);
+    formatPredicateFailureMessage(sink, predicate, value1Text, value2Text
+                                  , value1Message, value2Message);
+    return text;
 }
 
 std::string DefaultFormatter::formatAssertionMessage(const AssertionFailure &assertion)
 {
-    AssertionMessage error;
-    error<<assertion.getSourceFileName()<<':'<<assertion.getSourceFileLine()
-            <<": "<<assertion.getFunctionName()<<": ";
-    error<<assertion.getMessage()<<std::endl;
-    error<<assertion.getStackTrace()<<std::endl;
-    return error.str();
+    std::string text;
+    MessageSink sink(text);
+    formatAssertionMessage(sink, assertion);
+    return text;
 }
 
 std::string DefaultFormatter::formatStatementFailureMessage(const char *statement)
 {
-    AssertionMessage msg;
-    msg<< "Assertion failure: "<<statement;
-    return msg.str();
+    std::string text;
+    MessageSink sink(text);
+    formatStatementFailureMessage(sink, statement);
+    return text;
 }
 
 std::string DefaultFormatter::formatFrame(std::uint32_t frameNumber
                         , const void *address
                         , const char *symbol )
 {
-    AssertionMessage msg;
-    msg<<std::setw(4)<<frameNumber<<' '
-        <<address<<' '
-        <<symbol<<std::endl;
-    return msg.str();
+    std::string text;
+    MessageSink sink(text);
+    formatFrame(sink, frameNumber, address, symbol);
+    return text;
 }
 
 
@@ -0,0 +1,154 @@
+#include <cppassert/MessageSink.hpp>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace cppassert
+{
+
+MessageSink::MessageSink(char *buffer, std::size_t capacity)
+    :kind_(Kind::Buffer), buffer_(buffer), capacity_(capacity)
+{
+    if(capacity_>0)
+    {
+        buffer_[0] = '\0';
+    }
+}
+
+MessageSink::MessageSink(std::string &output)
+    :kind_(Kind::String), string_(&output)
+{
+}
+
+MessageSink::MessageSink(internal::AssertionMessage &output)
+    :kind_(Kind::Message), message_(&output)
+{
+}
+
+void MessageSink::append(const char *text, std::size_t length)
+{
+    switch(kind_)
+    {
+    case Kind::Buffer:
+        //the last character is kept for null terminator
+        if(size_+length>=capacity_)
+        {
+            truncated_ = truncated_ || (length>0);
+            length = (capacity_>size_) ? capacity_-size_-1 : 0;
+        }
+        if(length>0)
+        {
+            std::memcpy(buffer_+size_, text, length);
+            buffer_[size_+length] = '\0';
+        }
+        break;
+    case Kind::String:
+        string_->append(text, length);
+        break;
+    case Kind::Message:
+        message_->append(text, length);
+        break;
+    }
+    size_ += length;
+}
+
+MessageSink &MessageSink::operator<<(const char *text)
+{
+    if(text==nullptr)
+    {
+        return (*this)<<nullptr;
+    }
+    append(text, std::strlen(text));
+    return (*this);
+}
+
+MessageSink &MessageSink::operator<<(const std::string &text)
+{
+    append(text.data(), text.size());
+    return (*this);
+}
+
+MessageSink &MessageSink::operator<<(const internal::AssertionMessage &message)
+{
+    append(message.data(), message.size());
+    return (*this);
+}
+
+MessageSink &MessageSink::operator<<(char character)
+{
+    append(&character, 1);
+    return (*this);
+}
+
+MessageSink &MessageSink::operator<<(int value)
+{
+    return (*this)<<static_cast<long long>(value);
+}
+
+MessageSink &MessageSink::operator<<(unsigned int value)
+{
+    return (*this)<<static_cast<unsigned long long>(value);
+}
+
+MessageSink &MessageSink::operator<<(long value)
+{
+    return (*this)<<static_cast<long long>(value);
+}
+
+MessageSink &MessageSink::operator<<(unsigned long value)
+{
+    return (*this)<<static_cast<unsigned long long>(value);
+}
+
+MessageSink &MessageSink::operator<<(long long value)
+{
+    print("%*lld", static_cast<int>(width_), value);
+    return (*this);
+}
+
+MessageSink &MessageSink::operator<<(unsigned long long value)
+{
+    print("%*llu", static_cast<int>(width_), value);
+    return (*this);
+}
+
+MessageSink &MessageSink::operator<<(const void *pointer)
+{
+    if(pointer==nullptr)
+    {
+        return (*this)<<nullptr;
+    }
+    print("0x%0*llx", static_cast<int>(sizeof(const void *)*2),
+          static_cast<unsigned long long>(
+              reinterpret_cast<std::uintptr_t>(pointer)));
+    return (*this);
+}
+
+MessageSink &MessageSink::operator<<(std::nullptr_t)
+{
+    append("(null)", 6);
+    return (*this);
+}
+
+/*
+ * Only numbers are printed, they fit into a small buffer unless width
+ * is large
+ */
+void MessageSink::print(const char *format, ...)
+{
+    width_ = 0;
+    char text[64];
+    va_list arguments;
+    va_start(arguments, format);
+    const int length = std::vsnprintf(text, sizeof(text), format, arguments);
+    va_end(arguments);
+    if(length>0)
+    {
+        append(text, std::min(static_cast<std::size_t>(length),
+                              sizeof(text)-1));
+    }
+}
+
+} //cppassert
@@ -0,0 +1,344 @@
+#include <cppassert/TraceId.hpp>
+#include <cppassert/CppAssert.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace cppassert
+{
+namespace internal
+{
+
+/**
+ * Hash-consing table of return address vectors. Every distinct vector is
+ * appended once to an arena of fixed size chunks that are never released,
+ * its id is the position of the record in the arena. Ids are found by
+ * hash in an open addressing table of ids, lookup reads the table and the
+ * records without locking. Insertion takes a lock, when the table gets
+ * half full it's replaced by a table of double capacity, previous tables
+ * are kept for readers that may still probe them.
+ */
+class TraceTable
+{
+    TraceTable(const TraceTable &) = delete;
+    TraceTable &operator=(const TraceTable &) = delete;
+public:
+    TraceTable()
+    {
+        for(auto &chunk: chunks_)
+        {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+        tables_.emplace_back(new HashTable(InitialCapacity));
+        table_.store(tables_.back().get(), std::memory_order_release);
+    }
+
+    /**
+     * Returns process wide table, it's never destroyed so that traces
+     * can be captured and printed also by destructors of static objects
+     * @return  Trace table
+     */
+    static TraceTable &getInstance()
+    {
+        static TraceTable *instance = new TraceTable();
+        return *instance;
+    }
+
+    /**
+     * Returns id of return addresses, addresses are appended to the table
+     * if they were not interned yet
+     *
+     * @param   addresses   Return addresses
+     * @param   size        Number of addresses
+     * @return  Trace id or TraceId::Empty if table is full
+     */
+    TraceId intern(void *const *addresses, std::size_t size)
+    {
+        if(size==0)
+        {
+            return TraceId::Empty;
+        }
+        const std::uint32_t hash = getHash(addresses, size);
+        std::uint32_t id = find(table_.load(std::memory_order_acquire)
+                                , addresses, size, hash);
+        if(id!=0)
+        {
+            return static_cast<TraceId>(id);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        HashTable *table = table_.load(std::memory_order_relaxed);
+        id = find(table, addresses, size, hash);
+        if(id!=0)
+        {
+            return static_cast<TraceId>(id);
+        }
+        id = append(addresses, size, hash);
+        if(id==0)
+        {
+            return TraceId::Empty;
+        }
+        if((count_+1)*2>table->mask+1)
+        {
+            table = grow(table);
+        }
+        insert(table, id, hash);
+        ++count_;
+        return static_cast<TraceId>(id);
+    }
+
+    /**
+     * Returns return addresses of interned trace
+     *
+     * @param[in]   id      Trace id
+     * @param[out]  size    Number of addresses
+     * @return  Addresses or nullptr for TraceId::Empty
+     */
+    const void *const *getAddresses(TraceId id, std::size_t *size) const
+    {
+        const std::uintptr_t *record
+                = getRecord(static_cast<std::uint32_t>(id));
+        if(record==nullptr)
+        {
+            *size = 0;
+            return nullptr;
+        }
+        *size = static_cast<std::size_t>(record[SizeWord]);
+        return reinterpret_cast<const void *const *>(record+HeaderWords);
+    }
+
+    /**
+     * Returns number of interned traces
+     * @return  Number of traces
+     */
+    std::size_t getCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    /*
+     * Id is chunk number in upper bits and word offset of record in lower
+     * bits, word 0 of the first chunk is not used so that id 0 is empty
+     */
+    enum : std::uint32_t
+    {
+        ChunkBits = 18,
+        ChunkWords = 1u<<ChunkBits,
+        MaxChunks = 1u<<(32-ChunkBits)
+    };
+
+    /*
+     * Record is size and hash followed by return addresses
+     */
+    enum : std::size_t
+    {
+        SizeWord = 0,
+        HashWord = 1,
+        HeaderWords = 2
+    };
+
+    enum : std::size_t
+    {
+        InitialCapacity = 4096
+    };
+
+    struct HashTable
+    {
+        explicit HashTable(std::size_t capacity)
+            :mask(capacity-1)
+            , slots(new std::atomic<std::uint32_t>[capacity])
+        {
+            for(std::size_t i=0; i<capacity; ++i)
+            {
+                slots[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> slots;
+    };
+
+    static std::uint32_t getHash(void *const *addresses, std::size_t size)
+    {
+        std::uint64_t hash = size;
+        for(std::size_t i=0; i<size; ++i)
+        {
+            hash ^= reinterpret_cast<std::uintptr_t>(addresses[i]);
+            hash *= 0x9e3779b97f4a7c15ull;
+            hash ^= hash>>29;
+        }
+        return static_cast<std::uint32_t>(hash^(hash>>32));
+    }
+
+    const std::uintptr_t *getRecord(std::uint32_t id) const
+    {
+        if(id==0)
+        {
+            return nullptr;
+        }
+        const std::uintptr_t *chunk
+                = chunks_[id>>ChunkBits].load(std::memory_order_acquire);
+        return chunk ? chunk+(id&(ChunkWords-1)) : nullptr;
+    }
+
+    std::uint32_t find(const HashTable *table, void *const *addresses
+                       , std::size_t size, std::uint32_t hash) const
+    {
+        std::size_t slot = hash&table->mask;
+        for(;; slot = (slot+1)&table->mask)
+        {
+            const std::uint32_t id
+                    = table->slots[slot].load(std::memory_order_acquire);
+            if(id==0)
+            {
+                return 0;
+            }
+            const std::uintptr_t *record = getRecord(id);
+            if(record[HashWord]==hash && record[SizeWord]==size
+               && isEqual(record+HeaderWords, addresses, size))
+            {
+                return id;
+            }
+        }
+    }
+
+    static bool isEqual(const std::uintptr_t *words, void *const *addresses
+                        , std::size_t size)
+    {
+        for(std::size_t i=0; i<size; ++i)
+        {
+            if(words[i]!=reinterpret_cast<std::uintptr_t>(addresses[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     * Called with lock held, record is written before its chunk and id
+     * are published
+     */
+    std::uint32_t append(void *const *addresses, std::size_t size
+                         , std::uint32_t hash)
+    {
+        const std::size_t words = HeaderWords+size;
+        if(position_+words>ChunkWords)
+        {
+            ++chunk_;
+            position_ = 0;
+        }
+        if(chunk_>=MaxChunks)
+        {
+            return 0;
+        }
+        std::uintptr_t *chunk
+                = chunks_[chunk_].load(std::memory_order_relaxed);
+        if(chunk==nullptr)
+        {
+            chunk = new (std::nothrow) std::uintptr_t[ChunkWords];
+            if(chunk==nullptr)
+            {
+                return 0;
+            }
+        }
+        std::uintptr_t *record = chunk+position_;
+        record[SizeWord] = size;
+        record[HashWord] = hash;
+        for(std::size_t i=0; i<size; ++i)
+        {
+            record[HeaderWords+i] = reinterpret_cast<std::uintptr_t>(
+                                        addresses[i]);
+        }
+        chunks_[chunk_].store(chunk, std::memory_order_release);
+        const std::uint32_t id = static_cast<std::uint32_t>(
+                                    (chunk_<<ChunkBits)|position_);
+        position_ += words;
+        return id;
+    }
+
+    static void insert(HashTable *table, std::uint32_t id, std::uint32_t hash)
+    {
+        std::size_t slot = hash&table->mask;
+        while(table->slots[slot].load(std::memory_order_relaxed)!=0)
+        {
+            slot = (slot+1)&table->mask;
+        }
+        table->slots[slot].store(id, std::memory_order_release);
+    }
+
+    /*
+     * Called with lock held, previous table stays readable
+     */
+    HashTable *grow(const HashTable *table)
+    {
+        std::unique_ptr<HashTable> grown(new HashTable((table->mask+1)*2));
+        for(std::size_t i=0; i<=table->mask; ++i)
+        {
+            const std::uint32_t id
+                    = table->slots[i].load(std::memory_order_relaxed);
+            if(id!=0)
+            {
+                insert(grown.get(), id
+                       , static_cast<std::uint32_t>(getRecord(id)[HashWord]));
+            }
+        }
+        tables_.push_back(std::move(grown));
+        table_.store(tables_.back().get(), std::memory_order_release);
+        return tables_.back().get();
+    }
+
+    std::atomic<std::uintptr_t *> chunks_[MaxChunks];
+    std::atomic<HashTable *> table_;
+    std::vector<std::unique_ptr<HashTable>> tables_;
+    std::mutex mutex_;
+    std::size_t count_ = 0;
+    std::uint32_t chunk_ = 0;
+    std::size_t position_ = 1;
+};
+
+} //internal
+
+TraceId capture(std::size_t framesToSkip)
+{
+    void *addresses[internal::StackTrace::MaxDepth];
+    const std::size_t size = internal::StackTrace::getReturnAddresses(
+                addresses, internal::getMaxStackDepth()
+                , internal::getLibraryFrames(1)+framesToSkip);
+    return internal::TraceTable::getInstance().intern(addresses, size);
+}
+
+std::size_t getTraceSize(TraceId id)
+{
+    std::size_t size = 0;
+    internal::TraceTable::getInstance().getAddresses(id, &size);
+    return size;
+}
+
+internal::StackTrace getStackTrace(TraceId id)
+{
+    std::size_t size = 0;
+    const void *const *addresses
+            = internal::TraceTable::getInstance().getAddresses(id, &size);
+    return internal::StackTrace::fromReturnAddresses(addresses, size);
+}
+
+std::string toString(TraceId id)
+{
+    const internal::StackTrace frames = getStackTrace(id);
+    if(frames.size()==0)
+    {
+        return std::string();
+    }
+    return CppAssert::getInstance()->formatStackTrace(frames);
+}
+
+std::size_t getTraceCount()
+{
+    return internal::TraceTable::getInstance().getCount();
+}
+
+} //cppassert
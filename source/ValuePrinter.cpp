@@ -0,0 +1,258 @@
+#include <cppassert/ValuePrinter.hpp>
+#include <cfloat>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace cppassert
+{
+namespace internal
+{
+namespace
+{
+const char DECIMAL_DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+const char HEXADECIMAL_DIGITS[] = "0123456789abcdef";
+
+/*
+ * Writes digits backwards ending at end, two digits at a time, returns
+ * beginning of the number
+ */
+char *formatDecimal(char *end, unsigned long long value)
+{
+    while(value>=100)
+    {
+        const std::size_t index = static_cast<std::size_t>(value%100)*2;
+        value /= 100;
+        *--end = DECIMAL_DIGIT_PAIRS[index+1];
+        *--end = DECIMAL_DIGIT_PAIRS[index];
+    }
+    if(value>=10)
+    {
+        const std::size_t index = static_cast<std::size_t>(value)*2;
+        *--end = DECIMAL_DIGIT_PAIRS[index+1];
+        *--end = DECIMAL_DIGIT_PAIRS[index];
+    }
+    else
+    {
+        *--end = static_cast<char>('0'+value);
+    }
+    return end;
+}
+
+char *formatHexadecimal(char *end, unsigned long long value)
+{
+    do
+    {
+        *--end = HEXADECIMAL_DIGITS[value & 0xf];
+        value >>= 4;
+    } while(value!=0);
+    return end;
+}
+
+float parse(const char *text, float *)
+{
+    return std::strtof(text, nullptr);
+}
+
+double parse(const char *text, double *)
+{
+    return std::strtod(text, nullptr);
+}
+
+long double parse(const char *text, long double *)
+{
+    return std::strtold(text, nullptr);
+}
+
+int format(char *buffer, std::size_t size, int precision, float value)
+{
+    return std::snprintf(buffer, size, "%.*g", precision,
+                         static_cast<double>(value));
+}
+
+int format(char *buffer, std::size_t size, int precision, double value)
+{
+    return std::snprintf(buffer, size, "%.*g", precision, value);
+}
+
+int format(char *buffer, std::size_t size, int precision, long double value)
+{
+    return std::snprintf(buffer, size, "%.*Lg", precision, value);
+}
+
+/*
+ * Every decimal number of at most digits10 significant digits is
+ * restored from the nearest floating point value, so if the value is
+ * restored from its digits10 representation, that representation
+ * with trailing zeros removed by %g is the shortest one. Otherwise
+ * precision is increased up to max_digits10 which always restores
+ * the value.
+ */
+template<typename T>
+void printShortest(AssertionMessage &message, T value, int digits10,
+                   int maxDigits10)
+{
+    if(std::isnan(value))
+    {
+        if(std::signbit(value))
+        {
+            message.append("-nan", 4);
+        }
+        else
+        {
+            message.append("nan", 3);
+        }
+        return;
+    }
+    char buffer[64];
+    int length = 0;
+    for(int precision = digits10; precision<=maxDigits10; ++precision)
+    {
+        length = format(buffer, sizeof(buffer), precision, value);
+        if(length<0 || static_cast<std::size_t>(length)>=sizeof(buffer))
+        {
+            return;
+        }
+        if(parse(buffer, static_cast<T *>(nullptr))==value)
+        {
+            break;
+        }
+    }
+    //number was parsed with current locale, it's printed with '.'
+    const char decimalPoint = *std::localeconv()->decimal_point;
+    if(decimalPoint!='.')
+    {
+        for(int i = 0; i<length; ++i)
+        {
+            if(buffer[i]==decimalPoint)
+            {
+                buffer[i] = '.';
+            }
+        }
+    }
+    message.append(buffer, static_cast<std::size_t>(length));
+}
+}
+
+void printInteger(AssertionMessage &message, long long value)
+{
+    char buffer[24];
+    char *end = buffer+sizeof(buffer);
+    const unsigned long long magnitude = (value<0)
+            ? 0ULL-static_cast<unsigned long long>(value)
+            : static_cast<unsigned long long>(value);
+    char *begin = formatDecimal(end, magnitude);
+    if(value<0)
+    {
+        *--begin = '-';
+    }
+    message.append(begin, static_cast<std::size_t>(end-begin));
+}
+
+void printInteger(AssertionMessage &message, unsigned long long value)
+{
+    char buffer[24];
+    char *end = buffer+sizeof(buffer);
+    char *begin = formatDecimal(end, value);
+    message.append(begin, static_cast<std::size_t>(end-begin));
+}
+
+void printFloatingPoint(AssertionMessage &message, float value)
+{
+    printShortest(message, value, FLT_DIG, FLT_DIG+3);
+}
+
+void printFloatingPoint(AssertionMessage &message, double value)
+{
+    printShortest(message, value, DBL_DIG, DBL_DIG+2);
+}
+
+void printFloatingPoint(AssertionMessage &message, long double value)
+{
+    printShortest(message, value, LDBL_DIG, LDBL_DIG+3);
+}
+
+void printCharacter(AssertionMessage &message, char character, int code)
+{
+    char buffer[8];
+    std::size_t length = 0;
+    buffer[length++] = '\'';
+    const unsigned char byte = static_cast<unsigned char>(character);
+    if(character=='\'' || character=='\\')
+    {
+        buffer[length++] = '\\';
+        buffer[length++] = character;
+    }
+    else if(byte>=0x20 && byte<0x7f)
+    {
+        buffer[length++] = character;
+    }
+    else
+    {
+        buffer[length++] = '\\';
+        buffer[length++] = 'x';
+        buffer[length++] = HEXADECIMAL_DIGITS[byte>>4];
+        buffer[length++] = HEXADECIMAL_DIGITS[byte & 0xf];
+    }
+    buffer[length++] = '\'';
+    buffer[length++] = ' ';
+    message.append(buffer, length);
+    message.append("(", 1);
+    printInteger(message, static_cast<long long>(code));
+    message.append(")", 1);
+}
+
+void printPointer(AssertionMessage &message, const volatile void *pointer)
+{
+    char buffer[2+sizeof(void *)*2];
+    char *end = buffer+sizeof(buffer);
+    char *begin = formatHexadecimal(end, static_cast<unsigned long long>(
+                        reinterpret_cast<std::uintptr_t>(pointer)));
+    *--begin = 'x';
+    *--begin = '0';
+    message.append(begin, static_cast<std::size_t>(end-begin));
+}
+
+/*
+ * Large objects are truncated, only the beginning is printed
+ */
+void printObjectBytes(AssertionMessage &message, const void *object,
+                      std::size_t size)
+{
+    static const std::size_t MAX_BYTES = 64;
+    printInteger(message, static_cast<unsigned long long>(size));
+    message.append("-byte object <", 14);
+    const unsigned char *bytes = static_cast<const unsigned char *>(object);
+    for(std::size_t i = 0; i<size && i<MAX_BYTES; ++i)
+    {
+        const char byte[] =
+        {
+            ' ',
+            HEXADECIMAL_DIGITS[bytes[i]>>4],
+            HEXADECIMAL_DIGITS[bytes[i] & 0xf]
+        };
+        //first byte isn't preceded by a space
+        message.append(byte+(i==0 ? 1 : 0), (i==0) ? 2 : 3);
+    }
+    if(size>MAX_BYTES)
+    {
+        message.append(" ...", 4);
+    }
+    message.append(">", 1);
+}
+
+} //internal
+} //cppassert
@@ -1,27 +1,659 @@
 #include "cppassert/details/AssertionMessage.hpp"
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <ostream>
+#include <streambuf>
+#include <string>
 
 namespace cppassert
 {
 namespace internal
 {
 
+/**
+ * Stream buffer appending characters to AssertionMessage, it's created
+ * only when a type without library provided formatting is streamed
+ */
+class AssertionMessage::StreamAdapter : public std::streambuf
+{
+public:
+    explicit StreamAdapter(AssertionMessage *message)
+        :message_(message)
+        ,stream_(this)
+    {
+    }
+
+    std::ostream &getStream()
+    {
+        return stream_;
+    }
+
+    void setMessage(AssertionMessage *message)
+    {
+        message_ = message;
+    }
+
+protected:
+    int_type overflow(int_type character) override
+    {
+        if(!traits_type::eq_int_type(character, traits_type::eof()))
+        {
+            const char value = traits_type::to_char_type(character);
+            message_->append(&value, 1);
+        }
+        return traits_type::not_eof(character);
+    }
+
+    std::streamsize xsputn(const char *text, std::streamsize length) override
+    {
+        message_->append(text, static_cast<std::size_t>(length));
+        return length;
+    }
+
+private:
+    AssertionMessage *message_;
+    std::ostream stream_;
+};
+
+namespace
+{
+using Flags = std::ios_base::fmtflags;
+
+const struct
+{
+    AssertionMessage::StdIosBaseManipulatorType manipulator;
+    Flags flags;
+    Flags mask;
+} IOS_BASE_MANIPULATORS[] =
+{
+    {std::dec, std::ios_base::dec, std::ios_base::basefield},
+    {std::hex, std::ios_base::hex, std::ios_base::basefield},
+    {std::oct, std::ios_base::oct, std::ios_base::basefield},
+    {std::fixed, std::ios_base::fixed, std::ios_base::floatfield},
+    {std::scientific, std::ios_base::scientific, std::ios_base::floatfield},
+    {std::left, std::ios_base::left, std::ios_base::adjustfield},
+    {std::right, std::ios_base::right, std::ios_base::adjustfield},
+    {std::internal, std::ios_base::internal, std::ios_base::adjustfield},
+    {std::showbase, std::ios_base::showbase, std::ios_base::showbase},
+    {std::noshowbase, Flags(), std::ios_base::showbase},
+    {std::showpos, std::ios_base::showpos, std::ios_base::showpos},
+    {std::noshowpos, Flags(), std::ios_base::showpos},
+    {std::showpoint, std::ios_base::showpoint, std::ios_base::showpoint},
+    {std::noshowpoint, Flags(), std::ios_base::showpoint},
+    {std::uppercase, std::ios_base::uppercase, std::ios_base::uppercase},
+    {std::nouppercase, Flags(), std::ios_base::uppercase},
+    {std::boolalpha, std::ios_base::boolalpha, std::ios_base::boolalpha},
+    {std::noboolalpha, Flags(), std::ios_base::boolalpha}
+};
+
+inline Flags toFlags(unsigned long flags)
+{
+    return static_cast<Flags>(flags);
+}
+
+inline unsigned long fromFlags(Flags flags)
+{
+    return static_cast<unsigned long>(flags);
+}
+
+inline bool isSet(unsigned long flags, Flags flag)
+{
+    return (toFlags(flags) & flag)!=Flags();
+}
+
+/*
+ * Builds printf format of floating point number respecting flags of
+ * std::ios_base, the same way std::num_put does it
+ */
+void getFloatingPointFormat(char *format, unsigned long flags,
+                            const char *lengthModifier)
+{
+    *format++ = '%';
+    if(isSet(flags, std::ios_base::showpos))
+    {
+        *format++ = '+';
+    }
+    if(isSet(flags, std::ios_base::showpoint))
+    {
+        *format++ = '#';
+    }
+    const Flags floatField = toFlags(flags) & std::ios_base::floatfield;
+    const bool hexFloat = (floatField==(std::ios_base::fixed
+                                        | std::ios_base::scientific));
+    if(!hexFloat)
+    {
+        *format++ = '.';
+        *format++ = '*';
+    }
+    while(*lengthModifier!='\0')
+    {
+        *format++ = *lengthModifier++;
+    }
+    char conversion = 'g';
+    if(hexFloat)
+    {
+        conversion = 'a';
+    }
+    else if(floatField==std::ios_base::fixed)
+    {
+        conversion = 'f';
+    }
+    else if(floatField==std::ios_base::scientific)
+    {
+        conversion = 'e';
+    }
+    if(isSet(flags, std::ios_base::uppercase))
+    {
+        conversion = static_cast<char>(conversion-'a'+'A');
+    }
+    *format++ = conversion;
+    *format = '\0';
+}
+
+/*
+ * Number of leading characters of formatted number which are placed
+ * before padding when std::ios_base::internal adjustment is used: sign
+ * and hexadecimal base prefix
+ */
+std::size_t getInternalPosition(const char *text, std::size_t length)
+{
+    std::size_t position = 0;
+    if(position<length && (text[position]=='+' || text[position]=='-'))
+    {
+        ++position;
+    }
+    if(position+1<length && text[position]=='0'
+       && (text[position+1]=='x' || text[position+1]=='X'))
+    {
+        position += 2;
+    }
+    return position;
+}
+}
+
 AssertionMessage::AssertionMessage()
+    :data_(inline_)
+    ,flags_(fromFlags(std::ios_base::dec | std::ios_base::skipws))
 {
 }
 
-std::string AssertionMessage::str() const
+AssertionMessage::AssertionMessage(AssertionMessage &&other)
+    :data_(inline_)
+{
+    moveFrom(other);
+}
+
+AssertionMessage &AssertionMessage::operator=(AssertionMessage &&other)
 {
-    if(stream_)
+    if(this!=&other)
     {
-        return stream_->str();
+        release();
+        moveFrom(other);
     }
-    return std::string();
+    return (*this);
 }
 
+AssertionMessage::~AssertionMessage()
+{
+    release();
+}
 
-} //internal
-} //asrt
+void AssertionMessage::release()
+{
+    if(data_!=inline_)
+    {
+        std::free(data_);
+        data_ = inline_;
+    }
+    delete stream_;
+    stream_ = nullptr;
+    size_ = 0;
+    capacity_ = InlineCapacity;
+}
 
+void AssertionMessage::moveFrom(AssertionMessage &other)
+{
+    if(other.data_==other.inline_)
+    {
+        std::memcpy(inline_, other.inline_, other.size_);
+        data_ = inline_;
+    }
+    else
+    {
+        data_ = other.data_;
+    }
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    flags_ = other.flags_;
+    width_ = other.width_;
+    precision_ = other.precision_;
+    fill_ = other.fill_;
+    stream_ = other.stream_;
+    if(stream_!=nullptr)
+    {
+        stream_->setMessage(this);
+    }
+    other.data_ = other.inline_;
+    other.size_ = 0;
+    other.capacity_ = InlineCapacity;
+    other.stream_ = nullptr;
+}
 
+bool AssertionMessage::reserve(std::size_t length)
+{
+    if(capacity_-size_>=length)
+    {
+        return true;
+    }
+    std::size_t capacity = capacity_*2;
+    if(capacity-size_<length)
+    {
+        capacity = size_+length;
+    }
+    char *data = nullptr;
+    if(data_==inline_)
+    {
+        data = static_cast<char *>(std::malloc(capacity));
+        if(data!=nullptr)
+        {
+            std::memcpy(data, inline_, size_);
+        }
+    }
+    else
+    {
+        data = static_cast<char *>(std::realloc(data_, capacity));
+    }
+    if(data==nullptr)
+    {
+        return false;
+    }
+    data_ = data;
+    capacity_ = capacity;
+    return true;
+}
 
+void AssertionMessage::append(const char *text, std::size_t length)
+{
+    if(!reserve(length))
+    {
+        length = capacity_-size_;
+    }
+    std::memcpy(data_+size_, text, length);
+    size_ += length;
+}
+
+/*
+ * Formats directly into the buffer, one character is reserved for null
+ * terminator written by vsnprintf
+ */
+void AssertionMessage::print(const char *format, ...)
+{
+    std::va_list arguments;
+    va_start(arguments, format);
+    std::va_list retryArguments;
+    va_copy(retryArguments, arguments);
+    reserve(1);
+    std::size_t available = capacity_-size_;
+    int length = std::vsnprintf(data_+size_, available, format, arguments);
+    if(length>=0 && static_cast<std::size_t>(length)>=available
+       && reserve(static_cast<std::size_t>(length)+1))
+    {
+        available = capacity_-size_;
+        length = std::vsnprintf(data_+size_, available, format,
+                                retryArguments);
+    }
+    va_end(retryArguments);
+    va_end(arguments);
+    if(length<=0 || available==0)
+    {
+        return;
+    }
+    //output is truncated when buffer can't grow
+    if(static_cast<std::size_t>(length)>=available)
+    {
+        length = static_cast<int>(available-1);
+    }
+    size_ += static_cast<std::size_t>(length);
+}
+
+/*
+ * Pads text appended since start to the width set by std::setw, width is
+ * reset afterwards as std::ostream does it
+ */
+void AssertionMessage::pad(std::size_t start, std::size_t internal)
+{
+    const std::size_t length = size_-start;
+    const std::size_t width = (width_>0) ? static_cast<std::size_t>(width_) : 0;
+    width_ = 0;
+    if(width<=length || !reserve(width-length))
+    {
+        return;
+    }
+    const std::size_t padding = width-length;
+    const Flags adjust = toFlags(flags_) & std::ios_base::adjustfield;
+    std::size_t position = start;
+    if(adjust==std::ios_base::left)
+    {
+        position = size_;
+    }
+    else if(adjust==std::ios_base::internal)
+    {
+        position = start+internal;
+    }
+    std::memmove(data_+position+padding, data_+position, size_-position);
+    std::memset(data_+position, fill_, padding);
+    size_ += padding;
+}
+
+void AssertionMessage::appendText(const char *text, std::size_t length)
+{
+    const std::size_t start = size_;
+    append(text, length);
+    pad(start, 0);
+}
 
+void AssertionMessage::appendCharacter(char character)
+{
+    appendText(&character, 1);
+}
+
+/*
+ * Signed values are displayed as unsigned of the same size in octal and
+ * hexadecimal base
+ */
+void AssertionMessage::appendSigned(long long value, unsigned long long bits)
+{
+    const Flags base = toFlags(flags_) & std::ios_base::basefield;
+    if(base==std::ios_base::oct || base==std::ios_base::hex)
+    {
+        appendUnsigned(bits);
+        return;
+    }
+    const std::size_t start = size_;
+    print(isSet(flags_, std::ios_base::showpos) ? "%+lld" : "%lld", value);
+    pad(start, getInternalPosition(data_+start, size_-start));
+}
+
+void AssertionMessage::appendUnsigned(unsigned long long value)
+{
+    const Flags base = toFlags(flags_) & std::ios_base::basefield;
+    const bool showBase = isSet(flags_, std::ios_base::showbase);
+    const char *format = "%llu";
+    if(base==std::ios_base::oct)
+    {
+        format = showBase ? "%#llo" : "%llo";
+    }
+    else if(base==std::ios_base::hex)
+    {
+        if(isSet(flags_, std::ios_base::uppercase))
+        {
+            format = showBase ? "%#llX" : "%llX";
+        }
+        else
+        {
+            format = showBase ? "%#llx" : "%llx";
+        }
+    }
+    const std::size_t start = size_;
+    print(format, value);
+    pad(start, getInternalPosition(data_+start, size_-start));
+}
+
+void AssertionMessage::appendFloatingPoint(double value)
+{
+    char format[16];
+    getFloatingPointFormat(format, flags_, "");
+    const std::size_t start = size_;
+    if(std::strchr(format, '*')==nullptr)
+    {
+        print(format, value);
+    }
+    else
+    {
+        print(format, static_cast<int>(precision_), value);
+    }
+    pad(start, getInternalPosition(data_+start, size_-start));
+}
+
+void AssertionMessage::appendFloatingPoint(long double value)
+{
+    char format[16];
+    getFloatingPointFormat(format, flags_, "L");
+    const std::size_t start = size_;
+    if(std::strchr(format, '*')==nullptr)
+    {
+        print(format, value);
+    }
+    else
+    {
+        print(format, static_cast<int>(precision_), value);
+    }
+    pad(start, getInternalPosition(data_+start, size_-start));
+}
+
+AssertionMessage &AssertionMessage::operator<<(char value)
+{
+    appendCharacter(value);
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(signed char value)
+{
+    appendCharacter(static_cast<char>(value));
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(unsigned char value)
+{
+    appendCharacter(static_cast<char>(value));
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(short value)
+{
+    appendSigned(value, static_cast<unsigned short>(value));
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(unsigned short value)
+{
+    appendUnsigned(value);
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(int value)
+{
+    appendSigned(value, static_cast<unsigned int>(value));
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(unsigned int value)
+{
+    appendUnsigned(value);
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(long value)
+{
+    appendSigned(value, static_cast<unsigned long>(value));
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(unsigned long value)
+{
+    appendUnsigned(value);
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(long long value)
+{
+    appendSigned(value, static_cast<unsigned long long>(value));
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(unsigned long long value)
+{
+    appendUnsigned(value);
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(float value)
+{
+    appendFloatingPoint(static_cast<double>(value));
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(double value)
+{
+    appendFloatingPoint(value);
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(long double value)
+{
+    appendFloatingPoint(value);
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(const char *text)
+{
+    if(text==nullptr)
+    {
+        return (*this)<<nullptr;
+    }
+    appendText(text, std::strlen(text));
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(const std::string &text)
+{
+    appendText(text.data(), text.size());
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(std::nullptr_t)
+{
+    appendText("(null)", 6);
+    return (*this);
+}
+
+/*
+ * Manipulators which only insert characters are applied directly, other
+ * are applied to the stream used for other types
+ */
+AssertionMessage &AssertionMessage::operator<<(StdIoManipulatorType manipulator)
+{
+    if(manipulator==static_cast<StdIoManipulatorType>(std::endl))
+    {
+        append("\n", 1);
+    }
+    else if(manipulator==static_cast<StdIoManipulatorType>(std::ends))
+    {
+        append("", 1);
+    }
+    else if(manipulator!=static_cast<StdIoManipulatorType>(std::flush))
+    {
+        getStream()<<manipulator;
+        releaseStream();
+    }
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::operator<<(
+                                    StdIosBaseManipulatorType manipulator)
+{
+    for(const auto &entry: IOS_BASE_MANIPULATORS)
+    {
+        if(entry.manipulator==manipulator)
+        {
+            flags_ = fromFlags((toFlags(flags_) & ~entry.mask) | entry.flags);
+            return (*this);
+        }
+    }
+    getStream()<<manipulator;
+    releaseStream();
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::streamObjectPointer(
+                                        const volatile void *pointer)
+{
+    const std::size_t start = size_;
+    print(isSet(flags_, std::ios_base::uppercase) ? "0X%llX" : "0x%llx",
+          static_cast<unsigned long long>(
+              reinterpret_cast<std::uintptr_t>(pointer)));
+    pad(start, 2);
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::streamPointer(const void *pointer)
+{
+    width_ = 0;
+    print("0x%0*llx", static_cast<int>(sizeof(const void *)*2),
+          static_cast<unsigned long long>(
+              reinterpret_cast<std::uintptr_t>(pointer)));
+    return (*this);
+}
+
+AssertionMessage &AssertionMessage::streamPointer(const char *text)
+{
+    return (*this)<<text;
+}
+
+AssertionMessage &AssertionMessage::streamPointer(const signed char *text)
+{
+    return (*this)<<reinterpret_cast<const char *>(text);
+}
+
+AssertionMessage &AssertionMessage::streamPointer(const unsigned char *text)
+{
+    return (*this)<<reinterpret_cast<const char *>(text);
+}
+
+/*
+ * When stream can't be allocated output of other types is dropped
+ */
+std::ostream &AssertionMessage::getStream()
+{
+    if(stream_==nullptr)
+    {
+        stream_ = new (std::nothrow) StreamAdapter(this);
+        if(stream_==nullptr)
+        {
+            static std::ostream badStream(nullptr);
+            return badStream;
+        }
+    }
+    std::ostream &stream = stream_->getStream();
+    stream.flags(toFlags(flags_));
+    stream.width(width_);
+    stream.precision(precision_);
+    stream.fill(fill_);
+    return stream;
+}
+
+void AssertionMessage::releaseStream()
+{
+    if(stream_==nullptr)
+    {
+        return;
+    }
+    std::ostream &stream = stream_->getStream();
+    flags_ = fromFlags(stream.flags());
+    width_ = stream.width();
+    precision_ = stream.precision();
+    fill_ = stream.fill();
+}
+
+std::string AssertionMessage::str() const
+{
+    return std::string(data_, size_);
+}
+
+
+} //internal
+} //asrt
@@ -19,6 +19,14 @@ void PrintMessageToStdErr(const char *message)
 
 }
 
+void PrintMessageToStdErr(const char *message, std::size_t length)
+{
+    std::size_t result = std::fwrite(message, 1, length, stderr);
+    CPP_ASSERT_MARK_UNUSED(result);
+    const std::int32_t flushResult = std::fflush(stderr);
+    CPP_ASSERT_MARK_UNUSED(flushResult);
+}
+
 } //internal
 } //cppassert
 
@@ -0,0 +1,1824 @@
+#include <cppassert/details/DwarfLineTable.hpp>
+
+#ifdef CPP_ASSERT_HAVE_DWARF_LINES
+#include <algorithm>
+#include <cstring>
+#include <elf.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace cppassert
+{
+namespace internal
+{
+
+namespace
+{
+//constants have the names used by DWARF specification
+const std::uint64_t DW_TAG_inlined_subroutine = 0x1d;
+const std::uint64_t DW_TAG_subprogram = 0x2e;
+
+const std::uint64_t DW_AT_stmt_list = 0x10;
+const std::uint64_t DW_AT_low_pc = 0x11;
+const std::uint64_t DW_AT_high_pc = 0x12;
+const std::uint64_t DW_AT_name = 0x03;
+const std::uint64_t DW_AT_comp_dir = 0x1b;
+const std::uint64_t DW_AT_abstract_origin = 0x31;
+const std::uint64_t DW_AT_specification = 0x47;
+const std::uint64_t DW_AT_ranges = 0x55;
+const std::uint64_t DW_AT_call_file = 0x58;
+const std::uint64_t DW_AT_call_line = 0x59;
+const std::uint64_t DW_AT_linkage_name = 0x6e;
+const std::uint64_t DW_AT_str_offsets_base = 0x72;
+const std::uint64_t DW_AT_addr_base = 0x73;
+const std::uint64_t DW_AT_rnglists_base = 0x74;
+const std::uint64_t DW_AT_MIPS_linkage_name = 0x2007;
+
+const std::uint64_t DW_FORM_addr = 0x01;
+const std::uint64_t DW_FORM_block2 = 0x03;
+const std::uint64_t DW_FORM_block4 = 0x04;
+const std::uint64_t DW_FORM_data2 = 0x05;
+const std::uint64_t DW_FORM_data4 = 0x06;
+const std::uint64_t DW_FORM_data8 = 0x07;
+const std::uint64_t DW_FORM_string = 0x08;
+const std::uint64_t DW_FORM_block = 0x09;
+const std::uint64_t DW_FORM_block1 = 0x0a;
+const std::uint64_t DW_FORM_data1 = 0x0b;
+const std::uint64_t DW_FORM_flag = 0x0c;
+const std::uint64_t DW_FORM_sdata = 0x0d;
+const std::uint64_t DW_FORM_strp = 0x0e;
+const std::uint64_t DW_FORM_udata = 0x0f;
+const std::uint64_t DW_FORM_ref_addr = 0x10;
+const std::uint64_t DW_FORM_ref1 = 0x11;
+const std::uint64_t DW_FORM_ref2 = 0x12;
+const std::uint64_t DW_FORM_ref4 = 0x13;
+const std::uint64_t DW_FORM_ref8 = 0x14;
+const std::uint64_t DW_FORM_ref_udata = 0x15;
+const std::uint64_t DW_FORM_indirect = 0x16;
+const std::uint64_t DW_FORM_sec_offset = 0x17;
+const std::uint64_t DW_FORM_exprloc = 0x18;
+const std::uint64_t DW_FORM_flag_present = 0x19;
+const std::uint64_t DW_FORM_strx = 0x1a;
+const std::uint64_t DW_FORM_addrx = 0x1b;
+const std::uint64_t DW_FORM_ref_sup4 = 0x1c;
+const std::uint64_t DW_FORM_strp_sup = 0x1d;
+const std::uint64_t DW_FORM_data16 = 0x1e;
+const std::uint64_t DW_FORM_line_strp = 0x1f;
+const std::uint64_t DW_FORM_ref_sig8 = 0x20;
+const std::uint64_t DW_FORM_implicit_const = 0x21;
+const std::uint64_t DW_FORM_loclistx = 0x22;
+const std::uint64_t DW_FORM_rnglistx = 0x23;
+const std::uint64_t DW_FORM_ref_sup8 = 0x24;
+const std::uint64_t DW_FORM_strx1 = 0x25;
+const std::uint64_t DW_FORM_strx2 = 0x26;
+const std::uint64_t DW_FORM_strx3 = 0x27;
+const std::uint64_t DW_FORM_strx4 = 0x28;
+const std::uint64_t DW_FORM_addrx1 = 0x29;
+const std::uint64_t DW_FORM_addrx2 = 0x2a;
+const std::uint64_t DW_FORM_addrx3 = 0x2b;
+const std::uint64_t DW_FORM_addrx4 = 0x2c;
+const std::uint64_t DW_FORM_GNU_addr_index = 0x1f01;
+const std::uint64_t DW_FORM_GNU_str_index = 0x1f02;
+const std::uint64_t DW_FORM_GNU_ref_alt = 0x1f20;
+const std::uint64_t DW_FORM_GNU_strp_alt = 0x1f21;
+
+const std::uint8_t DW_UT_compile = 0x01;
+const std::uint8_t DW_UT_partial = 0x03;
+const std::uint8_t DW_UT_skeleton = 0x04;
+
+const std::uint8_t DW_LNS_copy = 0x01;
+const std::uint8_t DW_LNS_advance_pc = 0x02;
+const std::uint8_t DW_LNS_advance_line = 0x03;
+const std::uint8_t DW_LNS_set_file = 0x04;
+const std::uint8_t DW_LNS_const_add_pc = 0x08;
+const std::uint8_t DW_LNS_fixed_advance_pc = 0x09;
+
+const std::uint8_t DW_LNE_end_sequence = 0x01;
+const std::uint8_t DW_LNE_set_address = 0x02;
+
+const std::uint64_t DW_LNCT_path = 0x1;
+const std::uint64_t DW_LNCT_directory_index = 0x2;
+
+const std::uint8_t DW_RLE_end_of_list = 0x00;
+const std::uint8_t DW_RLE_base_addressx = 0x01;
+const std::uint8_t DW_RLE_startx_endx = 0x02;
+const std::uint8_t DW_RLE_startx_length = 0x03;
+const std::uint8_t DW_RLE_offset_pair = 0x04;
+const std::uint8_t DW_RLE_base_address = 0x05;
+const std::uint8_t DW_RLE_start_end = 0x06;
+const std::uint8_t DW_RLE_start_length = 0x07;
+
+const char *const DebugDirectory = "/usr/lib/debug";
+
+/*
+ * Bounds checked reader of little or big endian data of the same byte
+ * order as the process, reading past the end makes it invalid and
+ * returns zeros
+ */
+class DataReader
+{
+public:
+    DataReader() = default;
+
+    DataReader(const char *begin, const char *end)
+        :position_(begin), end_(end)
+    {
+    }
+
+    bool isValid() const
+    {
+        return valid_;
+    }
+
+    bool isAtEnd() const
+    {
+        return (position_>=end_);
+    }
+
+    const char *getPosition() const
+    {
+        return position_;
+    }
+
+    std::size_t getRemaining() const
+    {
+        return static_cast<std::size_t>(end_-position_);
+    }
+
+    void skip(std::uint64_t size)
+    {
+        if(size>getRemaining())
+        {
+            fail();
+            return;
+        }
+        position_ += size;
+    }
+
+    std::uint64_t readUnsigned(std::size_t size)
+    {
+        switch(size)
+        {
+            case 1: return read<std::uint8_t>();
+            case 2: return read<std::uint16_t>();
+            case 4: return read<std::uint32_t>();
+            case 8: return read<std::uint64_t>();
+            case 3:
+            {
+                //3 byte values are used only by DWARF 5 indices
+                const std::uint64_t low = read<std::uint16_t>();
+                return (low | (static_cast<std::uint64_t>(
+                                            read<std::uint8_t>())<<16));
+            }
+            default:
+                fail();
+                return 0;
+        }
+    }
+
+    template<typename T>
+    T read()
+    {
+        T value = 0;
+        if(getRemaining()<sizeof(T))
+        {
+            fail();
+            return value;
+        }
+        std::memcpy(&value, position_, sizeof(T));
+        position_ += sizeof(T);
+        return value;
+    }
+
+    std::uint64_t readOffset(bool is64)
+    {
+        return is64 ? read<std::uint64_t>() : read<std::uint32_t>();
+    }
+
+    std::uint64_t readUleb()
+    {
+        std::uint64_t value = 0;
+        unsigned shift = 0;
+        while(!isAtEnd())
+        {
+            const std::uint8_t byte = static_cast<std::uint8_t>(*position_++);
+            if(shift<64)
+            {
+                value |= static_cast<std::uint64_t>(byte & 0x7f)<<shift;
+            }
+            shift += 7;
+            if((byte & 0x80)==0)
+            {
+                return value;
+            }
+        }
+        fail();
+        return 0;
+    }
+
+    std::int64_t readSleb()
+    {
+        std::uint64_t value = 0;
+        unsigned shift = 0;
+        while(!isAtEnd())
+        {
+            const std::uint8_t byte = static_cast<std::uint8_t>(*position_++);
+            if(shift<64)
+            {
+                value |= static_cast<std::uint64_t>(byte & 0x7f)<<shift;
+            }
+            shift += 7;
+            if((byte & 0x80)==0)
+            {
+                if(shift<64 && (byte & 0x40)!=0)
+                {
+                    value |= ~static_cast<std::uint64_t>(0)<<shift;
+                }
+                return static_cast<std::int64_t>(value);
+            }
+        }
+        fail();
+        return 0;
+    }
+
+    const char *readString()
+    {
+        const char *end = static_cast<const char *>(
+                            std::memchr(position_, '\0', getRemaining()));
+        if(end==nullptr)
+        {
+            fail();
+            return nullptr;
+        }
+        const char *result = position_;
+        position_ = end+1;
+        return result;
+    }
+
+    /*
+     * Reads initial length of a unit, returns reader of the unit
+     * contents and skips them
+     */
+    DataReader readUnit(bool *is64)
+    {
+        std::uint64_t length = read<std::uint32_t>();
+        *is64 = (length==0xffffffff);
+        if(*is64)
+        {
+            length = read<std::uint64_t>();
+        }
+        if(!valid_ || length>getRemaining())
+        {
+            fail();
+            return DataReader();
+        }
+        DataReader unit(position_, position_+length);
+        position_ += length;
+        return unit;
+    }
+private:
+    void fail()
+    {
+        valid_ = false;
+        position_ = end_;
+    }
+
+    const char *position_ = nullptr;
+    const char *end_ = nullptr;
+    bool valid_ = true;
+};
+
+bool isAbsolute(const char *path)
+{
+    return (path[0]=='/');
+}
+
+std::string joinPath(const std::string &directory, const char *name)
+{
+    if(directory.empty() || isAbsolute(name))
+    {
+        return name;
+    }
+    std::string path = directory;
+    if(path[path.size()-1]!='/')
+    {
+        path += '/';
+    }
+    return path.append(name);
+}
+
+std::string getDirectory(const char *path)
+{
+    const char *slash = std::strrchr(path, '/');
+    return slash ? std::string(path, slash) : std::string(".");
+}
+
+/*
+ * CRC32 as used by `.gnu_debuglink`, the one of zlib
+ */
+std::uint32_t computeCrc32(const char *data, std::size_t size)
+{
+    static const std::uint32_t *table = []()
+    {
+        static std::uint32_t values[256];
+        for(std::uint32_t i = 0; i<256; ++i)
+        {
+            std::uint32_t value = i;
+            for(int bit = 0; bit<8; ++bit)
+            {
+                value = (value & 1) ? (0xedb88320 ^ (value>>1)) : (value>>1);
+            }
+            values[i] = value;
+        }
+        return values;
+    }();
+    std::uint32_t crc = 0xffffffff;
+    for(std::size_t i = 0; i<size; ++i)
+    {
+        crc = table[(crc ^ static_cast<std::uint8_t>(data[i])) & 0xff]
+                ^ (crc>>8);
+    }
+    return crc ^ 0xffffffff;
+}
+
+bool hasLineInformation(const ElfImage &image)
+{
+    ElfImage::Section section;
+    return image.findSection(".debug_line", &section);
+}
+
+/*
+ * Separate debug file is looked up as
+ * /usr/lib/debug/.build-id/xx/yyyy.debug
+ */
+ElfImage openByBuildId(const ElfImage &image)
+{
+    const std::string buildId = image.getBuildId();
+    if(buildId.size()<4)
+    {
+        return ElfImage();
+    }
+    std::string path = DebugDirectory;
+    path += "/.build-id/";
+    path.append(buildId, 0, 2);
+    path += '/';
+    path.append(buildId, 2, std::string::npos);
+    path += ".debug";
+    return ElfImage(path.c_str());
+}
+
+/*
+ * Debug file named by `.gnu_debuglink` is looked up next to the module,
+ * in its .debug subdirectory and under /usr/lib/debug, its checksum
+ * has to match
+ */
+ElfImage openByDebugLink(const ElfImage &image, const char *modulePath)
+{
+    ElfImage::Section section;
+    if(!image.findSection(".gnu_debuglink", &section))
+    {
+        return ElfImage();
+    }
+    DataReader reader(section.data, section.data+section.size);
+    const char *name = reader.readString();
+    //checksum follows the name aligned to 4 bytes
+    reader.skip((4-(reader.getPosition()-section.data)%4)%4);
+    const std::uint32_t crc = reader.read<std::uint32_t>();
+    if(name==nullptr || !reader.isValid())
+    {
+        return ElfImage();
+    }
+    const std::string directory = getDirectory(modulePath);
+    const std::string candidates[] =
+    {
+        joinPath(directory, name),
+        joinPath(directory+"/.debug", name),
+        joinPath(DebugDirectory+(isAbsolute(directory.c_str())
+                                    ? directory : "/"+directory), name)
+    };
+    for(const auto &candidate: candidates)
+    {
+        if(candidate==modulePath)
+        {
+            continue;
+        }
+        ElfImage debugImage(candidate.c_str());
+        if(debugImage.isValid()
+           && computeCrc32(debugImage.getData(), debugImage.getSize())==crc)
+        {
+            return debugImage;
+        }
+    }
+    return ElfImage();
+}
+
+ElfImage openDebugImage(const char *modulePath)
+{
+    ElfImage image(modulePath);
+    if(!image.isValid() || hasLineInformation(image))
+    {
+        return image;
+    }
+    ElfImage debugImage = openByBuildId(image);
+    if(debugImage.isValid() && hasLineInformation(debugImage))
+    {
+        return debugImage;
+    }
+    debugImage = openByDebugLink(image, modulePath);
+    if(debugImage.isValid() && hasLineInformation(debugImage))
+    {
+        return debugImage;
+    }
+    return ElfImage();
+}
+
+} //anonymous
+
+/*
+ * Decodes debug information of a module into the table, malformed units
+ * are skipped
+ */
+class DwarfLineTable::Loader
+{
+public:
+    explicit Loader(DwarfLineTable &table)
+        :table_(table)
+    {
+        const ElfImage &image = table_.image_;
+        image.findSection(".debug_info", &info_);
+        image.findSection(".debug_abbrev", &abbrev_);
+        image.findSection(".debug_line", &line_);
+        image.findSection(".debug_line_str", &lineStr_);
+        image.findSection(".debug_str", &str_);
+        image.findSection(".debug_str_offsets", &strOffsets_);
+        image.findSection(".debug_addr", &addr_);
+        image.findSection(".debug_ranges", &ranges_);
+        image.findSection(".debug_rnglists", &rngLists_);
+    }
+
+    void load()
+    {
+        loadUnits();
+        if(linePrograms_.empty())
+        {
+            //without .debug_info all line programs are decoded
+            DataReader reader(line_.data, line_.data+line_.size);
+            while(!reader.isAtEnd() && reader.isValid())
+            {
+                loadLineProgram(static_cast<std::uint64_t>(
+                                    reader.getPosition()-line_.data), nullptr);
+                bool is64 = false;
+                reader.readUnit(&is64);
+            }
+        }
+        resolveCallNames();
+        //end of sequence goes before row of next sequence at its address
+        std::vector<Row> &rows = table_.rows_.getStorage();
+        std::vector<Function> &functions = table_.functions_.getStorage();
+        std::stable_sort(rows.begin(), rows.end(),
+                         [](const Row &first, const Row &second)
+                         {
+                             return (first.address<second.address
+                                     || (first.address==second.address
+                                         && first.file==InvalidFile
+                                         && second.file!=InvalidFile));
+                         });
+        std::stable_sort(functions.begin(), functions.end(),
+                         [](const Function &first, const Function &second)
+                         {
+                             return (first.begin<second.begin);
+                         });
+        rows.shrink_to_fit();
+        functions.shrink_to_fit();
+        table_.calls_.shrink_to_fit();
+    }
+private:
+    /*
+     * Value of attribute as it's stored, strings, references and
+     * addresses are resolved by the loader
+     */
+    struct AttributeValue
+    {
+        std::uint64_t form = 0;
+        std::uint64_t value = 0;
+        const char *string = nullptr;
+
+        bool isPresent() const
+        {
+            return (form!=0);
+        }
+    };
+
+    struct AttributeSpecification
+    {
+        std::uint64_t name;
+        std::uint64_t form;
+        std::int64_t implicitConst;
+    };
+
+    struct Abbreviation
+    {
+        std::uint64_t code = 0;
+        std::uint64_t tag = 0;
+        bool hasChildren = false;
+        std::vector<AttributeSpecification> attributes;
+    };
+
+    /*
+     * Attributes of debugging information entry used to find inlined
+     * calls and their names
+     */
+    struct DebugEntry
+    {
+        AttributeValue name;
+        AttributeValue linkageName;
+        AttributeValue lowPc;
+        AttributeValue highPc;
+        AttributeValue ranges;
+        AttributeValue compDir;
+        AttributeValue stmtList;
+        AttributeValue abstractOrigin;
+        AttributeValue specification;
+        AttributeValue callFile;
+        AttributeValue callLine;
+        AttributeValue strOffsetsBase;
+        AttributeValue addrBase;
+        AttributeValue rngListsBase;
+    };
+
+    struct Unit
+    {
+        const char *begin = nullptr;
+        std::uint16_t version = 0;
+        std::uint8_t addressSize = 0;
+        bool is64 = false;
+        std::uint64_t baseAddress = 0;
+        std::uint64_t strOffsetsBase = 0;
+        std::uint64_t addrBase = 0;
+        std::uint64_t rngListsBase = 0;
+        const std::vector<std::uint32_t> *files = nullptr;
+    };
+
+    struct AddressRange
+    {
+        std::uint64_t begin;
+        std::uint64_t end;
+    };
+
+    /*
+     * Name of subprogram or reference to entry which has it
+     */
+    struct SubprogramName
+    {
+        std::uint64_t offset;
+        const char *name;
+        std::uint64_t reference;
+    };
+
+    struct OpenFunction
+    {
+        std::size_t depth;
+        std::size_t firstFunction;
+    };
+
+    void loadUnits()
+    {
+        DataReader reader(info_.data, info_.data+info_.size);
+        while(!reader.isAtEnd() && reader.isValid())
+        {
+            Unit unit;
+            unit.begin = reader.getPosition();
+            DataReader contents = reader.readUnit(&unit.is64);
+            if(reader.isValid())
+            {
+                loadUnit(unit, contents);
+            }
+        }
+    }
+
+    void loadUnit(Unit &unit, DataReader &reader)
+    {
+        unit.version = reader.read<std::uint16_t>();
+        if(unit.version<2 || unit.version>5)
+        {
+            return;
+        }
+        std::uint64_t abbrevOffset = 0;
+        if(unit.version>=5)
+        {
+            const std::uint8_t unitType = reader.read<std::uint8_t>();
+            unit.addressSize = reader.read<std::uint8_t>();
+            abbrevOffset = reader.readOffset(unit.is64);
+            if(unitType==DW_UT_skeleton)
+            {
+                reader.skip(8);
+            }
+            else if(unitType!=DW_UT_compile && unitType!=DW_UT_partial)
+            {
+                return;
+            }
+        }
+        else
+        {
+            abbrevOffset = reader.readOffset(unit.is64);
+            unit.addressSize = reader.read<std::uint8_t>();
+        }
+        if((unit.addressSize!=4 && unit.addressSize!=8)
+           || !loadAbbreviations(abbrevOffset))
+        {
+            return;
+        }
+        loadEntries(unit, reader);
+    }
+
+    bool loadAbbreviations(std::uint64_t offset)
+    {
+        abbreviations_.clear();
+        if(offset>=abbrev_.size)
+        {
+            return false;
+        }
+        DataReader reader(abbrev_.data+offset, abbrev_.data+abbrev_.size);
+        while(reader.isValid())
+        {
+            Abbreviation abbreviation;
+            abbreviation.code = reader.readUleb();
+            if(abbreviation.code==0)
+            {
+                break;
+            }
+            abbreviation.tag = reader.readUleb();
+            abbreviation.hasChildren = (reader.read<std::uint8_t>()!=0);
+            while(reader.isValid())
+            {
+                AttributeSpecification attribute = {0, 0, 0};
+                attribute.name = reader.readUleb();
+                attribute.form = reader.readUleb();
+                if(attribute.form==DW_FORM_implicit_const)
+                {
+                    attribute.implicitConst = reader.readSleb();
+                }
+                if(attribute.name==0 && attribute.form==0)
+                {
+                    break;
+                }
+                abbreviation.attributes.push_back(attribute);
+            }
+            abbreviations_.push_back(std::move(abbreviation));
+        }
+        return reader.isValid();
+    }
+
+    const Abbreviation *findAbbreviation(std::uint64_t code) const
+    {
+        //codes are usually assigned sequentially from 1
+        if(code<=abbreviations_.size()
+           && abbreviations_[code-1].code==code)
+        {
+            return &abbreviations_[code-1];
+        }
+        for(const auto &abbreviation: abbreviations_)
+        {
+            if(abbreviation.code==code)
+            {
+                return &abbreviation;
+            }
+        }
+        return nullptr;
+    }
+
+    void loadEntries(Unit &unit, DataReader &reader)
+    {
+        std::vector<std::uint64_t> parents;
+        std::vector<OpenFunction> openFunctions;
+        std::vector<std::uint32_t> noFiles;
+        unit.files = &noFiles;
+        bool isUnitEntry = true;
+        while(!reader.isAtEnd() && reader.isValid())
+        {
+            const std::uint64_t offset = static_cast<std::uint64_t>(
+                                            reader.getPosition()-info_.data);
+            const std::uint64_t code = reader.readUleb();
+            if(code==0)
+            {
+                if(!parents.empty())
+                {
+                    parents.pop_back();
+                    closeFunctions(parents.size(), &openFunctions);
+                }
+                continue;
+            }
+            const Abbreviation *abbreviation = findAbbreviation(code);
+            DebugEntry entry;
+            if(abbreviation==nullptr || !readEntry(unit, *abbreviation,
+                                                   reader, &entry))
+            {
+                break;
+            }
+            if(isUnitEntry)
+            {
+                isUnitEntry = false;
+                loadUnitEntry(unit, entry);
+            }
+            else if(abbreviation->tag==DW_TAG_subprogram)
+            {
+                addSubprogram(unit, offset, entry, parents.size(),
+                              &openFunctions);
+            }
+            else if(abbreviation->tag==DW_TAG_inlined_subroutine
+                    && !openFunctions.empty())
+            {
+                addInlinedCall(unit, entry, parents);
+            }
+            if(abbreviation->hasChildren)
+            {
+                parents.push_back(abbreviation->tag);
+            }
+            else
+            {
+                closeFunctions(parents.size(), &openFunctions);
+            }
+        }
+        closeFunctions(0, &openFunctions);
+    }
+
+    void loadUnitEntry(Unit &unit, const DebugEntry &entry)
+    {
+        unit.strOffsetsBase = entry.strOffsetsBase.value;
+        unit.addrBase = entry.addrBase.value;
+        unit.rngListsBase = entry.rngListsBase.value;
+        if(!entry.strOffsetsBase.isPresent() && unit.version>=5)
+        {
+            unit.strOffsetsBase = unit.is64 ? 16 : 8;
+        }
+        if(!entry.addrBase.isPresent() && unit.version>=5)
+        {
+            unit.addrBase = 8;
+        }
+        if(!entry.rngListsBase.isPresent() && unit.version>=5)
+        {
+            unit.rngListsBase = unit.is64 ? 20 : 12;
+        }
+        if(entry.lowPc.isPresent())
+        {
+            unit.baseAddress = resolveAddress(unit, entry.lowPc);
+        }
+        if(entry.stmtList.isPresent())
+        {
+            unit.files = loadLineProgram(entry.stmtList.value,
+                                         resolveString(unit, entry.compDir));
+        }
+    }
+
+    /*
+     * Out of line instance of function starts new set of inlined calls,
+     * its declaration only provides name
+     */
+    void addSubprogram(const Unit &unit, std::uint64_t offset,
+                       const DebugEntry &entry, std::size_t depth,
+                       std::vector<OpenFunction> *openFunctions)
+    {
+        SubprogramName name = {offset, nullptr, 0};
+        name.name = resolveString(unit, entry.name);
+        if(name.name==nullptr)
+        {
+            name.name = resolveString(unit, entry.linkageName);
+        }
+        if(name.name==nullptr)
+        {
+            name.reference = resolveReference(unit,
+                                    entry.abstractOrigin.isPresent()
+                                        ? entry.abstractOrigin
+                                        : entry.specification);
+        }
+        subprograms_.push_back(name);
+        if(!readRanges(unit, entry))
+        {
+            return;
+        }
+        openFunctions->push_back({depth, table_.functions_.getStorage().size()});
+        const std::uint32_t firstCall
+                = static_cast<std::uint32_t>(table_.calls_.size());
+        for(const auto &range: rangesBuffer_)
+        {
+            const Function function = {
+                static_cast<std::uintptr_t>(range.begin),
+                static_cast<std::uintptr_t>(range.end),
+                firstCall,
+                firstCall
+            };
+            table_.functions_.getStorage().push_back(function);
+        }
+    }
+
+    void addInlinedCall(const Unit &unit, const DebugEntry &entry,
+                        const std::vector<std::uint64_t> &parents)
+    {
+        if(!readRanges(unit, entry))
+        {
+            return;
+        }
+        std::uint32_t depth = 1;
+        for(auto parent = parents.rbegin();
+            parent!=parents.rend() && *parent!=DW_TAG_subprogram; ++parent)
+        {
+            if(*parent==DW_TAG_inlined_subroutine)
+            {
+                ++depth;
+            }
+        }
+        std::uint32_t file = InvalidFile;
+        if(entry.callFile.value<unit.files->size())
+        {
+            file = (*unit.files)[entry.callFile.value];
+        }
+        const std::uint64_t origin = resolveReference(unit,
+                                                      entry.abstractOrigin);
+        for(const auto &range: rangesBuffer_)
+        {
+            const InlinedCall call = {
+                static_cast<std::uintptr_t>(range.begin),
+                static_cast<std::uintptr_t>(range.end),
+                nullptr,
+                depth,
+                file,
+                static_cast<std::uint32_t>(entry.callLine.value)
+            };
+            table_.calls_.push_back(call);
+            callOrigins_.push_back(origin);
+        }
+    }
+
+    void closeFunctions(std::size_t depth,
+                        std::vector<OpenFunction> *openFunctions)
+    {
+        while(!openFunctions->empty() && openFunctions->back().depth>=depth)
+        {
+            const std::uint32_t lastCall
+                    = static_cast<std::uint32_t>(table_.calls_.size());
+            for(std::size_t i = openFunctions->back().firstFunction;
+                i<table_.functions_.getStorage().size(); ++i)
+            {
+                table_.functions_.getStorage()[i].lastCall = lastCall;
+            }
+            openFunctions->pop_back();
+        }
+    }
+
+    /*
+     * Inlined call refers to abstract instance of function, which may
+     * refer to its declaration
+     */
+    void resolveCallNames()
+    {
+        for(std::size_t i = 0; i<table_.calls_.size(); ++i)
+        {
+            std::uint64_t reference = callOrigins_[i];
+            for(int hop = 0; hop<4 && reference!=0; ++hop)
+            {
+                auto subprogram = std::lower_bound(subprograms_.begin(),
+                                        subprograms_.end(), reference,
+                                        [](const SubprogramName &name,
+                                           std::uint64_t offset)
+                                        {
+                                            return (name.offset<offset);
+                                        });
+                if(subprogram==subprograms_.end()
+                   || subprogram->offset!=reference)
+                {
+                    break;
+                }
+                table_.calls_[i].function = subprogram->name;
+                reference = subprogram->reference;
+            }
+        }
+    }
+
+    bool readEntry(const Unit &unit, const Abbreviation &abbreviation,
+                   DataReader &reader, DebugEntry *entry)
+    {
+        for(const auto &attribute: abbreviation.attributes)
+        {
+            AttributeValue value;
+            if(!readAttribute(reader, attribute.form, attribute.implicitConst,
+                              unit.is64, unit.addressSize, unit.version,
+                              &value))
+            {
+                return false;
+            }
+            switch(attribute.name)
+            {
+                case DW_AT_name: entry->name = value; break;
+                case DW_AT_linkage_name:
+                case DW_AT_MIPS_linkage_name:
+                    entry->linkageName = value;
+                    break;
+                case DW_AT_low_pc: entry->lowPc = value; break;
+                case DW_AT_high_pc: entry->highPc = value; break;
+                case DW_AT_ranges: entry->ranges = value; break;
+                case DW_AT_comp_dir: entry->compDir = value; break;
+                case DW_AT_stmt_list: entry->stmtList = value; break;
+                case DW_AT_abstract_origin:
+                    entry->abstractOrigin = value;
+                    break;
+                case DW_AT_specification: entry->specification = value; break;
+                case DW_AT_call_file: entry->callFile = value; break;
+                case DW_AT_call_line: entry->callLine = value; break;
+                case DW_AT_str_offsets_base:
+                    entry->strOffsetsBase = value;
+                    break;
+                case DW_AT_addr_base: entry->addrBase = value; break;
+                case DW_AT_rnglists_base: entry->rngListsBase = value; break;
+                default: break;
+            }
+        }
+        return reader.isValid();
+    }
+
+    /*
+     * Reads value of any form, returns false for unknown forms since
+     * the rest of the unit can't be read then
+     */
+    static bool readAttribute(DataReader &reader, std::uint64_t form,
+                              std::int64_t implicitConst, bool is64,
+                              std::uint8_t addressSize, std::uint16_t version,
+                              AttributeValue *value)
+    {
+        value->form = form;
+        switch(form)
+        {
+            case DW_FORM_addr:
+                value->value = reader.readUnsigned(addressSize);
+                break;
+            case DW_FORM_data1:
+            case DW_FORM_ref1:
+            case DW_FORM_flag:
+            case DW_FORM_strx1:
+            case DW_FORM_addrx1:
+                value->value = reader.readUnsigned(1);
+                break;
+            case DW_FORM_data2:
+            case DW_FORM_ref2:
+            case DW_FORM_strx2:
+            case DW_FORM_addrx2:
+                value->value = reader.readUnsigned(2);
+                break;
+            case DW_FORM_strx3:
+            case DW_FORM_addrx3:
+                value->value = reader.readUnsigned(3);
+                break;
+            case DW_FORM_data4:
+            case DW_FORM_ref4:
+            case DW_FORM_ref_sup4:
+            case DW_FORM_strx4:
+            case DW_FORM_addrx4:
+                value->value = reader.readUnsigned(4);
+                break;
+            case DW_FORM_data8:
+            case DW_FORM_ref8:
+            case DW_FORM_ref_sig8:
+            case DW_FORM_ref_sup8:
+                value->value = reader.readUnsigned(8);
+                break;
+            case DW_FORM_data16:
+                reader.skip(16);
+                break;
+            case DW_FORM_sdata:
+                value->value = static_cast<std::uint64_t>(reader.readSleb());
+                break;
+            case DW_FORM_udata:
+            case DW_FORM_ref_udata:
+            case DW_FORM_strx:
+            case DW_FORM_addrx:
+            case DW_FORM_loclistx:
+            case DW_FORM_rnglistx:
+            case DW_FORM_GNU_addr_index:
+            case DW_FORM_GNU_str_index:
+                value->value = reader.readUleb();
+                break;
+            case DW_FORM_string:
+                value->string = reader.readString();
+                break;
+            case DW_FORM_strp:
+            case DW_FORM_line_strp:
+            case DW_FORM_sec_offset:
+            case DW_FORM_strp_sup:
+            case DW_FORM_GNU_ref_alt:
+            case DW_FORM_GNU_strp_alt:
+                value->value = reader.readOffset(is64);
+                break;
+            case DW_FORM_ref_addr:
+                value->value = (version<=2) ? reader.readUnsigned(addressSize)
+                                            : reader.readOffset(is64);
+                break;
+            case DW_FORM_block1:
+                reader.skip(reader.readUnsigned(1));
+                break;
+            case DW_FORM_block2:
+                reader.skip(reader.readUnsigned(2));
+                break;
+            case DW_FORM_block4:
+                reader.skip(reader.readUnsigned(4));
+                break;
+            case DW_FORM_block:
+            case DW_FORM_exprloc:
+                reader.skip(reader.readUleb());
+                break;
+            case DW_FORM_flag_present:
+                value->value = 1;
+                break;
+            case DW_FORM_implicit_const:
+                value->value = static_cast<std::uint64_t>(implicitConst);
+                break;
+            case DW_FORM_indirect:
+                return readAttribute(reader, reader.readUleb(), implicitConst,
+                                     is64, addressSize, version, value);
+            default:
+                return false;
+        }
+        return reader.isValid();
+    }
+
+    static const char *getString(const ElfImage::Section &section,
+                                 std::uint64_t offset)
+    {
+        if(offset>=section.size
+           || std::memchr(section.data+offset, '\0', section.size-offset)
+                    ==nullptr)
+        {
+            return nullptr;
+        }
+        return section.data+offset;
+    }
+
+    /*
+     * Strings of supplementary object files are not supported
+     */
+    const char *resolveString(const Unit &unit,
+                              const AttributeValue &value) const
+    {
+        switch(value.form)
+        {
+            case DW_FORM_string:
+                return value.string;
+            case DW_FORM_strp:
+                return getString(str_, value.value);
+            case DW_FORM_line_strp:
+                return getString(lineStr_, value.value);
+            case DW_FORM_strx:
+            case DW_FORM_strx1:
+            case DW_FORM_strx2:
+            case DW_FORM_strx3:
+            case DW_FORM_strx4:
+            case DW_FORM_GNU_str_index:
+            {
+                const std::size_t offsetSize = unit.is64 ? 8 : 4;
+                const std::uint64_t position = unit.strOffsetsBase
+                                                +value.value*offsetSize;
+                if(position>=strOffsets_.size)
+                {
+                    return nullptr;
+                }
+                DataReader reader(strOffsets_.data+position,
+                                  strOffsets_.data+strOffsets_.size);
+                const std::uint64_t offset = reader.readOffset(unit.is64);
+                return reader.isValid() ? getString(str_, offset) : nullptr;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    std::uint64_t resolveAddress(const Unit &unit,
+                                 const AttributeValue &value) const
+    {
+        switch(value.form)
+        {
+            case DW_FORM_addrx:
+            case DW_FORM_addrx1:
+            case DW_FORM_addrx2:
+            case DW_FORM_addrx3:
+            case DW_FORM_addrx4:
+            case DW_FORM_GNU_addr_index:
+                return readIndexedAddress(unit, value.value);
+            default:
+                return value.value;
+        }
+    }
+
+    std::uint64_t readIndexedAddress(const Unit &unit,
+                                     std::uint64_t index) const
+    {
+        const std::uint64_t position = unit.addrBase
+                                        +index*unit.addressSize;
+        if(position>=addr_.size)
+        {
+            return 0;
+        }
+        DataReader reader(addr_.data+position, addr_.data+addr_.size);
+        return reader.readUnsigned(unit.addressSize);
+    }
+
+    /*
+     * Returns offset of referenced entry in .debug_info or 0
+     */
+    std::uint64_t resolveReference(const Unit &unit,
+                                   const AttributeValue &value) const
+    {
+        const std::uint64_t unitOffset
+                = static_cast<std::uint64_t>(unit.begin-info_.data);
+        switch(value.form)
+        {
+            case DW_FORM_ref1:
+            case DW_FORM_ref2:
+            case DW_FORM_ref4:
+            case DW_FORM_ref8:
+            case DW_FORM_ref_udata:
+                return unitOffset+value.value;
+            case DW_FORM_ref_addr:
+                return value.value;
+            default:
+                return 0;
+        }
+    }
+
+    /*
+     * Reads address ranges of entry to rangesBuffer_, returns false
+     * if there are none
+     */
+    bool readRanges(const Unit &unit, const DebugEntry &entry)
+    {
+        rangesBuffer_.clear();
+        if(entry.lowPc.isPresent() && entry.highPc.isPresent())
+        {
+            const std::uint64_t begin = resolveAddress(unit, entry.lowPc);
+            std::uint64_t end = resolveAddress(unit, entry.highPc);
+            if(entry.highPc.form!=DW_FORM_addr
+               && entry.highPc.form!=DW_FORM_addrx
+               && entry.highPc.form!=DW_FORM_addrx1
+               && entry.highPc.form!=DW_FORM_addrx2
+               && entry.highPc.form!=DW_FORM_addrx3
+               && entry.highPc.form!=DW_FORM_addrx4
+               && entry.highPc.form!=DW_FORM_GNU_addr_index)
+            {
+                end = begin+entry.highPc.value;
+            }
+            addRange(begin, end);
+        }
+        else if(entry.ranges.isPresent())
+        {
+            if(unit.version<5)
+            {
+                readRangeList(unit, entry.ranges.value);
+            }
+            else
+            {
+                readRangeListV5(unit, entry.ranges);
+            }
+        }
+        return !rangesBuffer_.empty();
+    }
+
+    void addRange(std::uint64_t begin, std::uint64_t end)
+    {
+        //functions removed by linker have address 0
+        if(begin<end && begin!=0)
+        {
+            rangesBuffer_.push_back({begin, end});
+        }
+    }
+
+    void readRangeList(const Unit &unit, std::uint64_t offset)
+    {
+        if(offset>=ranges_.size)
+        {
+            return;
+        }
+        const std::uint64_t baseSelection = (unit.addressSize==8)
+                                            ? ~static_cast<std::uint64_t>(0)
+                                            : 0xffffffff;
+        std::uint64_t base = unit.baseAddress;
+        DataReader reader(ranges_.data+offset, ranges_.data+ranges_.size);
+        while(reader.isValid())
+        {
+            const std::uint64_t begin = reader.readUnsigned(unit.addressSize);
+            const std::uint64_t end = reader.readUnsigned(unit.addressSize);
+            if(!reader.isValid() || (begin==0 && end==0))
+            {
+                break;
+            }
+            if(begin==baseSelection)
+            {
+                base = end;
+            }
+            else
+            {
+                addRange(base+begin, base+end);
+            }
+        }
+    }
+
+    void readRangeListV5(const Unit &unit, const AttributeValue &value)
+    {
+        std::uint64_t offset = value.value;
+        if(value.form==DW_FORM_rnglistx)
+        {
+            const std::size_t offsetSize = unit.is64 ? 8 : 4;
+            const std::uint64_t position = unit.rngListsBase
+                                            +value.value*offsetSize;
+            if(position>=rngLists_.size)
+            {
+                return;
+            }
+            DataReader reader(rngLists_.data+position,
+                              rngLists_.data+rngLists_.size);
+            offset = unit.rngListsBase+reader.readOffset(unit.is64);
+        }
+        if(offset>=rngLists_.size)
+        {
+            return;
+        }
+        std::uint64_t base = unit.baseAddress;
+        DataReader reader(rngLists_.data+offset,
+                          rngLists_.data+rngLists_.size);
+        while(reader.isValid())
+        {
+            const std::uint8_t kind = reader.read<std::uint8_t>();
+            switch(kind)
+            {
+                case DW_RLE_end_of_list:
+                    return;
+                case DW_RLE_base_addressx:
+                    base = readIndexedAddress(unit, reader.readUleb());
+                    break;
+                case DW_RLE_startx_endx:
+                {
+                    const std::uint64_t begin
+                            = readIndexedAddress(unit, reader.readUleb());
+                    addRange(begin,
+                             readIndexedAddress(unit, reader.readUleb()));
+                    break;
+                }
+                case DW_RLE_startx_length:
+                {
+                    const std::uint64_t begin
+                            = readIndexedAddress(unit, reader.readUleb());
+                    addRange(begin, begin+reader.readUleb());
+                    break;
+                }
+                case DW_RLE_offset_pair:
+                {
+                    const std::uint64_t begin = base+reader.readUleb();
+                    addRange(begin, base+reader.readUleb());
+                    break;
+                }
+                case DW_RLE_base_address:
+                    base = reader.readUnsigned(unit.addressSize);
+                    break;
+                case DW_RLE_start_end:
+                {
+                    const std::uint64_t begin
+                            = reader.readUnsigned(unit.addressSize);
+                    addRange(begin, reader.readUnsigned(unit.addressSize));
+                    break;
+                }
+                case DW_RLE_start_length:
+                {
+                    const std::uint64_t begin
+                            = reader.readUnsigned(unit.addressSize);
+                    addRange(begin, begin+reader.readUleb());
+                    break;
+                }
+                default:
+                    return;
+            }
+        }
+    }
+
+    /*
+     * Decodes line program at offset once, returns mapping of its file
+     * numbers to files of the table
+     */
+    const std::vector<std::uint32_t> *loadLineProgram(std::uint64_t offset,
+                                                      const char *compDir)
+    {
+        auto loaded = linePrograms_.find(offset);
+        if(loaded!=linePrograms_.end())
+        {
+            return &loaded->second;
+        }
+        std::vector<std::uint32_t> &files = linePrograms_[offset];
+        if(offset>=line_.size)
+        {
+            return &files;
+        }
+        DataReader sectionReader(line_.data+offset, line_.data+line_.size);
+        bool is64 = false;
+        DataReader reader = sectionReader.readUnit(&is64);
+        const std::uint16_t version = reader.read<std::uint16_t>();
+        if(!sectionReader.isValid() || version<2 || version>5)
+        {
+            return &files;
+        }
+        std::uint8_t addressSize = sizeof(void *);
+        if(version>=5)
+        {
+            addressSize = reader.read<std::uint8_t>();
+            reader.read<std::uint8_t>();
+        }
+        const std::uint64_t headerLength = reader.readOffset(is64);
+        if(headerLength>reader.getRemaining())
+        {
+            return &files;
+        }
+        DataReader program(reader.getPosition()+headerLength,
+                           reader.getPosition()+reader.getRemaining());
+        const std::uint8_t minimumInstructionLength
+                = reader.read<std::uint8_t>();
+        if(version>=4)
+        {
+            reader.read<std::uint8_t>();
+        }
+        reader.read<std::uint8_t>();
+        const std::int8_t lineBase = reader.read<std::int8_t>();
+        const std::uint8_t lineRange = reader.read<std::uint8_t>();
+        const std::uint8_t opcodeBase = reader.read<std::uint8_t>();
+        std::vector<std::uint8_t> opcodeLengths;
+        for(unsigned i = 1; i<opcodeBase; ++i)
+        {
+            opcodeLengths.push_back(reader.read<std::uint8_t>());
+        }
+        if(!reader.isValid() || lineRange==0)
+        {
+            return &files;
+        }
+        const std::string unitDirectory = compDir ? compDir : "";
+        if(version>=5)
+        {
+            readFileTable(reader, is64, unitDirectory, &files);
+        }
+        else
+        {
+            readFileTableV4(reader, unitDirectory, &files);
+        }
+        decodeLineProgram(program, addressSize, minimumInstructionLength,
+                          lineBase, lineRange, opcodeBase, opcodeLengths,
+                          files);
+        return &files;
+    }
+
+    /*
+     * Directory 0 and file 0 are the unit directory and file in
+     * DWARF 5
+     */
+    void readFileTable(DataReader &reader, bool is64,
+                       const std::string &unitDirectory,
+                       std::vector<std::uint32_t> *files)
+    {
+        std::vector<std::string> directories;
+        readEntryTable(reader, is64, [&](const char *path, std::uint64_t)
+        {
+            directories.push_back(joinPath(unitDirectory, path));
+        });
+        readEntryTable(reader, is64, [&](const char *path,
+                                         std::uint64_t directory)
+        {
+            files->push_back(addFile((directory<directories.size())
+                                        ? directories[directory]
+                                        : unitDirectory, path));
+        });
+    }
+
+    template<typename AddEntry>
+    void readEntryTable(DataReader &reader, bool is64, AddEntry addEntry)
+    {
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> formats;
+        const std::uint8_t formatCount = reader.read<std::uint8_t>();
+        for(unsigned i = 0; i<formatCount; ++i)
+        {
+            const std::uint64_t type = reader.readUleb();
+            formats.push_back(std::make_pair(type, reader.readUleb()));
+        }
+        const std::uint64_t count = reader.readUleb();
+        Unit unit;
+        unit.is64 = is64;
+        for(std::uint64_t i = 0; i<count && reader.isValid(); ++i)
+        {
+            const char *path = nullptr;
+            std::uint64_t directory = 0;
+            for(const auto &format: formats)
+            {
+                AttributeValue value;
+                if(!readAttribute(reader, format.second, 0, is64,
+                                  sizeof(void *), 5, &value))
+                {
+                    return;
+                }
+                if(format.first==DW_LNCT_path)
+                {
+                    path = resolveString(unit, value);
+                }
+                else if(format.first==DW_LNCT_directory_index)
+                {
+                    directory = value.value;
+                }
+            }
+            addEntry(path ? path : "", directory);
+        }
+    }
+
+    /*
+     * Directory 0 is the unit directory and files are numbered from 1
+     * before DWARF 5
+     */
+    void readFileTableV4(DataReader &reader, const std::string &unitDirectory,
+                         std::vector<std::uint32_t> *files)
+    {
+        std::vector<std::string> directories(1, unitDirectory);
+        while(reader.isValid())
+        {
+            const char *directory = reader.readString();
+            if(directory==nullptr || *directory=='\0')
+            {
+                break;
+            }
+            directories.push_back(joinPath(unitDirectory, directory));
+        }
+        files->push_back(InvalidFile);
+        while(reader.isValid())
+        {
+            const char *name = reader.readString();
+            if(name==nullptr || *name=='\0')
+            {
+                break;
+            }
+            const std::uint64_t directory = reader.readUleb();
+            reader.readUleb();
+            reader.readUleb();
+            files->push_back(addFile((directory<directories.size())
+                                        ? directories[directory]
+                                        : unitDirectory, name));
+        }
+    }
+
+    std::uint32_t addFile(const std::string &directory, const char *name)
+    {
+        const std::string path = joinPath(directory, name);
+        auto file = fileIndices_.find(path);
+        if(file!=fileIndices_.end())
+        {
+            return file->second;
+        }
+        const std::uint32_t index
+                = static_cast<std::uint32_t>(table_.files_.size());
+        table_.files_.push_back(path);
+        fileIndices_.insert(std::make_pair(path, index));
+        return index;
+    }
+
+    /*
+     * Runs line number state machine, rows of sequences of functions
+     * removed by linker are dropped
+     */
+    void decodeLineProgram(DataReader &reader, std::uint8_t addressSize,
+                           std::uint8_t minimumInstructionLength,
+                           std::int8_t lineBase, std::uint8_t lineRange,
+                           std::uint8_t opcodeBase,
+                           const std::vector<std::uint8_t> &opcodeLengths,
+                           const std::vector<std::uint32_t> &files)
+    {
+        std::vector<Row> &rows = table_.rows_.getStorage();
+        std::uint64_t address = 0;
+        std::uint64_t file = 1;
+        std::int64_t line = 1;
+        std::size_t sequenceBegin = rows.size();
+        auto addRow = [&]()
+        {
+            const Row row = {
+                static_cast<std::uintptr_t>(address),
+                (file<files.size()) ? files[file] : InvalidFile,
+                static_cast<std::uint32_t>(line)
+            };
+            rows.push_back(row);
+        };
+        while(!reader.isAtEnd() && reader.isValid())
+        {
+            const std::uint8_t opcode = reader.read<std::uint8_t>();
+            if(opcode>=opcodeBase)
+            {
+                const unsigned adjusted = opcode-opcodeBase;
+                address += (adjusted/lineRange)*minimumInstructionLength;
+                line += lineBase+static_cast<int>(adjusted%lineRange);
+                addRow();
+                continue;
+            }
+            switch(opcode)
+            {
+                case 0:
+                {
+                    const std::uint64_t length = reader.readUleb();
+                    if(length==0 || length>reader.getRemaining())
+                    {
+                        return;
+                    }
+                    const char *next = reader.getPosition()+length;
+                    const std::uint8_t extended = reader.read<std::uint8_t>();
+                    if(extended==DW_LNE_end_sequence)
+                    {
+                        if(rows.size()>sequenceBegin
+                           && rows[sequenceBegin].address==0)
+                        {
+                            rows.resize(sequenceBegin);
+                        }
+                        else
+                        {
+                            rows.push_back({static_cast<std::uintptr_t>(
+                                                address), InvalidFile, 0});
+                        }
+                        sequenceBegin = rows.size();
+                        address = 0;
+                        file = 1;
+                        line = 1;
+                    }
+                    else if(extended==DW_LNE_set_address)
+                    {
+                        address = reader.readUnsigned(
+                                    (length-1==4 || length-1==8)
+                                        ? static_cast<std::size_t>(length-1)
+                                        : addressSize);
+                    }
+                    reader.skip(static_cast<std::uint64_t>(
+                                    next-reader.getPosition()));
+                    break;
+                }
+                case DW_LNS_copy:
+                    addRow();
+                    break;
+                case DW_LNS_advance_pc:
+                    address += reader.readUleb()*minimumInstructionLength;
+                    break;
+                case DW_LNS_advance_line:
+                    line += reader.readSleb();
+                    break;
+                case DW_LNS_set_file:
+                    file = reader.readUleb();
+                    break;
+                case DW_LNS_const_add_pc:
+                    address += ((255-opcodeBase)/lineRange)
+                                *minimumInstructionLength;
+                    break;
+                case DW_LNS_fixed_advance_pc:
+                    address += reader.read<std::uint16_t>();
+                    break;
+                default:
+                    for(unsigned i = 0; i<opcodeLengths[opcode-1]; ++i)
+                    {
+                        reader.readUleb();
+                    }
+                    break;
+            }
+        }
+    }
+
+    DwarfLineTable &table_;
+    ElfImage::Section info_;
+    ElfImage::Section abbrev_;
+    ElfImage::Section line_;
+    ElfImage::Section lineStr_;
+    ElfImage::Section str_;
+    ElfImage::Section strOffsets_;
+    ElfImage::Section addr_;
+    ElfImage::Section ranges_;
+    ElfImage::Section rngLists_;
+    std::vector<Abbreviation> abbreviations_;
+    std::vector<AddressRange> rangesBuffer_;
+    std::vector<SubprogramName> subprograms_;
+    std::vector<std::uint64_t> callOrigins_;
+    std::map<std::uint64_t, std::vector<std::uint32_t>> linePrograms_;
+    std::map<std::string, std::uint32_t> fileIndices_;
+};
+
+const std::uint32_t DwarfLineTable::InvalidFile;
+const std::uint32_t DwarfLineTable::InvalidName;
+
+const DwarfLineTable &DwarfLineTable::getTable(const char *modulePath)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::unique_ptr<DwarfLineTable>> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<DwarfLineTable> &table = tables[modulePath];
+    if(!table)
+    {
+        table.reset(new DwarfLineTable(modulePath));
+    }
+    return *table;
+}
+
+std::unique_ptr<DwarfLineTable> DwarfLineTable::create(const char *modulePath)
+{
+    return std::unique_ptr<DwarfLineTable>(new DwarfLineTable(modulePath));
+}
+
+DwarfLineTable::DwarfLineTable(const char *modulePath)
+    :image_(openDebugImage(modulePath))
+{
+    if(!image_.isValid())
+    {
+        return;
+    }
+    const std::string buildId = image_.getBuildId();
+    if(loadCache(buildId))
+    {
+        image_ = ElfImage();
+        return;
+    }
+    Loader loader(*this);
+    loader.load();
+    writeCache(buildId);
+}
+
+DwarfLineTable::~DwarfLineTable()
+{
+}
+
+bool DwarfLineTable::isEmpty() const
+{
+    return rows_.empty();
+}
+
+bool DwarfLineTable::isCached() const
+{
+    return cache_.isValid();
+}
+
+/*
+ * Rows and functions are searched in the cache, inlined calls refer to
+ * names by offset so they are copied. Names and files are sequences of
+ * terminated strings.
+ */
+bool DwarfLineTable::loadCache(const std::string &buildId)
+{
+    SymbolCacheFile cache = SymbolCacheFile::open(buildId,
+                                            SymbolCacheFile::Kind::Lines);
+    const SymbolCacheFile::Section rows = cache.getSection(0);
+    const SymbolCacheFile::Section functions = cache.getSection(1);
+    const SymbolCacheFile::Section calls = cache.getSection(2);
+    const SymbolCacheFile::Section files = cache.getSection(3);
+    const SymbolCacheFile::Section names = cache.getSection(4);
+    if(!cache.isValid() || rows.size%sizeof(Row)!=0
+       || functions.size%sizeof(Function)!=0
+       || calls.size%sizeof(CachedCall)!=0
+       || (files.size>0 && files.data[files.size-1]!='\0')
+       || (names.size>0 && names.data[names.size-1]!='\0'))
+    {
+        return false;
+    }
+    std::vector<std::string> fileNames;
+    for(const char *file = files.data; file!=files.data+files.size;
+        file += std::strlen(file)+1)
+    {
+        fileNames.push_back(file);
+    }
+    const std::size_t callCount = calls.size/sizeof(CachedCall);
+    std::vector<InlinedCall> inlinedCalls(callCount);
+    for(std::size_t i = 0; i<callCount; ++i)
+    {
+        CachedCall call;
+        std::memcpy(&call, calls.data+i*sizeof(CachedCall), sizeof(call));
+        if(call.function!=InvalidName && call.function>=names.size)
+        {
+            return false;
+        }
+        inlinedCalls[i] = {call.begin, call.end,
+                           (call.function==InvalidName)
+                                ? nullptr : names.data+call.function,
+                           call.depth, call.file, call.line};
+    }
+    cache_ = std::move(cache);
+    files_ = std::move(fileNames);
+    rows_.map(rows);
+    functions_.map(functions);
+    calls_ = std::move(inlinedCalls);
+    return true;
+}
+
+void DwarfLineTable::writeCache(const std::string &buildId) const
+{
+    if(SymbolCacheFile::getDirectory().empty() || buildId.empty()
+       || rows_.empty())
+    {
+        return;
+    }
+    std::string files;
+    for(const auto &file: files_)
+    {
+        files.append(file.c_str(), file.size()+1);
+    }
+    std::string names;
+    std::map<const char *, std::uint32_t> nameOffsets;
+    std::vector<CachedCall> calls;
+    calls.reserve(calls_.size());
+    for(const auto &inlinedCall: calls_)
+    {
+        CachedCall call = {inlinedCall.begin, inlinedCall.end, InvalidName,
+                           inlinedCall.depth, inlinedCall.file,
+                           inlinedCall.line};
+        if(inlinedCall.function)
+        {
+            auto inserted = nameOffsets.insert(std::make_pair(
+                                inlinedCall.function,
+                                static_cast<std::uint32_t>(names.size())));
+            if(inserted.second)
+            {
+                names.append(inlinedCall.function,
+                             std::strlen(inlinedCall.function)+1);
+            }
+            call.function = inserted.first->second;
+        }
+        calls.push_back(call);
+    }
+    SymbolCacheFile::Section sections[5];
+    sections[0] = rows_.getSection();
+    sections[1] = functions_.getSection();
+    sections[2].data = reinterpret_cast<const char *>(calls.data());
+    sections[2].size = calls.size()*sizeof(CachedCall);
+    sections[3].data = files.data();
+    sections[3].size = files.size();
+    sections[4].data = names.data();
+    sections[4].size = names.size();
+    SymbolCacheFile::write(buildId, SymbolCacheFile::Kind::Lines
+                           , sections, 5);
+}
+
+const char *DwarfLineTable::getFile(std::uint32_t file) const
+{
+    return (file<files_.size()) ? files_[file].c_str() : nullptr;
+}
+
+/*
+ * Line table gives location in the innermost inlined function, each
+ * inlined call gives location of the call in its caller
+ */
+std::size_t DwarfLineTable::findLocations(std::uintptr_t address,
+                                          SourceLocation *locations,
+                                          std::size_t maxLocations) const
+{
+    if(maxLocations==0)
+    {
+        return 0;
+    }
+    auto row = std::upper_bound(rows_.begin(), rows_.end(), address,
+                                [](std::uintptr_t searched, const Row &row)
+                                {
+                                    return (searched<row.address);
+                                });
+    if(row==rows_.begin() || (--row)->file==InvalidFile)
+    {
+        return 0;
+    }
+    locations[0] = SourceLocation();
+    locations[0].file = getFile(row->file);
+    locations[0].line = row->line;
+    std::size_t count = 1;
+
+    auto function = std::upper_bound(functions_.begin(), functions_.end(),
+                                     address,
+                                     [](std::uintptr_t searched,
+                                        const Function &function)
+                                     {
+                                         return (searched<function.begin);
+                                     });
+    if(function==functions_.begin() || (--function)->end<=address)
+    {
+        return count;
+    }
+    //calls are stored in the order of their nesting, outermost first
+    const InlinedCall *chain[16];
+    std::size_t depth = 0;
+    for(std::uint32_t i = function->firstCall; i<function->lastCall; ++i)
+    {
+        const InlinedCall &call = calls_[i];
+        if(call.begin<=address && address<call.end
+           && call.depth==depth+1 && depth<sizeof(chain)/sizeof(chain[0]))
+        {
+            chain[depth++] = &call;
+        }
+    }
+    for(std::size_t i = depth; i>0 && count<maxLocations; --i)
+    {
+        const InlinedCall &call = *chain[i-1];
+        locations[count-1].function = call.function;
+        locations[count] = SourceLocation();
+        locations[count].file = getFile(call.file);
+        locations[count].line = call.line;
+        ++count;
+    }
+    return count;
+}
+
+} //internal
+} //cppassert
+
+#endif /* CPP_ASSERT_HAVE_DWARF_LINES */
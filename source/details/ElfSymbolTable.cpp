@@ -0,0 +1,511 @@
+#include <cppassert/details/ElfSymbolTable.hpp>
+#include <cppassert/details/ModuleMap.hpp>
+
+#ifdef CPP_ASSERT_HAVE_ELF_SYMBOLS
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
+#include <link.h>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace cppassert
+{
+namespace internal
+{
+
+namespace
+{
+using ElfHeader = ElfW(Ehdr);
+using SectionHeader = ElfW(Shdr);
+using ElfSymbol = ElfW(Sym);
+
+const unsigned char ELF_CLASS = (sizeof(void *)==8) ? ELFCLASS64
+                                                    : ELFCLASS32;
+
+/*
+ * Maps whole file read only, mapping outlives the file descriptor
+ */
+const char *mapFile(const char *path, std::size_t *size)
+{
+    const int file = ::open(path, O_RDONLY | O_CLOEXEC);
+    if(file<0)
+    {
+        return nullptr;
+    }
+    struct stat status;
+    void *image = MAP_FAILED;
+    if(::fstat(file, &status)==0 && status.st_size>0)
+    {
+        *size = static_cast<std::size_t>(status.st_size);
+        image = ::mmap(nullptr, *size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    ::close(file);
+    return (image==MAP_FAILED) ? nullptr : static_cast<const char *>(image);
+}
+
+bool isInside(std::size_t offset, std::size_t length, std::size_t size)
+{
+    return (offset<=size && length<=size-offset);
+}
+
+bool isValidHeader(const char *image, std::size_t size)
+{
+    if(size<sizeof(ElfHeader))
+    {
+        return false;
+    }
+    const ElfHeader *header = reinterpret_cast<const ElfHeader *>(image);
+    return (std::memcmp(header->e_ident, ELFMAG, SELFMAG)==0
+            && header->e_ident[EI_CLASS]==ELF_CLASS
+            && header->e_shentsize==sizeof(SectionHeader)
+            && isInside(header->e_shoff,
+                        header->e_shnum*sizeof(SectionHeader), size));
+}
+
+} //anonymous
+
+ElfImage::ElfImage(const char *path)
+{
+    data_ = mapFile(path, &size_);
+    if(data_!=nullptr && !isValidHeader(data_, size_))
+    {
+        unmap();
+    }
+}
+
+ElfImage::ElfImage(ElfImage &&other) noexcept
+    :data_(other.data_), size_(other.size_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+ElfImage &ElfImage::operator=(ElfImage &&other) noexcept
+{
+    if(this!=&other)
+    {
+        unmap();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+    return (*this);
+}
+
+ElfImage::~ElfImage()
+{
+    unmap();
+}
+
+void ElfImage::unmap()
+{
+    if(data_!=nullptr)
+    {
+        ::munmap(const_cast<char *>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+bool ElfImage::isValid() const
+{
+    return (data_!=nullptr);
+}
+
+const char *ElfImage::getData() const
+{
+    return data_;
+}
+
+std::size_t ElfImage::getSize() const
+{
+    return size_;
+}
+
+std::size_t ElfImage::getSectionCount() const
+{
+    if(data_==nullptr)
+    {
+        return 0;
+    }
+    return reinterpret_cast<const ElfHeader *>(data_)->e_shnum;
+}
+
+bool ElfImage::getSection(std::size_t index, Section *section) const
+{
+    if(index>=getSectionCount())
+    {
+        return false;
+    }
+    const ElfHeader *header = reinterpret_cast<const ElfHeader *>(data_);
+    const SectionHeader &sectionHeader = reinterpret_cast<const SectionHeader *>(
+                                            data_+header->e_shoff)[index];
+    if(sectionHeader.sh_type==SHT_NOBITS
+       || (sectionHeader.sh_flags & SHF_COMPRESSED)!=0
+       || !isInside(sectionHeader.sh_offset, sectionHeader.sh_size, size_))
+    {
+        return false;
+    }
+    section->name = nullptr;
+    Section names;
+    if(header->e_shstrndx!=index
+       && getSection(header->e_shstrndx, &names)
+       && sectionHeader.sh_name<names.size)
+    {
+        section->name = names.data+sectionHeader.sh_name;
+    }
+    section->type = sectionHeader.sh_type;
+    section->link = sectionHeader.sh_link;
+    section->entrySize = sectionHeader.sh_entsize;
+    section->data = data_+sectionHeader.sh_offset;
+    section->size = sectionHeader.sh_size;
+    return true;
+}
+
+bool ElfImage::findSection(const char *name, Section *section) const
+{
+    const std::size_t count = getSectionCount();
+    for(std::size_t i = 0; i<count; ++i)
+    {
+        //section name table isn't terminated by the file end
+        if(getSection(i, section) && section->name!=nullptr
+           && std::strncmp(section->name, name,
+                           static_cast<std::size_t>(data_+size_
+                                                    -section->name))==0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Note has header of name size, description size and type followed by
+ * name "GNU" and build-id bytes, each aligned to 4 bytes
+ */
+std::string ElfImage::getBuildId() const
+{
+    static const char digits[] = "0123456789abcdef";
+    Section section;
+    if(!findSection(".note.gnu.build-id", &section)
+       || section.size<sizeof(ElfW(Nhdr)))
+    {
+        return std::string();
+    }
+    ElfW(Nhdr) note;
+    std::memcpy(&note, section.data, sizeof(note));
+    const std::size_t nameSize = (note.n_namesz+3) & ~3u;
+    if(note.n_type!=NT_GNU_BUILD_ID
+       || !isInside(sizeof(note)+nameSize, note.n_descsz, section.size))
+    {
+        return std::string();
+    }
+    const char *buildId = section.data+sizeof(note)+nameSize;
+    std::string result;
+    for(std::size_t i = 0; i<note.n_descsz; ++i)
+    {
+        const std::uint8_t byte = static_cast<std::uint8_t>(buildId[i]);
+        result += digits[byte>>4];
+        result += digits[byte & 0xf];
+    }
+    return result;
+}
+
+ElfSymbolIndex::ElfSymbolIndex(const char *path)
+    :image_(path)
+{
+    if(!image_.isValid())
+    {
+        return;
+    }
+    const std::string buildId = image_.getBuildId();
+    if(loadCache(buildId))
+    {
+        image_ = ElfImage();
+        return;
+    }
+    loadSymbols();
+    writeCache(buildId);
+}
+
+/*
+ * Function symbols of `.symtab` and `.dynsym` are merged, symbol defined
+ * in both of them is stored once. Names are stored as offsets into the
+ * mapped file, so files larger than 4GB are skipped.
+ */
+void ElfSymbolIndex::loadSymbols()
+{
+    if(image_.getSize()>UINT32_MAX)
+    {
+        image_ = ElfImage();
+        return;
+    }
+    names_ = image_.getData();
+    std::vector<Entry> &entries = entries_.getStorage();
+    const std::size_t sectionCount = image_.getSectionCount();
+    for(std::size_t i = 0; i<sectionCount; ++i)
+    {
+        ElfImage::Section section;
+        ElfImage::Section strings;
+        if(!image_.getSection(i, &section)
+           || (section.type!=SHT_SYMTAB && section.type!=SHT_DYNSYM)
+           || section.entrySize!=sizeof(ElfSymbol)
+           || !image_.getSection(section.link, &strings))
+        {
+            continue;
+        }
+        const ElfSymbol *symbols
+                = reinterpret_cast<const ElfSymbol *>(section.data);
+        const std::size_t count = section.size/sizeof(ElfSymbol);
+        const std::size_t stringsOffset
+                = static_cast<std::size_t>(strings.data-image_.getData());
+        entries.reserve(entries.size()+count);
+        for(std::size_t j = 0; j<count; ++j)
+        {
+            const ElfSymbol &symbol = symbols[j];
+            const unsigned type = ELF64_ST_TYPE(symbol.st_info);
+            if((type!=STT_FUNC && type!=STT_GNU_IFUNC)
+               || symbol.st_shndx==SHN_UNDEF || symbol.st_value==0
+               || symbol.st_name==0 || symbol.st_name>=strings.size)
+            {
+                continue;
+            }
+            Entry entry;
+            entry.address = static_cast<std::uintptr_t>(symbol.st_value);
+            entry.size = static_cast<std::uint32_t>(
+                            std::min<ElfW(Xword)>(symbol.st_size, UINT32_MAX));
+            entry.nameOffset = static_cast<std::uint32_t>(stringsOffset
+                                                          +symbol.st_name);
+            entries.push_back(entry);
+        }
+    }
+    //symbol with size is preferred over alias without it
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &first, const Entry &second)
+              {
+                  return (first.address<second.address
+                          || (first.address==second.address
+                              && first.size>second.size));
+              });
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              [](const Entry &first, const Entry &second)
+                              {
+                                  return (first.address==second.address);
+                              }),
+                  entries.end());
+    entries.shrink_to_fit();
+}
+
+/*
+ * Cache has sorted entries followed by names they refer to, names have
+ * to be terminated within the cache
+ */
+bool ElfSymbolIndex::loadCache(const std::string &buildId)
+{
+    SymbolCacheFile cache = SymbolCacheFile::open(buildId,
+                                            SymbolCacheFile::Kind::Symbols);
+    const SymbolCacheFile::Section entries = cache.getSection(0);
+    const SymbolCacheFile::Section names = cache.getSection(1);
+    if(!cache.isValid() || entries.size%sizeof(Entry)!=0
+       || names.size==0 || names.data[names.size-1]!='\0')
+    {
+        return false;
+    }
+    const Entry *first = reinterpret_cast<const Entry *>(entries.data);
+    const Entry *last = first+entries.size/sizeof(Entry);
+    for(const Entry *entry = first; entry!=last; ++entry)
+    {
+        if(entry->nameOffset>=names.size)
+        {
+            return false;
+        }
+    }
+    cache_ = std::move(cache);
+    entries_.map(entries);
+    names_ = names.data;
+    return true;
+}
+
+void ElfSymbolIndex::writeCache(const std::string &buildId) const
+{
+    if(SymbolCacheFile::getDirectory().empty() || buildId.empty()
+       || entries_.empty())
+    {
+        return;
+    }
+    std::vector<Entry> entries(entries_.begin(), entries_.end());
+    std::string names;
+    for(Entry &entry: entries)
+    {
+        const char *name = names_+entry.nameOffset;
+        entry.nameOffset = static_cast<std::uint32_t>(names.size());
+        names.append(name, std::strlen(name)+1);
+    }
+    SymbolCacheFile::Section sections[2];
+    sections[0].data = reinterpret_cast<const char *>(entries.data());
+    sections[0].size = entries.size()*sizeof(Entry);
+    sections[1].data = names.data();
+    sections[1].size = names.size();
+    SymbolCacheFile::write(buildId, SymbolCacheFile::Kind::Symbols
+                           , sections, 2);
+}
+
+/*
+ * Return address may point just past the end of function which calls
+ * noreturn function, so the symbol containing previous byte is searched
+ */
+const char *ElfSymbolIndex::findSymbol(std::uintptr_t address,
+                                       std::size_t *offset) const
+{
+    auto entry = std::upper_bound(entries_.begin(), entries_.end(),
+                                  address-1,
+                                  [](std::uintptr_t searched,
+                                     const Entry &candidate)
+                                  {
+                                      return (searched<candidate.address);
+                                  });
+    if(entry==entries_.begin())
+    {
+        return nullptr;
+    }
+    --entry;
+    if(entry->size!=0 && address-1>=entry->address+entry->size)
+    {
+        return nullptr;
+    }
+    *offset = address-entry->address;
+    return names_+entry->nameOffset;
+}
+
+bool ElfSymbolIndex::isEmpty() const
+{
+    return entries_.empty();
+}
+
+bool ElfSymbolIndex::isCached() const
+{
+    return cache_.isValid();
+}
+
+/*
+ * Replaced tables are leaked on purpose, names found in them may still be
+ * referenced by readers
+ */
+const ElfSymbolTable &ElfSymbolTable::getInstance()
+{
+    static std::mutex *mutex = new std::mutex();
+    static const ElfSymbolTable *table = nullptr;
+    std::shared_ptr<const ModuleMap> moduleMap = ModuleMap::getCurrent();
+    std::lock_guard<std::mutex> lock(*mutex);
+    if(table==nullptr || table->moduleMap_!=moduleMap)
+    {
+        table = new ElfSymbolTable(std::move(moduleMap), table);
+    }
+    return *table;
+}
+
+ElfSymbolTable::ElfSymbolTable(std::shared_ptr<const ModuleMap> moduleMap,
+                               const ElfSymbolTable *previous)
+    :moduleMap_(std::move(moduleMap))
+{
+    ::dl_iterate_phdr(&ElfSymbolTable::addModule, this);
+    for(auto &module: modules_)
+    {
+        if(previous!=nullptr)
+        {
+            for(const auto &loaded: previous->modules_)
+            {
+                if(loaded.base==module.base && loaded.begin==module.begin
+                   && loaded.end==module.end && loaded.path==module.path)
+                {
+                    module.symbols = loaded.symbols;
+                    break;
+                }
+            }
+        }
+        if(!module.symbols)
+        {
+            module.symbols = std::make_shared<const ElfSymbolIndex>(
+                                                    module.path.c_str());
+        }
+    }
+}
+
+ElfSymbolTable::~ElfSymbolTable()
+{
+}
+
+/*
+ * Only executable segments are recorded, return addresses never point
+ * elsewhere. Executable has empty name, it's read through /proc/self/exe.
+ */
+int ElfSymbolTable::addModule(dl_phdr_info *info, std::size_t , void *table)
+{
+    Module module;
+    module.base = static_cast<std::uintptr_t>(info->dlpi_addr);
+    module.begin = UINTPTR_MAX;
+    for(ElfW(Half) i = 0; i<info->dlpi_phnum; ++i)
+    {
+        const ElfW(Phdr) &segment = info->dlpi_phdr[i];
+        if(segment.p_type!=PT_LOAD || (segment.p_flags & PF_X)==0)
+        {
+            continue;
+        }
+        const std::uintptr_t begin = module.base+segment.p_vaddr;
+        module.begin = std::min(module.begin, begin);
+        module.end = std::max<std::uintptr_t>(module.end,
+                                              begin+segment.p_memsz);
+    }
+    if(module.begin>=module.end)
+    {
+        return 0;
+    }
+    if(info->dlpi_name==nullptr || info->dlpi_name[0]=='\0')
+    {
+        char path[PATH_MAX];
+        const ssize_t length = ::readlink("/proc/self/exe", path,
+                                          sizeof(path)-1);
+        module.path.assign(path, (length>0) ? length : 0);
+    }
+    else
+    {
+        module.path = info->dlpi_name;
+    }
+    static_cast<ElfSymbolTable *>(table)->modules_.push_back(
+                                                        std::move(module));
+    return 0;
+}
+
+bool ElfSymbolTable::findSymbol(const void *address, Symbol *symbol) const
+{
+    const std::uintptr_t value = reinterpret_cast<std::uintptr_t>(address);
+    for(const auto &module: modules_)
+    {
+        if(value<=module.begin || value>module.end)
+        {
+            continue;
+        }
+        const std::uintptr_t relative = value-module.base;
+        symbol->module = module.path.c_str();
+        symbol->offset = relative;
+        symbol->moduleAddress = relative;
+        symbol->name = module.symbols->findSymbol(relative, &symbol->offset);
+        return true;
+    }
+    return false;
+}
+
+std::size_t ElfSymbolTable::getModuleCount() const
+{
+    return modules_.size();
+}
+
+} //internal
+} //cppassert
+
+#endif /* CPP_ASSERT_HAVE_ELF_SYMBOLS */
@@ -1,42 +1,203 @@
 #include <cppassert/CppAssert.hpp>
+#include <cppassert/MessageSink.hpp>
 #include <cppassert/details/Helpers.hpp>
+#include <cppassert/details/StackTrace.hpp>
+#include <cppassert/details/WarmUp.hpp>
+#include <cstdlib>
+#include <cstring>
 
 namespace cppassert
 {
 namespace internal
 {
 
-std::string getBoolAssertionFailureMessage(
+std::uint8_t assertionLevelThreshold =
+                            static_cast<std::uint8_t>(AssertionLevel::Debug);
+
+static const struct
+{
+    const char *name;
+    AssertionLevel level;
+} LEVEL_NAMES[] =
+{
+    {"always", AssertionLevel::Always},
+    {"cheap", AssertionLevel::Cheap},
+    {"debug", AssertionLevel::Debug},
+    {"audit", AssertionLevel::Audit}
+};
+
+static void setAssertionLevelFromEnvironment()
+{
+    const char *variable = std::getenv("CPPASSERT_LEVEL");
+    if(variable==nullptr)
+    {
+        return;
+    }
+    for(const auto &entry: LEVEL_NAMES)
+    {
+        if(std::strcmp(entry.name, variable)==0)
+        {
+            setAssertionLevel(entry.level);
+            return;
+        }
+    }
+}
+
+void setAssertionLevel(AssertionLevel level)
+{
+    storeRelaxed(assertionLevelThreshold, static_cast<std::uint8_t>(level));
+}
+
+AssertionLevel getAssertionLevel()
+{
+    return static_cast<AssertionLevel>(
+                loadRelaxed(assertionLevelThreshold));
+}
+
+/*
+ * Every assertion failure path refers to this translation unit so it's
+ * always linked in when assertions are used. CPPASSERT_DISABLE and
+ * CPPASSERT_LEVEL are applied during static initialization, assertions
+ * evaluated earlier than that are not affected. CPPASSERT_WARMUP warms up
+ * stack traces at the same time.
+ */
+static struct SiteStateInitializer
+{
+    SiteStateInitializer()
+    {
+        setAssertionLevelFromEnvironment();
+        disableSitesFromEnvironment();
+        warmUpFromEnvironment();
+    }
+} siteStateInitializer;
+
+/*
+ * Failure messages are formatted directly into message of the failure,
+ * no intermediate string is built unless formatter returns strings
+ */
+static AssertionMessage getBoolAssertionFailureMessage(
     const char* expressionText,
     const char* actualPredicateValue,
     const char* expectedPredicateValue)
 {
-    return CppAssert::getInstance()->formatBoolFailureMessage(expressionText
+    AssertionMessage message;
+    MessageSink sink(message);
+    CppAssert::getInstance()->formatBoolFailureMessage(sink
+                                        , expressionText
                                         , actualPredicateValue
                                         , expectedPredicateValue);
+    return message;
 }
 
-std::string getPredicateAssertionFailureMessage(
-    const char* predicate,
-    const char* value1Text,
-    const char* value2Text,
-    AssertionMessage &&value1,
-    AssertionMessage &&value2)
+static AssertionMessage getPredicateAssertionFailureMessage(
+    const AssertionSite *site,
+    const AssertionMessage &value1,
+    const AssertionMessage &value2)
 {
-    return CppAssert::getInstance()->formatPredicateFailureMessage(predicate
-                                        , value1Text
-                                        , value2Text
-                                        , value1.str()
-                                        , value2.str());
+    AssertionMessage message;
+    MessageSink sink(message);
+    CppAssert::getInstance()->formatPredicateFailureMessage(sink
+                                        , site->getPredicate()
+                                        , site->getExpression()
+                                        , site->getSecondExpression()
+                                        , value1
+                                        , value2);
+    return message;
 }
 
-std::string getAssertionFailureMessage(const char *statement)
+static AssertionMessage getAssertionFailureMessage(const char *statement)
 {
-    return CppAssert::getInstance()->formatStatementFailureMessage(statement);
+    AssertionMessage message;
+    MessageSink sink(message);
+    CppAssert::getInstance()->formatStatementFailureMessage(sink, statement);
+    return message;
 }
 
-} //internal
-} //asrt
+/*
+ * Failure paths below are library code, their frames are recognized by
+ * address. Frames of assertion site side of the path are not:
+ * cold lambdas streaming the message are compiled into client code and
+ * onPredicateAssertionFailure() instantiations are unless compiler places
+ * them in library code section, see CPP_ASSERT_HEADER_LIBRARY_CODE.
+ */
+const std::uint32_t MESSAGE_FRAMES = 1;
+#ifdef CPP_ASSERT_HAVE_HEADER_LIBRARY_SECTION
+const std::uint32_t PREDICATE_FRAMES = 0;
+#else
+const std::uint32_t PREDICATE_FRAMES = 1;
+#endif
+const std::uint32_t FAILURE_PATH_FRAMES = static_cast<std::uint32_t>(
+                                                getLibraryFrames(1));
 
+CPP_ASSERT_LIBRARY_CODE
+void onAssertionFailure(const AssertionSite *site)
+{
+    AssertionFailure(site, getAssertionFailureMessage(site->getExpression()))
+        .onAssertionFailure(AssertionMessage(), FAILURE_PATH_FRAMES);
+}
 
+CPP_ASSERT_LIBRARY_CODE
+void onAssertionFailure(const AssertionSite *site,
+    const AssertionMessage &message)
+{
+    AssertionFailure(site, getAssertionFailureMessage(site->getExpression()))
+        .onAssertionFailure(message, FAILURE_PATH_FRAMES+MESSAGE_FRAMES);
+}
+
+/*
+ * Actual and expected values of CPP_ASSERT_{TRUE|FALSE} are implied
+ * by kind of site
+ */
+static AssertionMessage getBoolAssertionFailureMessage(const AssertionSite *site)
+{
+    const bool expected = (site->getKind()==AssertionKind::True);
+    return getBoolAssertionFailureMessage(site->getExpression(),
+                                          expected ? "false" : "true",
+                                          expected ? "true" : "false");
+}
+
+CPP_ASSERT_LIBRARY_CODE
+void onBoolAssertionFailure(const AssertionSite *site)
+{
+    AssertionFailure(site, getBoolAssertionFailureMessage(site))
+        .onAssertionFailure(AssertionMessage(), FAILURE_PATH_FRAMES);
+}
+
+CPP_ASSERT_LIBRARY_CODE
+void onBoolAssertionFailure(const AssertionSite *site,
+    const AssertionMessage &message)
+{
+    AssertionFailure(site, getBoolAssertionFailureMessage(site))
+        .onAssertionFailure(message, FAILURE_PATH_FRAMES+MESSAGE_FRAMES);
+}
+
+/*
+ * Called from onPredicateAssertionFailure() template
+ */
+CPP_ASSERT_LIBRARY_CODE
+void reportPredicateAssertionFailure(const AssertionSite *site,
+    const AssertionMessage &value1,
+    const AssertionMessage &value2)
+{
+    AssertionFailure(site, getPredicateAssertionFailureMessage(site, value1,
+                                                               value2))
+        .onAssertionFailure(AssertionMessage()
+                            , FAILURE_PATH_FRAMES+PREDICATE_FRAMES);
+}
+
+CPP_ASSERT_LIBRARY_CODE
+void reportPredicateAssertionFailure(const AssertionSite *site,
+    const AssertionMessage &value1,
+    const AssertionMessage &value2,
+    const AssertionMessage &message)
+{
+    AssertionFailure(site, getPredicateAssertionFailureMessage(site, value1,
+                                                               value2))
+        .onAssertionFailure(message
+                            , FAILURE_PATH_FRAMES+PREDICATE_FRAMES
+                              +MESSAGE_FRAMES);
+}
+
+} //internal
+} //asrt
 
@@ -0,0 +1,295 @@
+#include <cppassert/details/ModuleMap.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef CPP_ASSERT_HAVE_MODULE_MAP
+#include <climits>
+#include <cstddef>
+#include <elf.h>
+#include <link.h>
+#include <unistd.h>
+#endif
+
+namespace cppassert
+{
+namespace internal
+{
+
+const std::uint32_t ModuleMap::UnknownModule;
+
+#ifdef CPP_ASSERT_HAVE_MODULE_MAP
+/**
+ * Reads loaded modules with `dl_iterate_phdr`
+ */
+class ModuleMap::Loader
+{
+public:
+    /**
+     * Counters of modules loaded and unloaded since process start
+     */
+    struct Counters
+    {
+        unsigned long long adds = 0;
+        unsigned long long subs = 0;
+        bool isValid = false;
+    };
+
+    /*
+     * Counters are the same in every entry so iteration stops at the
+     * first one, they are missing in headers of old C libraries
+     */
+    static int readCounters(dl_phdr_info *info, std::size_t size
+                            , void *counters)
+    {
+        Counters *result = static_cast<Counters *>(counters);
+        if(size>=offsetof(dl_phdr_info, dlpi_subs)+sizeof(info->dlpi_subs))
+        {
+            result->adds = info->dlpi_adds;
+            result->subs = info->dlpi_subs;
+            result->isValid = true;
+        }
+        return 1;
+    }
+
+    /*
+     * Executable has empty name, it's read through /proc/self/exe
+     */
+    static int addModule(dl_phdr_info *info, std::size_t , void *map)
+    {
+        ModuleMap *result = static_cast<ModuleMap *>(map);
+        const std::uint32_t index = static_cast<std::uint32_t>(
+                                        result->modules_.size());
+        Module module;
+        module.base = static_cast<std::uintptr_t>(info->dlpi_addr);
+        bool isExecutable = false;
+        for(ElfW(Half) i = 0; i<info->dlpi_phnum; ++i)
+        {
+            const ElfW(Phdr) &segment = info->dlpi_phdr[i];
+            if(segment.p_type==PT_NOTE && module.buildId.empty())
+            {
+                module.buildId = readBuildId(
+                            reinterpret_cast<const char *>(
+                                module.base+segment.p_vaddr)
+                            , segment.p_memsz);
+            }
+            else if(segment.p_type==PT_LOAD && (segment.p_flags & PF_X)!=0)
+            {
+                const std::uintptr_t begin = module.base+segment.p_vaddr;
+                result->segments_.push_back(
+                            Segment{begin, begin+segment.p_memsz, index});
+                isExecutable = true;
+            }
+        }
+        if(!isExecutable)
+        {
+            return 0;
+        }
+        if(info->dlpi_name==nullptr || info->dlpi_name[0]=='\0')
+        {
+            char path[PATH_MAX];
+            const ssize_t length = ::readlink("/proc/self/exe", path,
+                                              sizeof(path)-1);
+            module.path.assign(path, (length>0) ? length : 0);
+        }
+        else
+        {
+            module.path = info->dlpi_name;
+        }
+        result->modules_.push_back(std::move(module));
+        return 0;
+    }
+
+private:
+    /*
+     * Notes of loaded segment are read in place, build-id note has
+     * type NT_GNU_BUILD_ID and name "GNU"
+     */
+    static std::string readBuildId(const char *notes, std::size_t size)
+    {
+        static const char HexDigits[] = "0123456789abcdef";
+        std::size_t position = 0;
+        while(position+sizeof(ElfW(Nhdr))<=size)
+        {
+            ElfW(Nhdr) header;
+            std::memcpy(&header, notes+position, sizeof(header));
+            const std::size_t nameOffset = position+sizeof(header);
+            const std::size_t descriptionOffset
+                    = nameOffset+getAligned(header.n_namesz);
+            const std::size_t next
+                    = descriptionOffset+getAligned(header.n_descsz);
+            if(next>size)
+            {
+                break;
+            }
+            if(header.n_type==NT_GNU_BUILD_ID && header.n_namesz==4
+               && std::memcmp(notes+nameOffset, "GNU", 4)==0)
+            {
+                std::string result;
+                for(std::size_t i = 0; i<header.n_descsz; ++i)
+                {
+                    const unsigned char byte = static_cast<unsigned char>(
+                                        notes[descriptionOffset+i]);
+                    result += HexDigits[byte>>4];
+                    result += HexDigits[byte&0xf];
+                }
+                return result;
+            }
+            position = next;
+        }
+        return std::string();
+    }
+
+    static std::size_t getAligned(std::size_t size)
+    {
+        return (size+3)&~static_cast<std::size_t>(3);
+    }
+};
+#endif /* CPP_ASSERT_HAVE_MODULE_MAP */
+
+std::shared_ptr<const ModuleMap> ModuleMap::getCurrent()
+{
+    //never destroyed, snapshot may be taken by destructors of statics
+    static std::mutex *mutex = new std::mutex();
+    static std::shared_ptr<const ModuleMap> &current
+            = *new std::shared_ptr<const ModuleMap>();
+    std::lock_guard<std::mutex> lock(*mutex);
+#ifdef CPP_ASSERT_HAVE_MODULE_MAP
+    static Loader::Counters counters;
+    Loader::Counters now;
+    ::dl_iterate_phdr(&Loader::readCounters, &now);
+    if(current && (!now.isValid
+                   || (now.adds==counters.adds && now.subs==counters.subs)))
+    {
+        return current;
+    }
+    counters = now;
+    std::shared_ptr<ModuleMap> map(new ModuleMap());
+    ::dl_iterate_phdr(&Loader::addModule, map.get());
+    std::sort(map->segments_.begin(), map->segments_.end()
+              , [](const Segment &first, const Segment &second)
+    {
+        return first.begin<second.begin;
+    });
+    current = std::move(map);
+#else
+    if(!current)
+    {
+        current.reset(new ModuleMap());
+    }
+#endif
+    return current;
+}
+
+ModuleMap::ModuleMap()
+{
+}
+
+ModuleMap::~ModuleMap()
+{
+}
+
+std::size_t ModuleMap::getModuleCount() const
+{
+    return modules_.size();
+}
+
+const ModuleMap::Module &ModuleMap::getModule(std::size_t index) const
+{
+    if(index>=modules_.size())
+    {
+        throw std::out_of_range("ModuleMap module index out of range");
+    }
+    return modules_[index];
+}
+
+ModuleMap::Frame ModuleMap::findFrame(const void *address) const
+{
+    Frame result;
+    const std::uintptr_t value = reinterpret_cast<std::uintptr_t>(address);
+    result.offset = value;
+    auto segment = std::upper_bound(segments_.begin(), segments_.end()
+                                    , value
+                                    , [](std::uintptr_t value
+                                         , const Segment &segment)
+    {
+        return value<segment.begin;
+    });
+    if(segment==segments_.begin())
+    {
+        return result;
+    }
+    --segment;
+    if(value<segment->end)
+    {
+        result.module = segment->module;
+        result.offset = value-modules_[segment->module].base;
+    }
+    return result;
+}
+
+std::string ModuleMap::formatFrames(const StackTrace &frames) const
+{
+    std::string result;
+    MessageSink sink(result);
+    appendFrames(frames, sink);
+    return result;
+}
+
+void ModuleMap::appendFrames(const StackTrace &frames, MessageSink &sink) const
+{
+    if(frames.size()==0)
+    {
+        return;
+    }
+    std::vector<Frame> moduleFrames;
+    std::vector<bool> isUsed(modules_.size(), false);
+    for(std::size_t i = 0; i<frames.size(); ++i)
+    {
+        moduleFrames.push_back(findFrame(frames[i].getAddress()));
+        if(moduleFrames.back().module!=UnknownModule)
+        {
+            isUsed[moduleFrames.back().module] = true;
+        }
+    }
+    char line[64];
+    std::snprintf(line, sizeof(line), "cppassert-frames %zu\n"
+                  , frames.size());
+    sink<<line;
+    for(std::size_t i = 0; i<modules_.size(); ++i)
+    {
+        if(!isUsed[i])
+        {
+            continue;
+        }
+        const Module &module = modules_[i];
+        std::snprintf(line, sizeof(line), "module %zu ", i);
+        sink<<line;
+        sink<<(module.buildId.empty() ? "-" : module.buildId.c_str());
+        std::snprintf(line, sizeof(line), " 0x%zx "
+                      , static_cast<std::size_t>(module.base));
+        sink<<line;
+        sink<<module.path<<'\n';
+    }
+    for(const Frame &frame: moduleFrames)
+    {
+        if(frame.module==UnknownModule)
+        {
+            std::snprintf(line, sizeof(line), "frame - 0x%zx\n"
+                          , static_cast<std::size_t>(frame.offset));
+        }
+        else
+        {
+            std::snprintf(line, sizeof(line), "frame %u 0x%zx\n"
+                          , static_cast<unsigned>(frame.module)
+                          , static_cast<std::size_t>(frame.offset));
+        }
+        sink<<line;
+    }
+    sink<<"end\n";
+}
+
+} //internal
+} //cppassert
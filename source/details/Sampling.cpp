@@ -0,0 +1,74 @@
+#include <cppassert/details/Sampling.hpp>
+#include <chrono>
+
+namespace cppassert
+{
+namespace internal
+{
+
+#if defined(__x86_64__) || defined(__i386__) \
+    || defined(_M_X64) || defined(_M_IX86)
+/*
+ * Time stamp counter frequency is measured against steady clock over
+ * a fresh CALIBRATION_INTERVAL window taken on first use. The window is
+ * short so that ticks multiplied by nanoseconds per millisecond can't
+ * overflow, and it doesn't depend on order of static initialization.
+ */
+namespace
+{
+using SteadyClock = std::chrono::steady_clock;
+const std::chrono::milliseconds CALIBRATION_INTERVAL(1);
+
+std::uint64_t calibrateTicksPerMillisecond()
+{
+    const SteadyClock::time_point start = SteadyClock::now();
+    const std::uint64_t startTicks = readSamplingClock();
+    SteadyClock::time_point now = start;
+    while(now-start<CALIBRATION_INTERVAL)
+    {
+        now = SteadyClock::now();
+    }
+    const std::uint64_t ticks = readSamplingClock()-startTicks;
+    const std::uint64_t nanoseconds = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    now-start).count());
+    return (ticks*1000000)/nanoseconds;
+}
+}
+
+std::uint64_t getSamplingClockTicks(std::uint64_t milliseconds)
+{
+    static const std::uint64_t ticksPerMillisecond
+            = calibrateTicksPerMillisecond();
+    return milliseconds*ticksPerMillisecond;
+}
+#else
+std::uint64_t getSamplingClockTicks(std::uint64_t milliseconds)
+{
+    return milliseconds*1000000;
+}
+#endif
+
+std::uint32_t getSampledCountdown(std::uint32_t n)
+{
+    if(n<=1)
+    {
+        return 1;
+    }
+    //xorshift32, seeded with address of thread local state
+    static CPP_ASSERT_THREAD_LOCAL std::uint32_t state = 0;
+    if(state==0)
+    {
+        state = static_cast<std::uint32_t>(
+                    reinterpret_cast<std::uintptr_t>(&state)
+                    ^ readSamplingClock()) | 1;
+    }
+    state ^= state<<13;
+    state ^= state>>17;
+    state ^= state<<5;
+    const std::uint32_t range = (n<=0x7fffffffu) ? (2*n-1) : 0xffffffffu;
+    return 1+(state%range);
+}
+
+} //internal
+} //cppassert
@@ -1,23 +1,109 @@
 #include <cppassert/details/StackTrace.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef CPP_ASSERT_HAVE_LIBRARY_SECTION
+/*
+ * Bounds of functions marked with CPP_ASSERT_LIBRARY_CODE, defined by
+ * linker for section which name is valid C identifier
+ */
+extern "C"
+{
+extern const char __start_cppassert_text[]
+    __attribute__((weak, visibility("hidden")));
+extern const char __stop_cppassert_text[]
+    __attribute__((weak, visibility("hidden")));
+}
+#endif
 
 namespace cppassert
 {
 namespace internal
 {
 
+std::atomic<std::uint16_t> maxStackDepth(64);
 
-const void *StackTrace::StackFrame::getAddress() const
+void setMaxStackDepth(std::size_t depth)
 {
-    return address_;
+    if(depth==0 || depth>StackTrace::MaxDepth)
+    {
+        depth = StackTrace::MaxDepth;
+    }
+    maxStackDepth.store(static_cast<std::uint16_t>(depth)
+                        , std::memory_order_relaxed);
 }
 
-const char *StackTrace::StackFrame::getSymbol() const
+std::size_t getMaxStackDepth()
 {
-    return symbol_;
+    return maxStackDepth.load(std::memory_order_relaxed);
 }
 
-StackTrace::StackFrame::StackFrame(const void *address, const char *symbol)
-    :address_(address), symbol_(symbol)
+/*
+ * Depth can be set per deployment with CPPASSERT_STACK_DEPTH environment
+ * variable, it's a decimal number of frames
+ */
+static struct StackDepthInitializer
+{
+    StackDepthInitializer()
+    {
+        const char *variable = std::getenv("CPPASSERT_STACK_DEPTH");
+        if(variable==nullptr)
+        {
+            return;
+        }
+        char *end = nullptr;
+        const unsigned long depth = std::strtoul(variable, &end, 10);
+        if(end!=variable && (*end)=='\0')
+        {
+            setMaxStackDepth(static_cast<std::size_t>(depth));
+        }
+    }
+} stackDepthInitializer;
+
+bool isLibraryCode(const void *address)
+{
+#ifdef CPP_ASSERT_HAVE_LIBRARY_SECTION
+    //return address follows the call, its last byte belongs to it
+    const char *instruction = static_cast<const char *>(address)-1;
+    return (__start_cppassert_text!=nullptr
+            && instruction>=__start_cppassert_text
+            && instruction<__stop_cppassert_text);
+#else
+    static_cast<void>(address);
+    return false;
+#endif
+}
+
+std::size_t countLibraryFrames(const void *const *addresses,
+                               std::size_t size,
+                               std::size_t libraryFrames)
+{
+#ifdef CPP_ASSERT_HAVE_LIBRARY_SECTION
+    static_cast<void>(libraryFrames);
+    std::size_t frames = 0;
+    while(frames<size && isLibraryCode(addresses[frames]))
+    {
+        ++frames;
+    }
+    return frames;
+#else
+    static_cast<void>(addresses);
+    return std::min(libraryFrames, size);
+#endif
+}
+
+const void *StackTrace::StackFrame::getAddress() const
+{
+    return address_;
+}
+
+StackTrace::StackFrame::StackFrame(const void *address,
+                                   StackTraceImpl *trace,
+                                   std::size_t position)
+    :address_(address), trace_(trace)
+    , position_(static_cast<std::uint32_t>(position))
 {
 
 }
@@ -39,7 +125,6 @@ namespace internal
 {
 
 StackTrace::StackTrace()
-:impl_(new StackTraceImpl())
 {
 
 }
@@ -61,22 +146,102 @@ StackTrace::~StackTrace()
 
 }
 
-StackTrace StackTrace::getStackTrace()
+StackTrace StackTrace::getStackTrace(std::size_t framesToSkip,
+                                     std::size_t maxDepth)
 {
+    if(maxDepth==0)
+    {
+        maxDepth = getMaxStackDepth();
+    }
+    else if(maxDepth>MaxDepth)
+    {
+        maxDepth = MaxDepth;
+    }
     StackTrace frames;
-    frames.impl_->collect();
+    frames.impl_.reset(new StackTraceImpl());
+    frames.impl_->collect(framesToSkip, maxDepth);
+    return frames;
+}
+
+std::size_t StackTrace::getReturnAddresses(void **addresses,
+                                           std::size_t maxDepth,
+                                           std::size_t framesToSkip)
+{
+    if(maxDepth>MaxDepth)
+    {
+        maxDepth = MaxDepth;
+    }
+    //this function is skipped as well
+    return StackTraceImpl::capture(addresses, 1, framesToSkip, maxDepth);
+}
+
+StackTrace StackTrace::fromReturnAddresses(const void *const *addresses,
+                                           std::size_t size)
+{
+    StackTrace frames;
+    if(size>0)
+    {
+        frames.impl_.reset(new StackTraceImpl());
+        frames.impl_->assign(addresses, size);
+    }
     return frames;
 }
 
 std::size_t StackTrace::size() const
 {
-    return impl_->size();
+    return impl_ ? impl_->size() : 0;
 }
 
 const StackTrace::StackFrame &StackTrace::operator[](std::size_t position) const
 {
+    if(!impl_)
+    {
+        throw std::out_of_range("StackTrace[] out of range");
+    }
     return impl_->at(position);
 }
 
+void StackTrace::symbolize() const
+{
+    if(impl_)
+    {
+        impl_->symbolize();
+    }
+}
+
+/*
+ * Defined after StackTraceImpl, frame asks its trace to resolve
+ * the address
+ */
+const char *StackTrace::StackFrame::getSymbol() const
+{
+    if(symbol_==nullptr && trace_!=nullptr)
+    {
+        trace_->symbolize(position_);
+    }
+    return symbol_;
+}
+
+bool StackTrace::StackFrame::isSymbolized() const
+{
+    return (symbol_!=nullptr || trace_==nullptr);
+}
+
+std::size_t StackTrace::StackFrame::getSourceLocationCount() const
+{
+    getSymbol();
+    return locationCount_;
+}
+
+const SourceLocation &StackTrace::StackFrame::getSourceLocation(
+                                                std::size_t position) const
+{
+    if(position>=getSourceLocationCount())
+    {
+        throw std::out_of_range("StackFrame source location out of range");
+    }
+    return locations_[position];
+}
+
 } //internal
 } //asrt
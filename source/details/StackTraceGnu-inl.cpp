@@ -1,9 +1,23 @@
 #include <cppassert/details/StackTrace.hpp>
+#include <cppassert/CodeRange.hpp>
+#include <cppassert/details/DwarfLineTable.hpp>
+#include <cppassert/details/ElfSymbolTable.hpp>
+#include <cppassert/details/StackUnwinder.hpp>
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <execinfo.h>
 #include <cxxabi.h>
+#include <deque>
+#include <memory>
+#include <new>
+#include <pthread.h>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace cppassert
 {
@@ -63,6 +77,121 @@ private:
     char* funcName_ = nullptr;
 };
 
+/**
+ * Process wide cache of demangled names. The same symbols show up in
+ * every trace of a site, so each name is demangled once, with a demangler
+ * reused by the calling thread, and later found under a shared lock.
+ * Names that can't be demangled are cached as well, cached names are
+ * never released.
+ */
+class DemangleCache
+{
+    DemangleCache(const DemangleCache &) = delete;
+    DemangleCache &operator=(const DemangleCache &) = delete;
+public:
+    DemangleCache()
+    {
+        ::pthread_rwlock_init(&lock_, nullptr);
+    }
+
+    /**
+     * Returns process wide cache, it's never destroyed so that frames can
+     * be demangled also by destructors of static objects
+     * @return  Demangle cache
+     */
+    static DemangleCache &getInstance()
+    {
+        static DemangleCache *cache = new DemangleCache();
+        return *cache;
+    }
+
+    /**
+     * Demangle C++ symbol name
+     * @param   funcName    C++ mangled symbol name
+     * @return  Demangled name valid for the process lifetime or nullptr
+     *          if \p funcName can't be demangled
+     */
+    const char *demangle(const char *funcName)
+    {
+        const char *result = nullptr;
+        ::pthread_rwlock_rdlock(&lock_);
+        const bool isCached = find(funcName, &result);
+        ::pthread_rwlock_unlock(&lock_);
+        if(isCached)
+        {
+            return result;
+        }
+        static thread_local CppDemangler demangler;
+        const char *demangledName = demangler.demangle(funcName);
+        ::pthread_rwlock_wrlock(&lock_);
+        //other thread could have added the name meanwhile
+        if(!find(funcName, &result))
+        {
+            strings_.emplace_back(funcName);
+            const char *name = strings_.back().c_str();
+            if(demangledName)
+            {
+                strings_.emplace_back(demangledName);
+                result = strings_.back().c_str();
+            }
+            names_.emplace(name, result);
+        }
+        ::pthread_rwlock_unlock(&lock_);
+        return result;
+    }
+
+    /**
+     * Returns number of cached names
+     * @return  Number of names
+     */
+    std::size_t size()
+    {
+        ::pthread_rwlock_rdlock(&lock_);
+        const std::size_t result = names_.size();
+        ::pthread_rwlock_unlock(&lock_);
+        return result;
+    }
+
+private:
+    struct NameHash
+    {
+        std::size_t operator()(const char *name) const
+        {
+            //FNV-1a
+            std::uint32_t hash = 2166136261u;
+            for(; *name; ++name)
+            {
+                hash = (hash^static_cast<unsigned char>(*name))*16777619u;
+            }
+            return hash;
+        }
+    };
+
+    struct NameEqual
+    {
+        bool operator()(const char *first, const char *second) const
+        {
+            return std::strcmp(first, second)==0;
+        }
+    };
+
+    bool find(const char *funcName, const char **demangledName) const
+    {
+        const auto found = names_.find(funcName);
+        if(found==names_.end())
+        {
+            return false;
+        }
+        *demangledName = found->second;
+        return true;
+    }
+
+    pthread_rwlock_t lock_;
+    std::unordered_map<const char *, const char *, NameHash, NameEqual>
+                                                                names_;
+    std::deque<std::string> strings_;
+};
+
 /**
  * An intelligent wrapper around symbols that may need or may not need
  * to be deallocated. If symbol was not demangled we shouldn't allocate/deallocate
@@ -74,7 +203,7 @@ class BackTraceSymbol
 {
     BackTraceSymbol(const BackTraceSymbol &) = delete;
     BackTraceSymbol &operator=(const BackTraceSymbol &) = delete;
-    static constexpr const char *UnkownSymbol = "<unkown>";
+    static constexpr const char *UnknownSymbol = "<unknown>";
 public:
     BackTraceSymbol()
     {
@@ -106,6 +235,7 @@ public:
                         std::malloc(backTraceLength+nameLength+offsetLength+2));
         if(!allocated_)
         {
+            symbol_ = UnknownSymbol;
             return;
         }
         char *begin = allocated_;
@@ -122,9 +252,9 @@ public:
     }
 
     /**
-     * Set value to symbol. It's a pointer returned by `backtrace_symbols`
-     * function. Only pointer value is copied, life time of this pointer
-     * is managed by class that will manage life time of this class
+     * Set value to symbol. It's a string returned by `backtrace_symbols`
+     * function, it's copied because strings returned by
+     * `backtrace_symbols` are released right after symbolization
      *
      * @param   symbol  String returned from `backtrace_symbols` function
      *
@@ -132,7 +262,84 @@ public:
     void setSymbol(const char *symbol)
     {
         deallocate();
-        symbol_ = symbol;
+        const std::size_t length = std::strlen(symbol)+1;
+        allocated_ = static_cast<char *>(std::malloc(length));
+        if(!allocated_)
+        {
+            symbol_ = UnknownSymbol;
+            return;
+        }
+        std::memcpy(allocated_, symbol, length);
+        symbol_ = allocated_;
+    }
+
+    /**
+     * Set value to symbol resolved from symbol table of a module, text
+     * has the same format as strings returned by `backtrace_symbols`
+     * followed by source locations, i.e.
+     * `module(name+0x1f) [0x4007f5] at file.hpp:3 in inner, inlined at
+     * file.cpp:10`
+     *
+     * @param   module          Path of module
+     * @param   name            Symbol name or nullptr
+     * @param   offset          Offset from symbol or from module
+     * @param   address         Frame address
+     * @param   locations       Source locations of the frame
+     * @param   locationCount   Number of source locations
+     */
+    void setSymbol(const char *module
+                    , const char *name
+                    , std::size_t offset
+                    , const void *address
+                    , const SourceLocation *locations
+                    , std::size_t locationCount)
+    {
+        const char *format = "%s(%s+0x%zx) [%p]";
+        name = name ? name : "";
+        const int length = std::snprintf(nullptr, 0, format
+                                    , module, name, offset, address);
+        if(length<0)
+        {
+            deallocate();
+            symbol_ = UnknownSymbol;
+            return;
+        }
+        std::string text(static_cast<std::size_t>(length)+1, '\0');
+        std::snprintf(&text[0], text.size(), format
+                      , module, name, offset, address);
+        text.resize(static_cast<std::size_t>(length));
+        for(std::size_t i=0; i<locationCount; ++i)
+        {
+            text += (i==0) ? " at " : ", inlined at ";
+            text += locations[i].file ? locations[i].file : "??";
+            text += ':';
+            text += std::to_string(locations[i].line);
+            if(locations[i].function)
+            {
+                text += " in ";
+                text += locations[i].function;
+            }
+        }
+        setSymbol(text.c_str());
+        locations_.assign(locations, locations+locationCount);
+    }
+
+    /**
+     * Returns source locations of symbol
+     * @return  Locations or nullptr if there are none
+     */
+    const SourceLocation *locations() const
+    {
+        return locations_.empty() ? nullptr : locations_.data();
+    }
+
+    /**
+     * Returns number of source locations of symbol
+     * @return  Number of locations
+     */
+    std::size_t locationCount() const
+    {
+        return locations_.size();
     }
 
     /**
@@ -178,7 +385,7 @@ public:
      * @return  BackTraceSymbol object
      */
     static BackTraceSymbol createFromBacktraceStr(char *backTraceSymbol
-                                        , CppDemangler *demangler)
+                                        , DemangleCache *demangler)
     {
         BackTraceSymbol result;
         char *beginName = 0, *beginOffset = 0, *endOffset = 0;
@@ -231,6 +438,7 @@ public:
      * @param   other   Object to be moved
      */
     BackTraceSymbol(BackTraceSymbol && other)
+        :locations_(std::move(other.locations_))
     {
         allocated_ = other.allocated_;
         symbol_ = other.symbol_;
@@ -247,6 +455,7 @@ public:
         deallocate();
         allocated_ = other.allocated_;
         symbol_ = other.symbol_;
+        locations_ = std::move(other.locations_);
         other.allocated_ = nullptr;
         other.symbol_ = nullptr;
         return (*this);
@@ -261,13 +470,18 @@ private:
             allocated_ = nullptr;
         }
     }
-    const char *symbol_ = UnkownSymbol;
+    const char *symbol_ = UnknownSymbol;
     char *allocated_ = nullptr;
+    std::vector<SourceLocation> locations_;
 };
 
 /**
  * StackTrace implementation for platforms where backtrace/backtrace_symbols
- * functions are available
+ * functions are available. Only return addresses are collected, with
+ * unwinder selected by setStackUnwinder, `backtrace_symbols` and
+ * demangling are deferred until a frame is symbolized. Up to InlineFrames
+ * frames are stored in the object itself, deeper traces allocate frames
+ * of their actual depth.
  */
 class StackTraceImpl
 {
@@ -281,35 +495,179 @@ public:
 
     ~StackTraceImpl()
     {
-        freeSymbols();
+
+    }
+
+    /**
+     * Collects return addresses of current stack trace
+     * @param   framesToSkip    Number of frames below the caller of
+     *                          StackTrace::getStackTrace to be skipped
+     * @param   maxDepth        Maximal number of frames to be collected
+     */
+    __attribute__((always_inline))
+    void collect(std::size_t framesToSkip, std::size_t maxDepth)
+    {
+        void *addresses[StackTrace::MaxDepth];
+        assign(addresses, capture(addresses, LibraryFrames, framesToSkip
+                                  , maxDepth));
     }
 
     /**
-     * Collects current stack trace
+     * Sets frames to return addresses collected earlier
+     * @param   addresses   Return addresses, frame 0 first
+     * @param   size        Number of addresses
      */
-    void collect()
+    void assign(const void *const *addresses, std::size_t size)
     {
-        freeSymbols();
-        CppDemangler demangler;
-        backtraceSize_ = ::backtrace(backtrace_, BufferSize);
-        symbols_ = ::backtrace_symbols(backtrace_, backtraceSize_);
+        size_ = size;
+        if(size_>InlineFrames)
+        {
+            allocatedFrames_.reset(new StackTrace::StackFrame[size_]);
+            frames_ = allocatedFrames_.get();
+        }
+        for(std::size_t i=0; i<size_; ++i)
+        {
+            frames_[i] = StackTrace::StackFrame(addresses[i], this, i);
+        }
+    }
 
-        for(std::size_t i=cFramesToSkip; i<backtraceSize_; ++i)
+    /**
+     * Collects return addresses of current stack with unwinder selected
+     * by setStackUnwinder
+     * Frames of the library above the caller are recognized by address,
+     * see isLibraryCode, or skipped by count where it's not possible.
+     * @param[out]  addresses       Buffer for at least \p maxDepth addresses
+     * @param[in]   libraryFrames   Number of frames of the library between
+     *                              this function and the caller, it's used
+     *                              only if they can't be recognized
+     * @param[in]   framesToSkip    Number of frames below the caller to be
+     *                              skipped, 0 means that the first frame is
+     *                              the caller
+     * @param[in]   maxDepth        Maximal number of frames, it's not
+     *                              greater than StackTrace::MaxDepth
+     * @return  Number of addresses written to \p addresses
+     */
+    __attribute__((noinline))
+    static std::size_t capture(void **addresses, std::size_t libraryFrames
+                               , std::size_t framesToSkip
+                               , std::size_t maxDepth)
+    {
+        void *backtrace[BufferSize];
+        //unwinding stops at maximal depth, there may be more library
+        //frames than the caller knows about
+        const std::size_t bufferSize = std::min<std::size_t>(
+                                            1+libraryFrames+framesToSkip
+                                            +maxDepth+MaxLibraryFrames
+                                            , BufferSize);
+        std::size_t backtraceSize = 0;
+        //every unwinder returns caller of the function it's called from first
+        switch(getStackUnwinder())
+        {
+            case StackUnwinder::UnwindBacktrace:
+                backtraceSize = captureWithUnwind(backtrace, bufferSize);
+                break;
+            case StackUnwinder::FramePointer:
+                backtraceSize = captureWithFramePointers(backtrace
+                                                         , bufferSize);
+                break;
+            default:
+                break;
+        }
+        if(backtraceSize==0)
+        {
+            backtraceSize = static_cast<std::size_t>(
+                                ::backtrace(backtrace
+                                            , static_cast<int>(bufferSize)));
+        }
+        if(backtraceSize==0)
         {
-            if(symbols_)
+            return 0;
+        }
+        //the first frame is this function
+        const std::size_t firstFrame = 1+framesToSkip
+                                       +countLibraryFrames(backtrace+1
+                                                           , backtraceSize-1
+                                                           , libraryFrames);
+        if(backtraceSize<=firstFrame)
+        {
+            return 0;
+        }
+        const std::size_t size = std::min(backtraceSize-firstFrame, maxDepth);
+        std::copy(backtrace+firstFrame, backtrace+firstFrame+size, addresses);
+        return size;
+    }
+
+    /**
+     * Symbolizes all frames which are not symbolized yet with a single
+     * call to `backtrace_symbols`
+     */
+    void symbolize()
+    {
+        std::size_t first = 0;
+        while(first<size() && frames_[first].symbol_!=nullptr)
+        {
+            ++first;
+        }
+        if(first==size() || !allocateSymbols())
+        {
+            return;
+        }
+        DemangleCache *demangler = &DemangleCache::getInstance();
+        for(std::size_t i=first; i<size(); ++i)
+        {
+            if(frames_[i].symbol_==nullptr
+               && !setSymbolFromSymbolTable(i, demangler))
             {
-                demangledSymbols_[i]
-                    = BackTraceSymbol::createFromBacktraceStr(symbols_[i]
-                                                            , &demangler);
+                setSymbolFromCodeRange(i, demangler);
             }
-            else
+        }
+        while(first<size() && frames_[first].symbol_!=nullptr)
+        {
+            ++first;
+        }
+        if(first==size())
+        {
+            return;
+        }
+        std::vector<void *> addresses;
+        addresses.reserve(size()-first);
+        for(std::size_t i=first; i<size(); ++i)
+        {
+            addresses.push_back(const_cast<void *>(frames_[i].address_));
+        }
+        char **symbols = ::backtrace_symbols(addresses.data()
+                                    , static_cast<int>(addresses.size()));
+        for(std::size_t i=first; i<size(); ++i)
+        {
+            if(frames_[i].symbol_==nullptr)
             {
-                demangledSymbols_[i] = BackTraceSymbol();
+                setSymbol(i, symbols ? symbols[i-first] : nullptr
+                          , demangler);
             }
+        }
+        std::free(symbols);
+    }
 
-            frames_[i-cFramesToSkip] = StackTrace::StackFrame(backtrace_[i]
-                                            , demangledSymbols_[i].symbol());
+    /**
+     * Symbolizes frame at \p position
+     * @param   position    Number of frame
+     */
+    void symbolize(std::size_t position)
+    {
+        if(frames_[position].symbol_!=nullptr || !allocateSymbols())
+        {
+            return;
         }
+        DemangleCache *demangler = &DemangleCache::getInstance();
+        if(setSymbolFromSymbolTable(position, demangler)
+           || setSymbolFromCodeRange(position, demangler))
+        {
+            return;
+        }
+        void *address = const_cast<void *>(frames_[position].address_);
+        char **symbols = ::backtrace_symbols(&address, 1);
+        setSymbol(position, symbols ? symbols[0] : nullptr, demangler);
+        std::free(symbols);
     }
 
     /**
@@ -318,7 +676,7 @@ public:
      */
     std::size_t size() const
     {
-        return (backtraceSize_-cFramesToSkip);
+        return size_;
     }
 
      /**
@@ -329,7 +687,7 @@ public:
      */
     const StackTrace::StackFrame &at(std::size_t position) const
     {
-        if(position<(backtraceSize_-cFramesToSkip))
+        if(position<size())
         {
             return frames_[position];
         }
@@ -344,27 +702,135 @@ public:
 private:
     enum
     {
-        BufferSize = 256
+        BufferSize = StackTrace::MaxDepth+16
+    };
+
+    enum
+    {
+        InlineFrames = 16
+    };
+
+    /*
+     * StackTrace::getStackTrace, collect() is always inlined into it
+     */
+    enum
+    {
+        LibraryFrames = 1
+    };
+
+    /*
+     * Bound of frames of the library which are not known to the caller of
+     * capture(), i.e. frames of AssertionFailure::onAssertionFailure
+     */
+    enum
+    {
+        MaxLibraryFrames = 8
     };
 
     enum
     {
-        cFramesToSkip = 2
+        MaxSourceLocations = 16
     };
 
-    void freeSymbols()
+    /*
+     * Symbols are allocated on first symbolization, so that traces which
+     * are never symbolized don't pay for them
+     */
+    bool allocateSymbols()
+    {
+        if(!demangledSymbols_)
+        {
+            demangledSymbols_.reset(new (std::nothrow)
+                                        BackTraceSymbol[size()]);
+        }
+        return static_cast<bool>(demangledSymbols_);
+    }
+
+    void setSymbol(std::size_t position, char *backTraceSymbol
+                   , DemangleCache *demangler)
+    {
+        if(backTraceSymbol)
+        {
+            demangledSymbols_[position]
+                = BackTraceSymbol::createFromBacktraceStr(backTraceSymbol
+                                                        , demangler);
+        }
+        frames_[position].symbol_ = demangledSymbols_[position].symbol();
+    }
+
+    /*
+     * Symbol table of loaded modules resolves also symbols which are not
+     * exported, `backtrace_symbols` is used only for addresses outside
+     * of modules known to the table
+     */
+    bool setSymbolFromSymbolTable(std::size_t position
+                                  , DemangleCache *demangler)
+    {
+#ifdef CPP_ASSERT_HAVE_ELF_SYMBOLS
+        ElfSymbolTable::Symbol symbol;
+        const void *address = frames_[position].address_;
+        if(!ElfSymbolTable::getInstance().findSymbol(address, &symbol))
+        {
+            return false;
+        }
+        const char *name = symbol.name;
+        if(name)
+        {
+            const char *demangledName = demangler->demangle(name);
+            name = demangledName ? demangledName : name;
+        }
+        SourceLocation locations[MaxSourceLocations];
+        std::size_t locationCount = 0;
+#ifdef CPP_ASSERT_HAVE_DWARF_LINES
+        //return address follows the call, its last byte belongs to it
+        locationCount = DwarfLineTable::getTable(symbol.module).findLocations(
+                            symbol.moduleAddress-1, locations
+                            , MaxSourceLocations);
+#endif
+        BackTraceSymbol &frameSymbol = demangledSymbols_[position];
+        frameSymbol.setSymbol(symbol.module, name, symbol.offset, address
+                              , locations, locationCount);
+        frames_[position].symbol_ = frameSymbol.symbol();
+        frames_[position].locations_ = frameSymbol.locations();
+        frames_[position].locationCount_ = static_cast<std::uint32_t>(
+                                                frameSymbol.locationCount());
+        return true;
+#else
+        (void)position;
+        (void)demangler;
+        return false;
+#endif
+    }
+
+    /*
+     * Frames outside of loaded modules may belong to code generated at
+     * runtime, see registerCodeRange()
+     */
+    bool setSymbolFromCodeRange(std::size_t position
+                                , DemangleCache *demangler)
     {
-        if(symbols_)
+        CodeRangeSymbol symbol;
+        const void *address = frames_[position].address_;
+        if(!findCodeRange(address, &symbol))
         {
-            std::free(symbols_);
+            return false;
         }
+        const char *demangledName = demangler->demangle(symbol.name);
+        BackTraceSymbol &frameSymbol = demangledSymbols_[position];
+        frameSymbol.setSymbol(symbol.module
+                              , demangledName ? demangledName : symbol.name
+                              , symbol.offset, address, nullptr, 0);
+        frames_[position].symbol_ = frameSymbol.symbol();
+        frames_[position].locations_ = frameSymbol.locations();
+        frames_[position].locationCount_ = 0;
+        return true;
     }
 
-    char **symbols_ = nullptr;
-    void *backtrace_[BufferSize];
-    StackTrace::StackFrame frames_[BufferSize];
-    BackTraceSymbol demangledSymbols_[BufferSize];
-    std::size_t backtraceSize_ = 0;
+    StackTrace::StackFrame inlineFrames_[InlineFrames];
+    std::unique_ptr<StackTrace::StackFrame[]> allocatedFrames_;
+    StackTrace::StackFrame *frames_ = inlineFrames_;
+    std::unique_ptr<BackTraceSymbol[]> demangledSymbols_;
+    std::size_t size_ = 0;
 };
 
 
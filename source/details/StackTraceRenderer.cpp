@@ -0,0 +1,87 @@
+#include <cppassert/details/StackTraceRenderer.hpp>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace cppassert
+{
+namespace internal
+{
+
+namespace
+{
+std::mutex filterMutex;
+std::shared_ptr<const StackTraceFilter> stackTraceFilter;
+
+void appendSummary(MessageSink &output, std::size_t frames,
+                   const char *format)
+{
+    if(frames==0)
+    {
+        return;
+    }
+    char text[64];
+    const int length = std::snprintf(text, sizeof(text), format, frames
+                                     , (frames==1) ? "" : "s");
+    if(length>0)
+    {
+        output.append(text, static_cast<std::size_t>(length));
+    }
+}
+}
+
+void setStackTraceFilter(StackTraceFilter filter)
+{
+    std::shared_ptr<const StackTraceFilter> newFilter;
+    if(filter.maxFrames!=0 || !filter.hiddenPrefixes.empty())
+    {
+        newFilter = std::make_shared<const StackTraceFilter>(
+                                                    std::move(filter));
+    }
+    std::lock_guard<std::mutex> lock(filterMutex);
+    stackTraceFilter = std::move(newFilter);
+}
+
+std::shared_ptr<const StackTraceFilter> getStackTraceFilter()
+{
+    std::lock_guard<std::mutex> lock(filterMutex);
+    return stackTraceFilter;
+}
+
+StackTraceRenderer::StackTraceRenderer(
+                        std::shared_ptr<const StackTraceFilter> filter)
+    :filter_(std::move(filter))
+{
+}
+
+bool StackTraceRenderer::isHidden(const char *symbol) const
+{
+    if(!filter_ || filter_->hiddenPrefixes.empty() || symbol==nullptr)
+    {
+        return false;
+    }
+    const char *name = std::strchr(symbol, '(');
+    name = name ? name+1 : symbol;
+    for(const auto &prefix: filter_->hiddenPrefixes)
+    {
+        if(!prefix.empty()
+           && std::strncmp(name, prefix.c_str(), prefix.size())==0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void StackTraceRenderer::appendHidden(MessageSink &output, std::size_t frames)
+{
+    appendSummary(output, frames, "     ... %zu hidden frame%s\n");
+}
+
+void StackTraceRenderer::appendElided(MessageSink &output, std::size_t frames)
+{
+    appendSummary(output, frames, "     ... %zu more frame%s\n");
+}
+
+} //internal
+} //cppassert
@@ -27,7 +27,32 @@ public:
      * Empty method for platforms where stack trace collecting
      * is not available
      */
-    void collect()
+    void collect(std::size_t , std::size_t )
+    {
+    }
+
+    void assign(const void *const *, std::size_t )
+    {
+    }
+
+    /**
+     * There are no return addresses to be collected
+     * @return 0
+     */
+    static std::size_t capture(void **, std::size_t , std::size_t
+                               , std::size_t )
+    {
+        return 0;
+    }
+
+    /**
+     * There are no frames to be symbolized
+     */
+    void symbolize()
+    {
+    }
+
+    void symbolize(std::size_t )
     {
     }
 
@@ -1,5 +1,6 @@
 #include <cppassert/details/DebugPrint.hpp>
 #include <cppassert/details/StackTrace.hpp>
+#include <cppassert/CodeRange.hpp>
 #include <stdexcept>
 #include <memory>
 #include <mutex>
@@ -67,15 +68,10 @@ namespace cppassert
             {
                 BacktraceSymbol() = default;
 
-                BacktraceSymbol(const void *frameAddr, const char *name)
+                BacktraceSymbol(const void *frameAddr, StackTraceImpl *trace,
+                                std::size_t position)
+                    :StackTrace::StackFrame(frameAddr, trace, position)
                 {
-                    address_ = frameAddr;
-                    setSymbol(name);
-                }
-
-                void setAddress(const void *frameAddress)
-                {
-                    address_ = frameAddress;
                 }
 
                 void setSymbol(const char *name)
@@ -104,13 +100,90 @@ namespace cppassert
             {
             }
 
-            void collect()
+            /**
+             * Captures return addresses only, symbols are resolved
+             * with SymFromAddr when frame is symbolized. Frames are
+             * allocated for captured depth only.
+             */
+            __declspec(noinline)
+            void collect(std::size_t framesToSkip, std::size_t maxDepth)
+            {
+                PVOID               frames[StackTrace::MaxDepth];
+                assign(frames, capture(frames, cFramesToSkip, framesToSkip
+                                       , maxDepth));
+            }
+
+            /**
+             * Sets frames to return addresses collected earlier
+             */
+            void assign(const void *const *addresses, std::size_t size)
+            {
+                capturedFrames_ = size;
+                if (capturedFrames_ == 0)
+                {
+                    return;
+                }
+                frames_.reset(new BacktraceSymbol[capturedFrames_]);
+
+                for (std::size_t frame = 0; frame<capturedFrames_; frame++)
+                {
+                    frames_[frame] = BacktraceSymbol(addresses[frame], this
+                                                     , frame);
+                }
+            }
+
+            /**
+             * Captures return addresses of current stack, \p libraryFrames
+             * frames of the library and then \p framesToSkip frames below
+             * the caller are skipped, library frames are counted as there
+             * is no section of library code
+             */
+            __declspec(noinline)
+            static std::size_t capture(void **addresses
+                                       , std::size_t libraryFrames
+                                       , std::size_t framesToSkip
+                                       , std::size_t maxDepth)
             {
+                //the first frame is this function
+                const ULONG skip = static_cast<ULONG>(1 + libraryFrames
+                                                      + framesToSkip);
+
+                std::size_t captured = CaptureStackBackTrace(skip
+                                            , static_cast<ULONG>(maxDepth)
+                                            , addresses
+                                            , NULL);
+
+                if (captured > maxDepth)
+                {
+                    captured = maxDepth;
+                }
+                return captured;
+            }
+
+            /**
+             * Symbolizes all frames which are not symbolized yet
+             */
+            void symbolize()
+            {
+                for (std::size_t frame = 0; frame<capturedFrames_; frame++)
+                {
+                    symbolize(frame);
+                }
+            }
+
+            /**
+             * Symbolizes frame at \p position
+             * @param   position    Number of frame
+             */
+            void symbolize(std::size_t position)
+            {
+                if (frames_[position].symbol_ != nullptr)
+                {
+                    return;
+                }
                 HANDLE              process;
-                ULONG               frame;
                 PSYMBOL_INFO        symbol;
                 DWORD64             displacement;
-                PVOID               frames[cFramesSize];
                 enum {              MaxNameLen = MAX_SYM_NAME + 1 };
                 enum {              BufferSize = sizeof(SYMBOL_INFO)
                                                 + MaxNameLen * sizeof(TCHAR) };
@@ -120,7 +193,6 @@ namespace cppassert
                 symbol = static_cast<PSYMBOL_INFO>(static_cast<void *>(buffer));
 
                 std::memset(symbol, 0, BufferSize);
-                std::memset(frames, 0, sizeof(frames));
 
                 symbol->MaxNameLen = MaxNameLen-1;
                 symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
@@ -128,41 +200,34 @@ namespace cppassert
                 process = GetCurrentProcess();
                 displacement = 0;
 
-
                 symInitialize(process);
-                capturedFrames_ = CaptureStackBackTrace(cFramesToSkip
-                                            , cFramesSize
-                                            , frames
-                                            , NULL);
-
-                if (capturedFrames_ > cFramesSize)
+                const void *address = frames_[position].getAddress();
+                DWORD64 frameAddr = (DWORD64)(address);
+                CodeRangeSymbol codeRange;
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (SymFromAddr(process, frameAddr, &displacement, symbol)
+                                == TRUE)
                 {
-                    capturedFrames_ = cFramesSize;
+                    frames_[position].setSymbol(symbol->Name);
                 }
-
-                for (frame = 0; frame<capturedFrames_; frame++)
+                else if (findCodeRange(address, &codeRange))
                 {
-                    DWORD64 frameAddr = (DWORD64)(frames[frame]);
-                    frames_[frame].setAddress(frames[frame]);
-                    std::unique_lock<std::mutex> lock(mutex_);
-                    if (SymFromAddr(process, frameAddr, &displacement, symbol)
-                                    == TRUE)
-                    {
-                        frames_[frame].setSymbol(symbol->Name);
-                    }
-                    else
-                    {
-                        const unsigned long addressSize = sizeof(PVOID)*CHAR_BIT;
-                        char msgBuffer[512];
-                        sprintf_s(msgBuffer, sizeof(msgBuffer)
-                                , "Error getting symbol from addr: 0x%016llX 0x%p address size %lu bits\n"
-                                , frameAddr
-                                , frames[frame]
-                                , addressSize);
-                        msgBuffer[sizeof(msgBuffer)-1] = '\0';
-                        PrintMessageToStdErr(msgBuffer);
-                        DisplayLastError("SymFromAddr");
-                    }
+                    //code generated at runtime, see registerCodeRange()
+                    frames_[position].setSymbol(codeRange.name);
+                }
+                else
+                {
+                    frames_[position].setSymbol(nullptr);
+                    const unsigned long addressSize = sizeof(PVOID)*CHAR_BIT;
+                    char msgBuffer[512];
+                    sprintf_s(msgBuffer, sizeof(msgBuffer)
+                            , "Error getting symbol from addr: 0x%016llX 0x%p address size %lu bits\n"
+                            , frameAddr
+                            , address
+                            , addressSize);
+                    msgBuffer[sizeof(msgBuffer)-1] = '\0';
+                    PrintMessageToStdErr(msgBuffer);
+                    DisplayLastError("SymFromAddr");
                 }
             }
 
@@ -217,12 +282,7 @@ namespace cppassert
             {
                 cFramesToSkip = 2
             };
-
-            enum
-            {
-                cFramesSize = 1024
-            };
-            BacktraceSymbol frames_[cFramesSize];
+            std::unique_ptr<BacktraceSymbol[]> frames_;
             std::size_t capturedFrames_ = 0;
         };
 
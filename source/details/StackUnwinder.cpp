@@ -0,0 +1,207 @@
+#include <cppassert/details/StackUnwinder.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef CPP_ASSERT_HAVE_UNWIND_BACKTRACE
+#include <unwind.h>
+#endif
+#ifdef CPP_ASSERT_HAVE_FRAME_POINTER_UNWINDER
+#include <pthread.h>
+#endif
+
+namespace cppassert
+{
+namespace internal
+{
+
+std::atomic<std::uint8_t> stackUnwinder(
+                    static_cast<std::uint8_t>(StackUnwinder::Backtrace));
+
+static const struct
+{
+    const char *name;
+    StackUnwinder unwinder;
+} UNWINDER_NAMES[] =
+{
+    {"backtrace", StackUnwinder::Backtrace},
+    {"unwind", StackUnwinder::UnwindBacktrace},
+    {"frame-pointer", StackUnwinder::FramePointer}
+};
+
+void setStackUnwinder(StackUnwinder unwinder)
+{
+    stackUnwinder.store(static_cast<std::uint8_t>(unwinder)
+                        , std::memory_order_relaxed);
+}
+
+StackUnwinder getStackUnwinder()
+{
+    return static_cast<StackUnwinder>(
+                stackUnwinder.load(std::memory_order_relaxed));
+}
+
+/*
+ * Unwinder is chosen per deployment with CPPASSERT_UNWINDER environment
+ * variable, it's one of `backtrace`, `unwind` or `frame-pointer`
+ */
+static struct StackUnwinderInitializer
+{
+    StackUnwinderInitializer()
+    {
+        const char *variable = std::getenv("CPPASSERT_UNWINDER");
+        if(variable==nullptr)
+        {
+            return;
+        }
+        for(const auto &entry: UNWINDER_NAMES)
+        {
+            if(std::strcmp(entry.name, variable)==0)
+            {
+                setStackUnwinder(entry.unwinder);
+                return;
+            }
+        }
+    }
+} stackUnwinderInitializer;
+
+#ifdef CPP_ASSERT_HAVE_UNWIND_BACKTRACE
+namespace
+{
+struct UnwindState
+{
+    void **frames;
+    std::size_t maxFrames;
+    std::size_t count;
+    bool callerReached;
+};
+
+/*
+ * First frame reported by `_Unwind_Backtrace` is the one of its caller,
+ * i.e. captureWithUnwind
+ */
+_Unwind_Reason_Code addUnwoundFrame(_Unwind_Context *context, void *argument)
+{
+    UnwindState *state = static_cast<UnwindState *>(argument);
+    if(!state->callerReached)
+    {
+        state->callerReached = true;
+        return _URC_NO_REASON;
+    }
+    const _Unwind_Ptr address = _Unwind_GetIP(context);
+    if(address==0 || state->count>=state->maxFrames)
+    {
+        return _URC_END_OF_STACK;
+    }
+    state->frames[state->count++] = reinterpret_cast<void *>(address);
+    return (state->count<state->maxFrames) ? _URC_NO_REASON
+                                           : _URC_END_OF_STACK;
+}
+}
+
+__attribute__((noinline))
+std::size_t captureWithUnwind(void **frames, std::size_t maxFrames)
+{
+    UnwindState state = {frames, maxFrames, 0, false};
+    if(maxFrames>0)
+    {
+        _Unwind_Backtrace(&addUnwoundFrame, &state);
+    }
+    return state.count;
+}
+#else
+std::size_t captureWithUnwind(void **, std::size_t )
+{
+    return 0;
+}
+#endif /* CPP_ASSERT_HAVE_UNWIND_BACKTRACE */
+
+#ifdef CPP_ASSERT_HAVE_FRAME_POINTER_UNWINDER
+namespace
+{
+/*
+ * Layout of frame record pointed to by frame pointer on x86 and AArch64
+ */
+struct FrameRecord
+{
+    const FrameRecord *next;
+    void *returnAddress;
+};
+
+struct StackBounds
+{
+    std::uintptr_t low = 0;
+    std::uintptr_t high = 0;
+    bool initialized = false;
+};
+
+/*
+ * `pthread_getattr_np` isn't async signal safe, it reads
+ * /proc/self/maps for main thread, so it's called once per thread
+ */
+const StackBounds &getStackBounds()
+{
+    static thread_local StackBounds bounds;
+    if(!bounds.initialized)
+    {
+        bounds.initialized = true;
+        pthread_attr_t attributes;
+        if(pthread_getattr_np(pthread_self(), &attributes)==0)
+        {
+            void *stack = nullptr;
+            std::size_t size = 0;
+            if(pthread_attr_getstack(&attributes, &stack, &size)==0)
+            {
+                bounds.low = reinterpret_cast<std::uintptr_t>(stack);
+                bounds.high = bounds.low+size;
+            }
+            pthread_attr_destroy(&attributes);
+        }
+    }
+    return bounds;
+}
+}
+
+/*
+ * Every record has to be inside of thread stack, aligned and above the
+ * previous one, so walk stops at the first function that doesn't keep
+ * frame pointer without reading memory outside of the stack
+ */
+__attribute__((noinline))
+std::size_t captureWithFramePointers(void **frames, std::size_t maxFrames)
+{
+    const StackBounds &bounds = getStackBounds();
+    if(bounds.low==bounds.high)
+    {
+        return 0;
+    }
+    const FrameRecord *record = static_cast<const FrameRecord *>(
+                                    __builtin_frame_address(0));
+    std::size_t count = 0;
+    while(count<maxFrames)
+    {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(record);
+        if(address<bounds.low || address>bounds.high-sizeof(FrameRecord)
+           || address%alignof(FrameRecord)!=0
+           || record->returnAddress==nullptr)
+        {
+            break;
+        }
+        frames[count++] = record->returnAddress;
+        if(reinterpret_cast<std::uintptr_t>(record->next)<=address)
+        {
+            break;
+        }
+        record = record->next;
+    }
+    return count;
+}
+#else
+std::size_t captureWithFramePointers(void **, std::size_t )
+{
+    return 0;
+}
+#endif /* CPP_ASSERT_HAVE_FRAME_POINTER_UNWINDER */
+
+} //internal
+} //cppassert
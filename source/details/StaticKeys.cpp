@@ -0,0 +1,306 @@
+#include <cppassert/CppAssert.hpp>
+#include <cppassert/details/Helpers.hpp>
+
+#if defined(__x86_64__) && defined(__linux__) && defined(__ELF__)
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+namespace
+{
+
+/*
+ * Layout of `cppassert_static_keys` section entry emitted by
+ * CPP_ASSERT_STATIC_KEY macro
+ */
+struct StaticKeyEntry
+{
+    std::uintptr_t code_;
+    std::uintptr_t target_;
+    const cppassert::AssertionSite *site_;
+};
+
+const std::size_t INSTRUCTION_SIZE = 5;
+const unsigned char JMP_OPCODE = 0xe9;
+const unsigned char NOP[INSTRUCTION_SIZE] = {0x0f, 0x1f, 0x44, 0x00, 0x00};
+const unsigned char INT3_OPCODE = 0xcc;
+
+/*
+ * Commands of membarrier(2), defined here because <linux/membarrier.h>
+ * of older kernels lacks them
+ */
+const int MEMBARRIER_CMD_PRIVATE_EXPEDITED_SYNC_CORE = (1<<5);
+const int MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED_SYNC_CORE = (1<<6);
+
+} //anonymous
+
+extern "C"
+{
+extern const StaticKeyEntry __start_cppassert_static_keys[]
+    __attribute__((weak, visibility("hidden")));
+extern const StaticKeyEntry __stop_cppassert_static_keys[]
+    __attribute__((weak, visibility("hidden")));
+}
+
+namespace cppassert
+{
+namespace internal
+{
+
+static bool isEntryLess(const StaticKeyEntry &first,
+                        const StaticKeyEntry &second)
+{
+    return std::less<const AssertionSite *>()(first.site_, second.site_);
+}
+
+/*
+ * Site inlined into several functions has several entries, entries are
+ * sorted by site so that all of them can be found at once. Instruction
+ * addresses are sorted separately for the breakpoint handler.
+ */
+struct StaticKeys
+{
+    std::vector<StaticKeyEntry> entries_;
+    std::vector<std::uintptr_t> code_;
+};
+
+static const StaticKeys &getStaticKeys()
+{
+    static const StaticKeys keys = []()
+    {
+        StaticKeys result;
+        if(__start_cppassert_static_keys!=nullptr
+           && __stop_cppassert_static_keys!=nullptr)
+        {
+            result.entries_.assign(__start_cppassert_static_keys,
+                                   __stop_cppassert_static_keys);
+        }
+        std::sort(result.entries_.begin(), result.entries_.end(),
+                  isEntryLess);
+        for(const StaticKeyEntry &entry: result.entries_)
+        {
+            result.code_.push_back(entry.code_);
+        }
+        std::sort(result.code_.begin(), result.code_.end());
+        return result;
+    }();
+    return keys;
+}
+
+static struct sigaction previousTrapAction;
+
+/*
+ * Thread which hits breakpoint placed over a site being patched returns
+ * to the site and executes it again once patching is finished. Other
+ * breakpoints are passed to the previous handler.
+ */
+static void onTrap(int signal, siginfo_t *info, void *context)
+{
+    greg_t &ip = static_cast<ucontext_t *>(context)
+                        ->uc_mcontext.gregs[REG_RIP];
+    const std::uintptr_t code = static_cast<std::uintptr_t>(ip)-1;
+    const std::vector<std::uintptr_t> &sites = getStaticKeys().code_;
+    if(std::binary_search(sites.begin(), sites.end(), code))
+    {
+        ip = static_cast<greg_t>(code);
+        return;
+    }
+    if((previousTrapAction.sa_flags & SA_SIGINFO)!=0)
+    {
+        previousTrapAction.sa_sigaction(signal, info, context);
+    }
+    else if(previousTrapAction.sa_handler==SIG_DFL)
+    {
+        std::signal(SIGTRAP, SIG_DFL);
+        std::raise(SIGTRAP);
+    }
+    else if(previousTrapAction.sa_handler!=SIG_IGN)
+    {
+        previousTrapAction.sa_handler(signal);
+    }
+}
+
+/*
+ * Serializes instruction stream of every core running a thread of the
+ * process, so that none of them executes stale instruction bytes
+ */
+static bool synchronizeCores()
+{
+    return (::syscall(__NR_membarrier,
+                      MEMBARRIER_CMD_PRIVATE_EXPEDITED_SYNC_CORE, 0)==0);
+}
+
+/*
+ * Registers process for core serializing membarrier and installs
+ * breakpoint handler, patching is refused if kernel doesn't support it
+ */
+static bool isPatchingSupported()
+{
+    static const bool supported = []()
+    {
+        getStaticKeys();
+        if(::syscall(__NR_membarrier,
+                     MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED_SYNC_CORE,
+                     0)!=0)
+        {
+            return false;
+        }
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_sigaction = onTrap;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        return (::sigaction(SIGTRAP, &action, &previousTrapAction)==0);
+    }();
+    return supported;
+}
+
+/*
+ * Returns protection of mapping containing address, or -1 if it isn't
+ * mapped
+ */
+static int getProtection(std::uintptr_t address)
+{
+    std::FILE *maps = std::fopen("/proc/self/maps", "r");
+    if(maps==nullptr)
+    {
+        return -1;
+    }
+    int result = -1;
+    char line[512];
+    while(result<0 && std::fgets(line, sizeof(line), maps)!=nullptr)
+    {
+        unsigned long long start = 0;
+        unsigned long long end = 0;
+        char permissions[5] = {};
+        if(std::sscanf(line, "%llx-%llx %4s", &start, &end, permissions)==3
+           && address>=start && address<end)
+        {
+            result = ((permissions[0]=='r') ? PROT_READ : 0)
+                    | ((permissions[1]=='w') ? PROT_WRITE : 0)
+                    | ((permissions[2]=='x') ? PROT_EXEC : 0);
+        }
+    }
+    std::fclose(maps);
+    return result;
+}
+
+static void storeBytes(std::uintptr_t address, const unsigned char *bytes,
+                       std::size_t size)
+{
+    unsigned char *code = reinterpret_cast<unsigned char *>(address);
+    for(std::size_t i = 0; i<size; ++i)
+    {
+        __atomic_store_n(code+i, bytes[i], __ATOMIC_RELAXED);
+    }
+}
+
+/*
+ * Site may be executed by other threads while it's patched. Intel SDM
+ * doesn't guarantee they observe either old or new instruction when it's
+ * simply overwritten, so it's rewritten the way Linux text_poke_bp does
+ * it: breakpoint is placed over the first byte, then the remaining bytes
+ * and finally the first byte are written, every step followed by
+ * serialization of all cores. Threads that hit the breakpoint meanwhile
+ * restart at the site, see onTrap.
+ */
+static bool patch(const StaticKeyEntry &entry, bool enabled)
+{
+    unsigned char instruction[INSTRUCTION_SIZE];
+    if(enabled)
+    {
+        const std::int32_t offset = static_cast<std::int32_t>(
+                    entry.target_-(entry.code_+INSTRUCTION_SIZE));
+        instruction[0] = JMP_OPCODE;
+        std::memcpy(instruction+1, &offset, sizeof(offset));
+    }
+    else
+    {
+        std::memcpy(instruction, NOP, INSTRUCTION_SIZE);
+    }
+    if(std::memcmp(reinterpret_cast<const void *>(entry.code_),
+                   instruction, INSTRUCTION_SIZE)==0)
+    {
+        return true;
+    }
+
+    const std::uintptr_t pageSize
+            = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const std::uintptr_t page = entry.code_ & ~(pageSize-1);
+    const std::size_t size = (entry.code_+INSTRUCTION_SIZE>page+pageSize)
+                                ? 2*pageSize : pageSize;
+    const int protection = getProtection(entry.code_);
+    if(!isPatchingSupported() || protection<0
+       || getProtection(page+size-1)!=protection
+       || ::mprotect(reinterpret_cast<void *>(page), size,
+                     protection|PROT_WRITE)!=0)
+    {
+        return false;
+    }
+    storeBytes(entry.code_, &INT3_OPCODE, 1);
+    bool result = synchronizeCores();
+    storeBytes(entry.code_+1, instruction+1, INSTRUCTION_SIZE-1);
+    result = synchronizeCores() && result;
+    storeBytes(entry.code_, instruction, 1);
+    result = synchronizeCores() && result;
+    ::mprotect(reinterpret_cast<void *>(page), size, protection);
+    return result;
+}
+
+bool setStaticKeysEnabled(const AssertionSite *site, bool enabled)
+{
+    const std::vector<StaticKeyEntry> &entries = getStaticKeys().entries_;
+    StaticKeyEntry key = {0, 0, site};
+    auto range = std::equal_range(entries.begin(), entries.end(), key,
+                                  isEntryLess);
+    if(range.first==range.second)
+    {
+        return true;
+    }
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    bool result = true;
+    for(auto entry = range.first; entry!=range.second; ++entry)
+    {
+        result = patch(*entry, enabled) && result;
+    }
+    return result;
+}
+
+std::size_t getStaticKeyCount()
+{
+    return getStaticKeys().entries_.size();
+}
+
+} //internal
+} //cppassert
+
+#else
+
+namespace cppassert
+{
+namespace internal
+{
+
+bool setStaticKeysEnabled(const AssertionSite *, bool)
+{
+    return true;
+}
+
+std::size_t getStaticKeyCount()
+{
+    return 0;
+}
+
+} //internal
+} //cppassert
+
+#endif
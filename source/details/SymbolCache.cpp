@@ -0,0 +1,300 @@
+#include <cppassert/details/SymbolCache.hpp>
+#include <cppassert/details/ElfSymbolTable.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#ifdef CPP_ASSERT_HAVE_ELF_SYMBOLS
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cppassert
+{
+namespace internal
+{
+
+namespace
+{
+const char Magic[8] = {'c', 'p', 'p', 'a', 's', 's', 'r', 't'};
+const std::uint32_t Version = 1;
+const std::uint32_t ByteOrder = 0x01020304;
+const std::size_t MaxBuildIdSize = 128;
+const std::size_t Alignment = 8;
+
+/*
+ * Build-id is stored so that file renamed by hand is not trusted
+ */
+struct Header
+{
+    char magic[sizeof(Magic)];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t pointerSize;
+    std::uint32_t kind;
+    char buildId[MaxBuildIdSize];
+    std::uint64_t sectionOffsets[SymbolCacheFile::MaxSections];
+    std::uint64_t sectionSizes[SymbolCacheFile::MaxSections];
+};
+
+std::mutex directoryMutex;
+std::string directory;
+bool isDirectoryInitialized = false;
+
+std::string getDirectoryLocked()
+{
+    if(!isDirectoryInitialized)
+    {
+        isDirectoryInitialized = true;
+        const char *variable = std::getenv("CPPASSERT_SYMBOL_CACHE");
+        if(variable!=nullptr)
+        {
+            directory = variable;
+        }
+    }
+    return directory;
+}
+
+std::size_t getAligned(std::size_t size)
+{
+    return (size+Alignment-1) & ~(Alignment-1);
+}
+
+bool isValidBuildId(const std::string &buildId)
+{
+    return (!buildId.empty() && buildId.size()<MaxBuildIdSize
+            && buildId.find_first_not_of("0123456789abcdef")
+                    ==std::string::npos);
+}
+
+const char *getSuffix(SymbolCacheFile::Kind kind)
+{
+    return (kind==SymbolCacheFile::Kind::Symbols) ? ".sym" : ".line";
+}
+
+Header createHeader(const std::string &buildId, SymbolCacheFile::Kind kind)
+{
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.byteOrder = ByteOrder;
+    header.pointerSize = sizeof(void *);
+    header.kind = static_cast<std::uint32_t>(kind);
+    std::memcpy(header.buildId, buildId.data(), buildId.size());
+    return header;
+}
+
+#ifdef CPP_ASSERT_HAVE_ELF_SYMBOLS
+bool writeAll(int file, const char *data, std::size_t size)
+{
+    while(size>0)
+    {
+        const ssize_t written = ::write(file, data, size);
+        if(written<0 && errno==EINTR)
+        {
+            continue;
+        }
+        if(written<=0)
+        {
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+#endif
+} //anonymous
+
+SymbolCacheFile::SymbolCacheFile(SymbolCacheFile &&other) noexcept
+    :data_(other.data_), size_(other.size_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+SymbolCacheFile &SymbolCacheFile::operator=(SymbolCacheFile &&other) noexcept
+{
+    if(this!=&other)
+    {
+        unmap();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+    return (*this);
+}
+
+SymbolCacheFile::~SymbolCacheFile()
+{
+    unmap();
+}
+
+void SymbolCacheFile::setDirectory(const std::string &cacheDirectory)
+{
+    std::lock_guard<std::mutex> lock(directoryMutex);
+    isDirectoryInitialized = true;
+    directory = cacheDirectory;
+#ifdef CPP_ASSERT_HAVE_ELF_SYMBOLS
+    if(!directory.empty())
+    {
+        ::mkdir(directory.c_str(), 0755);
+    }
+#endif
+}
+
+std::string SymbolCacheFile::getDirectory()
+{
+    std::lock_guard<std::mutex> lock(directoryMutex);
+    return getDirectoryLocked();
+}
+
+bool SymbolCacheFile::isValid() const
+{
+    return (data_!=nullptr);
+}
+
+SymbolCacheFile::Section SymbolCacheFile::getSection(std::size_t index) const
+{
+    Section section;
+    if(data_!=nullptr && index<MaxSections)
+    {
+        const Header *header = reinterpret_cast<const Header *>(data_);
+        section.data = data_+header->sectionOffsets[index];
+        section.size = static_cast<std::size_t>(header->sectionSizes[index]);
+    }
+    return section;
+}
+
+#ifdef CPP_ASSERT_HAVE_ELF_SYMBOLS
+SymbolCacheFile SymbolCacheFile::open(const std::string &buildId, Kind kind)
+{
+    SymbolCacheFile result;
+    const std::string cacheDirectory = getDirectory();
+    if(cacheDirectory.empty() || !isValidBuildId(buildId))
+    {
+        return result;
+    }
+    const std::string path = cacheDirectory+'/'+buildId+getSuffix(kind);
+    const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(file<0)
+    {
+        return result;
+    }
+    struct stat status;
+    void *data = MAP_FAILED;
+    std::size_t size = 0;
+    if(::fstat(file, &status)==0
+       && static_cast<std::size_t>(status.st_size)>=sizeof(Header))
+    {
+        size = static_cast<std::size_t>(status.st_size);
+        data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    ::close(file);
+    if(data==MAP_FAILED)
+    {
+        return result;
+    }
+    result.data_ = static_cast<const char *>(data);
+    result.size_ = size;
+
+    const Header expected = createHeader(buildId, kind);
+    const Header *header = reinterpret_cast<const Header *>(data);
+    bool isValid = (std::memcmp(header, &expected
+                                , offsetof(Header, sectionOffsets))==0);
+    for(std::size_t i = 0; i<MaxSections && isValid; ++i)
+    {
+        isValid = (header->sectionOffsets[i]%Alignment==0
+                   && header->sectionOffsets[i]<=size
+                   && header->sectionSizes[i]
+                        <=size-header->sectionOffsets[i]);
+    }
+    if(!isValid)
+    {
+        result.unmap();
+    }
+    return result;
+}
+
+bool SymbolCacheFile::write(const std::string &buildId, Kind kind,
+                            const Section *sections, std::size_t count)
+{
+    const std::string cacheDirectory = getDirectory();
+    if(cacheDirectory.empty() || !isValidBuildId(buildId)
+       || count>MaxSections)
+    {
+        return false;
+    }
+    Header header = createHeader(buildId, kind);
+    std::size_t offset = getAligned(sizeof(Header));
+    for(std::size_t i = 0; i<count; ++i)
+    {
+        header.sectionOffsets[i] = offset;
+        header.sectionSizes[i] = sections[i].size;
+        offset = getAligned(offset+sections[i].size);
+    }
+    const std::string path = cacheDirectory+'/'+buildId+getSuffix(kind);
+    const std::string temporaryPath = path+'.'+std::to_string(::getpid())
+                                      +".tmp";
+    const int file = ::open(temporaryPath.c_str()
+                            , O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC
+                            , 0644);
+    if(file<0)
+    {
+        return false;
+    }
+    static const char padding[Alignment] = {};
+    bool isWritten = writeAll(file, reinterpret_cast<const char *>(&header)
+                              , sizeof(header));
+    std::size_t position = sizeof(header);
+    for(std::size_t i = 0; i<count && isWritten; ++i)
+    {
+        isWritten = writeAll(file, padding
+                             , header.sectionOffsets[i]-position)
+                    && writeAll(file, sections[i].data, sections[i].size);
+        position = header.sectionOffsets[i]+sections[i].size;
+    }
+    isWritten = (::close(file)==0) && isWritten;
+    if(!isWritten || std::rename(temporaryPath.c_str(), path.c_str())!=0)
+    {
+        ::unlink(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void SymbolCacheFile::unmap()
+{
+    if(data_!=nullptr)
+    {
+        ::munmap(const_cast<char *>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+#else
+SymbolCacheFile SymbolCacheFile::open(const std::string &, Kind)
+{
+    return SymbolCacheFile();
+}
+
+bool SymbolCacheFile::write(const std::string &, Kind,
+                            const Section *, std::size_t)
+{
+    return false;
+}
+
+void SymbolCacheFile::unmap()
+{
+    data_ = nullptr;
+    size_ = 0;
+}
+#endif /* CPP_ASSERT_HAVE_ELF_SYMBOLS */
+
+} //internal
+} //cppassert
@@ -0,0 +1,108 @@
+#include <cppassert/details/WarmUp.hpp>
+#include <cppassert/details/DwarfLineTable.hpp>
+#include <cppassert/details/ElfSymbolTable.hpp>
+#include <cppassert/details/StackTrace.hpp>
+#include <cppassert/CppAssert.hpp>
+#include <cppassert/TraceId.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#ifdef CPP_ASSERT_HAVE_BACKTRACE
+#include <execinfo.h>
+#endif
+
+namespace cppassert
+{
+namespace internal
+{
+
+using SteadyClock = std::chrono::steady_clock;
+
+static std::mutex warmUpMutex;
+static WarmUpTimes warmUpTimes;
+
+static std::chrono::nanoseconds getElapsed(SteadyClock::time_point *start)
+{
+    const SteadyClock::time_point now = SteadyClock::now();
+    const std::chrono::nanoseconds result
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    now-(*start));
+    *start = now;
+    return result;
+}
+
+/*
+ * Modules of captured stack are the ones that fail usually, their line
+ * tables are decoded now instead of on first failure
+ */
+static void buildSymbolIndex(const StackTrace &frames)
+{
+#ifdef CPP_ASSERT_HAVE_ELF_SYMBOLS
+    const ElfSymbolTable &table = ElfSymbolTable::getInstance();
+#ifdef CPP_ASSERT_HAVE_DWARF_LINES
+    for(std::size_t i=0; i<frames.size(); ++i)
+    {
+        ElfSymbolTable::Symbol symbol;
+        if(table.findSymbol(frames[i].getAddress(), &symbol))
+        {
+            DwarfLineTable::getTable(symbol.module);
+        }
+    }
+#else
+    (void)table;
+    (void)frames;
+#endif
+#else
+    (void)frames;
+#endif
+}
+
+WarmUpTimes warmUp()
+{
+    std::lock_guard<std::mutex> lock(warmUpMutex);
+    WarmUpTimes times;
+    const SteadyClock::time_point begin = SteadyClock::now();
+    SteadyClock::time_point start = begin;
+
+#ifdef CPP_ASSERT_HAVE_BACKTRACE
+    //the first call loads libgcc_s also when other unwinder is selected
+    void *address = nullptr;
+    ::backtrace(&address, 1);
+#endif
+    StackTrace frames = StackTrace::getStackTrace();
+    times.capture = getElapsed(&start);
+
+    buildSymbolIndex(frames);
+    times.symbolIndex = getElapsed(&start);
+
+    frames.symbolize();
+    times.symbolization = getElapsed(&start);
+
+    CppAssert::getInstance()->formatStackTrace(frames);
+    getTraceCount();
+    times.formatting = getElapsed(&start);
+
+    times.total = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    start-begin);
+    warmUpTimes = times;
+    return times;
+}
+
+WarmUpTimes getWarmUpTimes()
+{
+    std::lock_guard<std::mutex> lock(warmUpMutex);
+    return warmUpTimes;
+}
+
+void warmUpFromEnvironment()
+{
+    const char *variable = std::getenv("CPPASSERT_WARMUP");
+    if(variable!=nullptr && std::strcmp(variable, "1")==0)
+    {
+        warmUp();
+    }
+}
+
+} //internal
+} //cppassert
@@ -1,5 +1,36 @@
 #include <gtest/gtest.h>
 #include <cppassert/Assertion.hpp>
+#include <string>
+
+namespace
+{
+int evaluations = 0;
+
+int countEvaluation(int value)
+{
+    ++evaluations;
+    return value;
+}
+}
+
+TEST(AssertAlwaysTest, predicateArgumentsAreEvaluatedOnce)
+{
+    evaluations = 0;
+    CPP_ASSERT_ALWAYS_EQ(countEvaluation(1), countEvaluation(1));
+    CPP_ASSERT_ALWAYS_NE(countEvaluation(1), countEvaluation(2));
+    CPP_ASSERT_ALWAYS_LT(countEvaluation(1), countEvaluation(2), "message");
+    CPP_ASSERT_ALWAYS_LE(countEvaluation(1), countEvaluation(1));
+    CPP_ASSERT_ALWAYS_GT(countEvaluation(2), countEvaluation(1));
+    CPP_ASSERT_ALWAYS_GE(countEvaluation(2), countEvaluation(2), "message");
+    EXPECT_EQ(12, evaluations);
+}
+
+TEST(AssertAlwaysTest, predicateArgumentsMayBeTemporaries)
+{
+    const std::string text("text");
+    CPP_ASSERT_ALWAYS_EQ(std::string("text"), text);
+    CPP_ASSERT_ALWAYS_NE(text+"s", std::string("text"), "message");
+}
 
 //gtest doesnt support death tests on free bsd
 #if defined(__linux__)
@@ -103,4 +134,14 @@ TEST(AssertAlwaysTest, assertLeShouldAbort)
             , ".*Assertion failure.*");
 
 }
+
+TEST(AssertAlwaysTest, failureReportsValuesEvaluatedOnce)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    int counter = 0;
+    EXPECT_EXIT(
+            CPP_ASSERT_ALWAYS_EQ(++counter, 5, "message")
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*\\+\\+counter evaluated to: 1\n.*message.*");
+}
 #endif /* defined(__linux__) */
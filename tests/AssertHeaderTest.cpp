@@ -0,0 +1,78 @@
+#include <cppassert/Assert.hpp>
+
+#if defined(_GLIBCXX_SSTREAM) || defined(_GLIBCXX_IOMANIP) \
+    || defined(_GLIBCXX_OSTREAM) || defined(_GLIBCXX_MEMORY) \
+    || defined(_GLIBCXX_FUNCTIONAL) || defined(_GLIBCXX_MUTEX) \
+    || defined(_GLIBCXX_STRING) || defined(_GLIBCXX_ATOMIC) \
+    || defined(_GLIBCXX_TYPE_TRAITS)
+#   error "cppassert/Assert.hpp should not include iostreams"
+#endif
+
+struct Named
+{
+    const char *name;
+};
+
+//declared only, <ostream> isn't included to define it
+std::ostream &operator<<(std::ostream &stream, const Named &named);
+
+namespace
+{
+enum Color
+{
+    Red,
+    Green
+};
+
+struct Convertible
+{
+    operator int() const;
+};
+
+//same results as in translation units which include <ostream>
+static_assert(cppassert::internal::IsStreamable<Named>::value,
+              "operator<< is found without complete std::ostream");
+static_assert(!cppassert::internal::IsStreamable<Convertible>::value,
+              "member operators of std::ostream are not considered");
+
+//uses every macro family with only cppassert/Assert.hpp included
+int lightweightSites(int value, const char *text, const int *pointer)
+{
+    CPP_ASSERT_ALWAYS(value>0, "value "<<value<<" text "<<text);
+    CPP_ASSERT_ALWAYS_TRUE(value>0, 1.5<<' '<<pointer<<' '<<nullptr);
+    CPP_ASSERT_ALWAYS_FALSE(value<0);
+    CPP_ASSERT_ALWAYS_EQ(value, 1, "color "<<Green);
+    CPP_ASSERT_ALWAYS_NE(Red, Green);
+    CPP_ASSERT_ALWAYS_LT(value, 2L, 'c'<<value);
+    CPP_ASSERT_SAMPLED(2, value>0, "sampled");
+    CPP_ASSERT_CHEAP(value>0);
+    CPP_ASSERT(value>0, "value "<<value);
+    CPP_ASSERT_EQ(text, text);
+    return value;
+}
+
+void failedColor(Color color)
+{
+    CPP_ASSERT_ALWAYS_EQ(color, Red, "pointer "<<static_cast<void *>(nullptr));
+}
+}
+
+#include <gtest/gtest.h>
+
+TEST(AssertHeaderTest, macrosCompileWithoutIostreams)
+{
+    const int value = 1;
+    EXPECT_EQ(1, lightweightSites(1, "text", &value));
+}
+
+//gtest doesnt support death tests on free bsd
+#if defined(__linux__)
+TEST(AssertHeaderTest, enumIsReportedAsInteger)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(
+            failedColor(Green)
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*color evaluated to: 1\n.*Red evaluated to: 0\n.*pointer \\(null\\).*");
+}
+#endif
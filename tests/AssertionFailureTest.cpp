@@ -76,3 +76,68 @@ test
 )";
     EXPECT_TRUE(assertion.toString().find(expectedMessage)==0);
 }
+
+TEST_F(AssertionFailureTest, stackTraceIsRenderedOnDemand)
+{
+    std::string message("my message");
+    cppassert::AssertionFailure assertion(0xff
+                                , "file"
+                                , "my_function"
+                                , std::move(message));
+    bool symbolized = true;
+    cppassert::CppAssert::getInstance()->setAssertionHandler(
+        [&symbolized](const cppassert::AssertionFailure &failure)
+        {
+            const auto &frames = failure.getStackFrames();
+            symbolized = (frames.size()>0 && frames[0].isSymbolized());
+        });
+    assertion.onAssertionFailure(cppassert::AssertionMessage());
+    cppassert::CppAssert::getInstance()->setDefaultHandler();
+
+    EXPECT_FALSE(symbolized);
+    const auto &frames = assertion.getStackFrames();
+    if(frames.size()>0)
+    {
+        EXPECT_FALSE(assertion.getStackTrace().empty());
+        EXPECT_TRUE(frames[0].isSymbolized());
+    }
+}
+
+TEST_F(AssertionFailureTest, stackDepthOfSite)
+{
+    static cppassert::AssertionSite site("file", 10, "my_function", "a"
+                                    , nullptr
+                                    , cppassert::AssertionKind::Statement
+                                    , cppassert::AssertionLevel::Always);
+    site.setStackDepth(2);
+    cppassert::AssertionFailure assertion(&site, std::string("message"));
+    cppassert::CppAssert::getInstance()->setAssertionHandler(
+        [](const cppassert::AssertionFailure &)
+        {
+        });
+    assertion.onAssertionFailure(cppassert::AssertionMessage());
+    cppassert::CppAssert::getInstance()->setDefaultHandler();
+
+    EXPECT_GE(2u, assertion.getStackFrames().size());
+}
+
+TEST_F(AssertionFailureTest, rawStackTrace)
+{
+    cppassert::AssertionFailure assertion(0xff, "file", "my_function"
+                                          , std::string("message"));
+    EXPECT_TRUE(assertion.getRawStackTrace().empty());
+    cppassert::CppAssert::getInstance()->setAssertionHandler(
+        [](const cppassert::AssertionFailure &)
+        {
+        });
+    assertion.onAssertionFailure(cppassert::AssertionMessage());
+    cppassert::CppAssert::getInstance()->setDefaultHandler();
+
+    ASSERT_TRUE(assertion.getModuleMap()!=nullptr);
+    if(assertion.getStackFrames().size()>0)
+    {
+        EXPECT_EQ(0u, assertion.getRawStackTrace().find("cppassert-frames"));
+        EXPECT_NE(std::string::npos
+                  , assertion.toString().find("cppassert-frames"));
+    }
+}
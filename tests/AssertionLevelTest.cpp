@@ -0,0 +1,87 @@
+#define CPP_ASSERT_LEVEL CPP_ASSERT_LEVEL_AUDIT
+#include <cppassert/Assertion.hpp>
+#include <cppassert/CppAssert.hpp>
+#include <gtest/gtest.h>
+
+#if !defined(CPP_ASSERT_CHEAP_ENABLED) || !defined(CPP_ASSERT_ENABLED) \
+    || !defined(CPP_ASSERT_AUDIT_ENABLED)
+#   error "All levels should be compiled in"
+#endif
+
+namespace
+{
+//evaluations counts how many times predicate was evaluated
+void levelSites(int &cheap, int &debug, int &audit, int &always)
+{
+    CPP_ASSERT_CHEAP(++cheap>0);
+    CPP_ASSERT(++debug>0, "debug "<<debug);
+    CPP_ASSERT_AUDIT(++audit>0, "audit "<<audit);
+    CPP_ASSERT_ALWAYS(++always>0);
+}
+
+class AssertionLevelTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        level_ = cppassert::CppAssert::getAssertionLevel();
+    }
+
+    virtual void TearDown()
+    {
+        cppassert::CppAssert::setAssertionLevel(level_);
+    }
+
+    void expectEvaluations(cppassert::AssertionLevel level,
+                           int cheap, int debug, int audit)
+    {
+        cppassert::CppAssert::setAssertionLevel(level);
+        EXPECT_EQ(level, cppassert::CppAssert::getAssertionLevel());
+        int evaluations[4] = {0, 0, 0, 0};
+        levelSites(evaluations[0], evaluations[1], evaluations[2]
+                   , evaluations[3]);
+        EXPECT_EQ(cheap, evaluations[0]);
+        EXPECT_EQ(debug, evaluations[1]);
+        EXPECT_EQ(audit, evaluations[2]);
+        EXPECT_EQ(1, evaluations[3]);
+    }
+
+    cppassert::AssertionLevel level_;
+};
+}
+
+TEST_F(AssertionLevelTest, defaultLevel)
+{
+    EXPECT_EQ(cppassert::AssertionLevel::Debug, level_);
+}
+
+TEST_F(AssertionLevelTest, runtimeThreshold)
+{
+    using cppassert::AssertionLevel;
+    expectEvaluations(AssertionLevel::Always, 0, 0, 0);
+    expectEvaluations(AssertionLevel::Cheap, 1, 0, 0);
+    expectEvaluations(AssertionLevel::Debug, 1, 1, 0);
+    expectEvaluations(AssertionLevel::Audit, 1, 1, 1);
+}
+
+//gtest doesnt support death tests on free bsd
+#if defined(__linux__)
+TEST_F(AssertionLevelTest, auditShouldAbort)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    cppassert::CppAssert::setAssertionLevel(cppassert::AssertionLevel::Audit);
+    EXPECT_EXIT(
+            CPP_ASSERT_AUDIT(1==2, "audit")
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*Assertion failure.*1==2.*audit.*");
+}
+
+TEST_F(AssertionLevelTest, cheapShouldAbort)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(
+            CPP_ASSERT_CHEAP(false)
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*Assertion failure.*false.*");
+}
+#endif
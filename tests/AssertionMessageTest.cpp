@@ -1,6 +1,29 @@
 #include <gtest/gtest.h>
 #include <cppassert/details/AssertionMessage.hpp>
 #include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace
+{
+enum Fruit
+{
+    Apple,
+    Pear
+};
+
+enum class Color
+{
+    Red,
+    Green
+};
+
+std::ostream &operator<<(std::ostream &stream, Color color)
+{
+    return stream<<((color==Color::Red) ? "red" : "green");
+}
+}
 
 TEST(AssertionMessageTest, booleanTrue)
 {
@@ -107,4 +130,99 @@ TEST(AssertionMessageTest, pointerTest)
     cppassert::internal::AssertionMessage message;
     message<<ptr;
     EXPECT_EQ(expectedMessage, message.str());
-}
\ No newline at end of file
+}
+TEST(AssertionMessageTest, stdStringTest)
+{
+    const std::string text("text");
+    cppassert::internal::AssertionMessage message;
+    message<<text<<' '<<std::string("temporary");
+    EXPECT_EQ("text temporary", message.str());
+    EXPECT_EQ(14u, message.size());
+}
+
+//formatting of numbers and strings should match std::ostream
+#define EXPECT_SAME_AS_STREAM(values) \
+    { \
+        std::ostringstream expected; \
+        expected<<values; \
+        cppassert::internal::AssertionMessage message; \
+        message<<values; \
+        EXPECT_EQ(expected.str(), message.str()); \
+    }
+
+TEST(AssertionMessageTest, formatLikeStream)
+{
+    const short negativeShort = -1;
+    const long long negativeLong = -1234567890123LL;
+    const unsigned long long maxValue = 18446744073709551615ULL;
+    EXPECT_SAME_AS_STREAM(negativeShort<<' '<<negativeLong<<' '<<maxValue);
+    EXPECT_SAME_AS_STREAM(std::hex<<negativeShort<<' '<<negativeLong);
+    EXPECT_SAME_AS_STREAM(std::oct<<std::showbase<<8<<' '<<0<<' '<<std::dec<<8);
+    EXPECT_SAME_AS_STREAM(std::hex<<std::uppercase<<std::showbase<<255u);
+    EXPECT_SAME_AS_STREAM(std::showpos<<5<<' '<<0<<' '<<-5<<' '<<5u);
+    EXPECT_SAME_AS_STREAM(std::setw(6)<<42<<'|'<<std::setw(3)<<"ab"<<'|');
+    EXPECT_SAME_AS_STREAM(std::left<<std::setw(4)<<1<<'|'<<2);
+    EXPECT_SAME_AS_STREAM(std::setfill('0')<<std::setw(5)<<-42);
+    EXPECT_SAME_AS_STREAM(std::internal<<std::setfill('0')<<std::setw(8)<<-42);
+    EXPECT_SAME_AS_STREAM(std::internal<<std::setfill('0')<<std::setw(6)
+                          <<std::hex<<std::showbase<<255);
+    EXPECT_SAME_AS_STREAM(1.5<<' '<<0.1f<<' '<<1e100<<' '<<-0.0<<' '<<3.0L);
+    EXPECT_SAME_AS_STREAM(std::setprecision(12)<<3.14159265358979);
+    EXPECT_SAME_AS_STREAM(std::fixed<<std::setprecision(2)<<3.14159<<' '<<1e20);
+    EXPECT_SAME_AS_STREAM(std::scientific<<std::uppercase<<12345.0);
+    EXPECT_SAME_AS_STREAM(std::showpoint<<2.0<<' '<<std::noshowpoint<<2.0);
+    EXPECT_SAME_AS_STREAM('a'<<static_cast<signed char>('b')
+                          <<static_cast<unsigned char>('c'));
+}
+
+TEST(AssertionMessageTest, longMessageTest)
+{
+    const std::string text(1000, 'x');
+    cppassert::internal::AssertionMessage message;
+    for(std::size_t i = 0; i<text.size(); i+=10)
+    {
+        message<<"xxxxxxxxxx";
+    }
+    message<<std::fixed<<1e300;
+    EXPECT_EQ(text+std::to_string(1e300), message.str());
+}
+
+TEST(AssertionMessageTest, moveTest)
+{
+    cppassert::internal::AssertionMessage inlineMessage;
+    inlineMessage<<"inline "<<1;
+    cppassert::internal::AssertionMessage heapMessage;
+    heapMessage<<std::string(1000, 'y');
+
+    cppassert::internal::AssertionMessage moved(std::move(inlineMessage));
+    EXPECT_EQ("inline 1", moved.str());
+    EXPECT_TRUE(inlineMessage.empty());
+
+    moved = std::move(heapMessage);
+    EXPECT_EQ(std::string(1000, 'y'), moved.str());
+    EXPECT_TRUE(heapMessage.empty());
+
+    CustomOperatorType custom;
+    moved<<custom;
+    cppassert::internal::AssertionMessage movedAgain(std::move(moved));
+    movedAgain<<custom;
+    EXPECT_EQ(std::string(1000, 'y')+"255 Test255 Test", movedAgain.str());
+}
+
+TEST(AssertionMessageTest, setWidthTest)
+{
+    cppassert::internal::AssertionMessage message;
+    message.setWidth(4);
+    message<<7<<' ';
+    message.setFill('.');
+    message.setWidth(3);
+    message<<"a"<<'|';
+    EXPECT_EQ("   7 ..a|", message.str());
+}
+
+TEST(AssertionMessageTest, enumTest)
+{
+    cppassert::internal::AssertionMessage message;
+    message<<Pear<<' '<<Color::Green;
+    EXPECT_EQ("1 green", message.str());
+}
@@ -0,0 +1,273 @@
+#include <cppassert/Assertion.hpp>
+#include <cppassert/CppAssert.hpp>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <cstdlib>
+
+namespace
+{
+const std::uint32_t FIRST_SITE_LINE = __LINE__ + 4;
+void assertionSites(int value)
+{
+    //each assertion has to be in separate line
+    CPP_ASSERT_ALWAYS(value>=0);
+    CPP_ASSERT_ALWAYS_TRUE(value>=0, "value "<<value);
+    CPP_ASSERT_ALWAYS_FALSE(value<0);
+    CPP_ASSERT_ALWAYS_EQ(value, value);
+    CPP_ASSERT_ALWAYS_NE(value, value+1, "value "<<value);
+    CPP_ASSERT_ALWAYS_LT(value, value+1);
+    CPP_ASSERT_ALWAYS_LE(value, value);
+    CPP_ASSERT_ALWAYS_GT(value+1, value);
+    CPP_ASSERT_ALWAYS_GE(value, value);
+}
+
+const std::uint32_t COUNTED_SITE_LINE = __LINE__ + 4;
+int countedSite(int &evaluations)
+{
+    //evaluations counts how many times predicate was evaluated
+    CPP_ASSERT_ALWAYS(++evaluations>0);
+    return evaluations;
+}
+
+std::vector<const cppassert::AssertionSite *> getSitesOfThisFile()
+{
+    std::vector<const cppassert::AssertionSite *> result;
+    for(const cppassert::AssertionSite *site
+            : cppassert::CppAssert::getAssertionSites())
+    {
+        if(std::strcmp(site->getFile(), __FILE__)==0)
+        {
+            result.push_back(site);
+        }
+    }
+    return result;
+}
+}
+
+TEST(AssertionSiteTest, accessors)
+{
+    static cppassert::AssertionSite site("file"
+                                , 10
+                                , "function"
+                                , "value1"
+                                , "value2"
+                                , cppassert::AssertionKind::Le
+                                , cppassert::AssertionLevel::Debug);
+    EXPECT_STREQ("file", site.getFile());
+    EXPECT_EQ(10u, site.getLine());
+    EXPECT_STREQ("function", site.getFunction());
+    EXPECT_STREQ("value1", site.getExpression());
+    EXPECT_STREQ("value2", site.getSecondExpression());
+    EXPECT_STREQ("<=", site.getPredicate());
+    EXPECT_EQ(cppassert::AssertionKind::Le, site.getKind());
+    EXPECT_EQ(cppassert::AssertionLevel::Debug, site.getLevel());
+}
+
+TEST(AssertionSiteTest, expressionHash)
+{
+    cppassert::AssertionSite statement("", 0, "", "a", nullptr
+                                    , cppassert::AssertionKind::Statement
+                                    , cppassert::AssertionLevel::Always);
+    EXPECT_EQ(0xe40c292cu, statement.getExpressionHash());
+    cppassert::AssertionSite predicate("", 0, "", "a", "b"
+                                    , cppassert::AssertionKind::Eq
+                                    , cppassert::AssertionLevel::Always);
+    EXPECT_EQ(0xc3cb497cu, predicate.getExpressionHash());
+}
+
+TEST(AssertionSiteTest, enabled)
+{
+    cppassert::AssertionSite site("", 0, "", "a", nullptr
+                                    , cppassert::AssertionKind::Statement
+                                    , cppassert::AssertionLevel::Always);
+    EXPECT_TRUE(site.isEnabled());
+    site.setEnabled(false);
+    EXPECT_FALSE(site.isEnabled());
+    site.setEnabled(true);
+    EXPECT_TRUE(site.isEnabled());
+}
+
+TEST(AssertionSiteTest, stackDepth)
+{
+    cppassert::AssertionSite site("", 0, "", "a", nullptr
+                                    , cppassert::AssertionKind::Statement
+                                    , cppassert::AssertionLevel::Always);
+    EXPECT_EQ(0u, site.getStackDepth());
+    site.setStackDepth(3);
+    EXPECT_EQ(3u, site.getStackDepth());
+}
+
+TEST(AssertionSiteTest, predicate)
+{
+    using cppassert::AssertionKind;
+    using cppassert::AssertionLevel;
+    const AssertionKind kinds[] = {AssertionKind::Eq, AssertionKind::Ne
+                                , AssertionKind::Lt, AssertionKind::Le
+                                , AssertionKind::Gt, AssertionKind::Ge};
+    const char *predicates[] = {"==", "!=", "<", "<=", ">", ">="};
+    for(std::size_t i = 0; i<sizeof(kinds)/sizeof(kinds[0]); ++i)
+    {
+        cppassert::AssertionSite site("", 0, "", "", "", kinds[i]
+                                    , AssertionLevel::Always);
+        EXPECT_STREQ(predicates[i], site.getPredicate());
+    }
+    cppassert::AssertionSite site("", 0, "", "", nullptr
+                                , AssertionKind::Statement
+                                , AssertionLevel::Always);
+    EXPECT_EQ(nullptr, site.getPredicate());
+}
+
+#ifdef CPP_ASSERT_HAVE_SITE_SECTION
+TEST(AssertionSiteTest, sitesAreListed)
+{
+    using cppassert::AssertionKind;
+    assertionSites(1);
+    const std::vector<const cppassert::AssertionSite *> sites
+            = getSitesOfThisFile();
+    const AssertionKind expectedKinds[] = {AssertionKind::Statement
+                                , AssertionKind::True
+                                , AssertionKind::False
+                                , AssertionKind::Eq
+                                , AssertionKind::Ne
+                                , AssertionKind::Lt
+                                , AssertionKind::Le
+                                , AssertionKind::Gt
+                                , AssertionKind::Ge};
+    const std::size_t expectedCount
+            = sizeof(expectedKinds)/sizeof(expectedKinds[0]);
+    ASSERT_EQ(expectedCount+1, sites.size());
+    for(std::size_t i = 0; i<expectedCount; ++i)
+    {
+        EXPECT_EQ(FIRST_SITE_LINE+i, sites[i]->getLine());
+        EXPECT_EQ(expectedKinds[i], sites[i]->getKind());
+        EXPECT_EQ(cppassert::AssertionLevel::Always, sites[i]->getLevel());
+        EXPECT_NE(nullptr, std::strstr(sites[i]->getFunction()
+                                       , "assertionSites"));
+    }
+    EXPECT_STREQ("value>=0", sites[0]->getExpression());
+    EXPECT_EQ(nullptr, sites[0]->getSecondExpression());
+    EXPECT_STREQ("value<0", sites[2]->getExpression());
+    EXPECT_STREQ("value", sites[4]->getExpression());
+    EXPECT_STREQ("value+1", sites[4]->getSecondExpression());
+    EXPECT_STREQ("!=", sites[4]->getPredicate());
+}
+
+TEST(AssertionSiteTest, disabledSiteIsNotEvaluated)
+{
+    int evaluations = 0;
+    countedSite(evaluations);
+    EXPECT_EQ(1, evaluations);
+
+    EXPECT_EQ(1u, cppassert::CppAssert::setSiteEnabled("AssertionSiteTest.cpp"
+                                                      , COUNTED_SITE_LINE
+                                                      , false));
+    countedSite(evaluations);
+    EXPECT_EQ(1, evaluations);
+
+    EXPECT_EQ(1u, cppassert::CppAssert::setSiteEnabled("AssertionSiteTest.cpp"
+                                                      , COUNTED_SITE_LINE
+                                                      , true));
+    countedSite(evaluations);
+    EXPECT_EQ(2, evaluations);
+}
+
+TEST(AssertionSiteTest, setSiteEnabledMatchesPathComponents)
+{
+    EXPECT_EQ(0u, cppassert::CppAssert::setSiteEnabled("SiteTest.cpp"
+                                                      , COUNTED_SITE_LINE
+                                                      , true));
+    EXPECT_EQ(0u, cppassert::CppAssert::setSiteEnabled("AssertionSiteTest.cpp"
+                                                      , COUNTED_SITE_LINE+1
+                                                      , true));
+    EXPECT_EQ(1u, cppassert::CppAssert::setSiteEnabled(__FILE__
+                                                      , COUNTED_SITE_LINE
+                                                      , true));
+}
+
+TEST(AssertionSiteTest, setSitesEnabledByGlob)
+{
+    const std::size_t count = getSitesOfThisFile().size();
+    EXPECT_EQ(count, cppassert::CppAssert::setSitesEnabled(
+                  "*AssertionSite?est.cpp", false));
+    for(const cppassert::AssertionSite *site: getSitesOfThisFile())
+    {
+        EXPECT_FALSE(site->isEnabled());
+    }
+    int evaluations = 0;
+    countedSite(evaluations);
+    EXPECT_EQ(0, evaluations);
+
+    EXPECT_EQ(count, cppassert::CppAssert::setSitesEnabled(
+                  "*AssertionSiteTest*", true));
+    for(const cppassert::AssertionSite *site: getSitesOfThisFile())
+    {
+        EXPECT_TRUE(site->isEnabled());
+    }
+    EXPECT_EQ(0u, cppassert::CppAssert::setSitesEnabled(
+                  "AssertionSiteTest.cpp", false));
+}
+
+TEST(AssertionSiteTest, setSitesEnabledByHash)
+{
+    const std::vector<const cppassert::AssertionSite *> sites
+            = getSitesOfThisFile();
+    ASSERT_FALSE(sites.empty());
+    const cppassert::AssertionSite *counted = sites.back();
+    EXPECT_LE(1u, cppassert::CppAssert::setSitesEnabledByHash(
+                  counted->getExpressionHash(), false));
+    EXPECT_FALSE(counted->isEnabled());
+    EXPECT_LE(1u, cppassert::CppAssert::setSitesEnabledByHash(
+                  counted->getExpressionHash(), true));
+    EXPECT_TRUE(counted->isEnabled());
+}
+
+TEST(AssertionSiteTest, disableSitesFromEnvironment)
+{
+    const std::vector<const cppassert::AssertionSite *> sites
+            = getSitesOfThisFile();
+    ASSERT_EQ(10u, sites.size());
+    std::string variable = "AssertionSiteTest.cpp:"
+            + std::to_string(FIRST_SITE_LINE)
+            + ", tests/AssertionSiteTest.cpp:"
+            + std::to_string(FIRST_SITE_LINE+1)
+            + " ,,#"
+            + (cppassert::AssertionMessage()<<std::hex
+                    <<sites[2]->getExpressionHash()).str()
+            + ",*NoSuchFile*";
+    ::setenv("CPPASSERT_DISABLE", variable.c_str(), 1);
+    cppassert::internal::disableSitesFromEnvironment();
+    ::unsetenv("CPPASSERT_DISABLE");
+
+    EXPECT_FALSE(sites[0]->isEnabled());
+    EXPECT_FALSE(sites[1]->isEnabled());
+    EXPECT_FALSE(sites[2]->isEnabled());
+    EXPECT_TRUE(sites[3]->isEnabled());
+    EXPECT_EQ(sites.size(), cppassert::CppAssert::setSitesEnabled(
+                  "*AssertionSiteTest.cpp", true));
+}
+
+TEST(AssertionSiteTest, setSitesStackDepth)
+{
+    const std::vector<const cppassert::AssertionSite *> sites
+            = getSitesOfThisFile();
+    EXPECT_EQ(sites.size(), cppassert::CppAssert::setSitesStackDepth(
+                  "*AssertionSiteTest.cpp", 4));
+    for(const cppassert::AssertionSite *site: sites)
+    {
+        EXPECT_EQ(4u, site->getStackDepth());
+    }
+    EXPECT_EQ(sites.size(), cppassert::CppAssert::setSitesStackDepth(
+                  "*AssertionSiteTest.cpp", 0));
+    EXPECT_EQ(0u, sites[0]->getStackDepth());
+}
+
+TEST(AssertionSiteTest, sitesAreUnique)
+{
+    const std::vector<const cppassert::AssertionSite *> &sites
+            = cppassert::CppAssert::getAssertionSites();
+    for(std::size_t i = 1; i<sites.size(); ++i)
+    {
+        EXPECT_NE(sites[i-1], sites[i]);
+    }
+}
+#endif
@@ -0,0 +1,39 @@
+#
+# Size regression test for assertion sites. Expects following variables:
+#
+#  NM           - path to nm tool
+#  BINARY       - binary built from AssertionSizeTest.cpp
+#  SITES        - number of assertion sites in each measured function
+#  MAX_SITE_SIZE - maximum number of bytes a single site may cost in a hot path
+#
+
+execute_process(COMMAND ${NM} --print-size --radix=d ${BINARY}
+                OUTPUT_VARIABLE symbols
+                RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Unable to read symbols from ${BINARY}")
+endif()
+
+function(get_symbol_size name output)
+    string(REGEX MATCH "[0-9]+ ([0-9]+) [Tt] ${name}\n" match "${symbols}")
+    if(NOT match)
+        message(FATAL_ERROR "Symbol ${name} not found in ${BINARY}")
+    endif()
+    set(${output} ${CMAKE_MATCH_1} PARENT_SCOPE)
+endfunction()
+
+get_symbol_size(cppAssertSizeEmpty emptySize)
+
+set(failed FALSE)
+foreach(kind Statement StatementMessage Bool BoolMessage Predicate PredicateMessage)
+    get_symbol_size(cppAssertSize${kind} size)
+    math(EXPR siteSize "(${size} - ${emptySize}) / ${SITES}")
+    message("${kind}: ${size} bytes, ${siteSize} bytes per site (max ${MAX_SITE_SIZE})")
+    if(siteSize GREATER MAX_SITE_SIZE)
+        set(failed TRUE)
+    endif()
+endforeach()
+
+if(failed)
+    message(FATAL_ERROR "Assertion site size exceeds ${MAX_SITE_SIZE} bytes")
+endif()
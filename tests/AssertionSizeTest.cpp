@@ -0,0 +1,72 @@
+/*
+ * Assertion sites used by size regression test. Every function below
+ * contains `AssertionSizeSites` assertion sites of the same kind, test script
+ * (AssertionSizeTest.cmake) compares size of those functions against an
+ * empty one and fails if a single site costs more than allowed number of
+ * bytes in a hot path. Failure path is expected to be moved out of line
+ * (to `.text.unlikely` / `*.cold`) so it is not accounted here.
+ */
+#include <cppassert/Assertion.hpp>
+
+#define ASSERTION_SIZE_SITES(ASSERTION) \
+    ASSERTION(1); ASSERTION(2); ASSERTION(3); ASSERTION(4); \
+    ASSERTION(5); ASSERTION(6); ASSERTION(7); ASSERTION(8)
+
+#define ASSERT_STATEMENT(n) CPP_ASSERT_ALWAYS(value!=n)
+#define ASSERT_STATEMENT_MESSAGE(n) CPP_ASSERT_ALWAYS(value!=n, "value "<<value)
+#define ASSERT_BOOL(n) CPP_ASSERT_ALWAYS_TRUE(value!=n)
+#define ASSERT_BOOL_MESSAGE(n) CPP_ASSERT_ALWAYS_TRUE(value!=n, "value "<<value)
+#define ASSERT_PREDICATE(n) CPP_ASSERT_ALWAYS_NE(value, n)
+#define ASSERT_PREDICATE_MESSAGE(n) CPP_ASSERT_ALWAYS_NE(value, n, "value "<<value)
+
+extern "C"
+{
+
+void cppAssertSizeEmpty(int value)
+{
+    CPP_ASSERT_MARK_UNUSED(value);
+}
+
+void cppAssertSizeStatement(int value)
+{
+    ASSERTION_SIZE_SITES(ASSERT_STATEMENT);
+}
+
+void cppAssertSizeStatementMessage(int value)
+{
+    ASSERTION_SIZE_SITES(ASSERT_STATEMENT_MESSAGE);
+}
+
+void cppAssertSizeBool(int value)
+{
+    ASSERTION_SIZE_SITES(ASSERT_BOOL);
+}
+
+void cppAssertSizeBoolMessage(int value)
+{
+    ASSERTION_SIZE_SITES(ASSERT_BOOL_MESSAGE);
+}
+
+void cppAssertSizePredicate(int value)
+{
+    ASSERTION_SIZE_SITES(ASSERT_PREDICATE);
+}
+
+void cppAssertSizePredicateMessage(int value)
+{
+    ASSERTION_SIZE_SITES(ASSERT_PREDICATE_MESSAGE);
+}
+
+} // extern "C"
+
+int main(int argc, char **)
+{
+    cppAssertSizeEmpty(argc);
+    cppAssertSizeStatement(argc);
+    cppAssertSizeStatementMessage(argc);
+    cppAssertSizeBool(argc);
+    cppAssertSizeBoolMessage(argc);
+    cppAssertSizePredicate(argc);
+    cppAssertSizePredicateMessage(argc);
+    return 0;
+}
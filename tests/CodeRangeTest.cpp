@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <cppassert/CodeRange.hpp>
+#include <cppassert/details/StackTrace.hpp>
+#include <cstdio>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace
+{
+//stands for generated code, it's outside of executable segments
+char generatedCode[256];
+
+const void *at(std::size_t offset)
+{
+    return generatedCode+offset;
+}
+}
+
+using cppassert::internal::CodeRangeSymbol;
+using cppassert::internal::findCodeRange;
+
+TEST(CodeRangeTest, registeredRange)
+{
+    cppassert::registerCodeRange(at(0), at(128), "_Z9jitKernelv");
+    CodeRangeSymbol symbol;
+    ASSERT_TRUE(findCodeRange(at(16), &symbol));
+    EXPECT_STREQ("[jit]", symbol.module);
+    EXPECT_STREQ("_Z9jitKernelv", symbol.name);
+    EXPECT_EQ(16u, symbol.offset);
+    //return address just past the end belongs to the range
+    EXPECT_TRUE(findCodeRange(at(128), &symbol));
+    EXPECT_FALSE(findCodeRange(at(129), &symbol));
+    EXPECT_FALSE(findCodeRange(at(0), &symbol));
+
+#if defined(CPP_ASSERT_HAVE_BACKTRACE)
+    void *addresses[] = {const_cast<void *>(at(16))};
+    const cppassert::internal::StackTrace frames
+            = cppassert::internal::StackTrace::fromReturnAddresses(addresses, 1);
+    EXPECT_NE(std::string::npos, std::string(frames[0].getSymbol()).find(
+                  "[jit](jitKernel()+0x10)"));
+#endif
+    EXPECT_TRUE(cppassert::unregisterCodeRange(at(0)));
+    EXPECT_FALSE(cppassert::unregisterCodeRange(at(0)));
+    EXPECT_FALSE(findCodeRange(at(16), &symbol));
+}
+
+TEST(CodeRangeTest, overlappingRangeReplacesPreviousOnes)
+{
+    cppassert::registerCodeRange(at(0), at(64), "first");
+    cppassert::registerCodeRange(at(64), at(128), "second");
+    cppassert::registerCodeRange(at(192), at(256), "third");
+    cppassert::registerCodeRange(at(32), at(96), "replacement");
+    CodeRangeSymbol symbol;
+    EXPECT_FALSE(findCodeRange(at(16), &symbol));
+    ASSERT_TRUE(findCodeRange(at(80), &symbol));
+    EXPECT_STREQ("replacement", symbol.name);
+    EXPECT_FALSE(findCodeRange(at(112), &symbol));
+    ASSERT_TRUE(findCodeRange(at(200), &symbol));
+    EXPECT_STREQ("third", symbol.name);
+    EXPECT_TRUE(cppassert::unregisterCodeRange(at(32)));
+    EXPECT_TRUE(cppassert::unregisterCodeRange(at(192)));
+}
+
+#if defined(__linux__)
+TEST(CodeRangeTest, perfMap)
+{
+    const std::string path = "/tmp/cppassertPerfMap-"
+                             +std::to_string(::getpid())+".map";
+    std::FILE *file = std::fopen(path.c_str(), "w");
+    ASSERT_NE(nullptr, file);
+    std::fprintf(file, "%zx 40 perf function\n"
+                 , reinterpret_cast<std::size_t>(at(0)));
+    std::fclose(file);
+    cppassert::internal::setPerfMapPath(path.c_str());
+
+    CodeRangeSymbol symbol;
+    ASSERT_TRUE(findCodeRange(at(8), &symbol));
+    EXPECT_STREQ("[perf-map]", symbol.module);
+    EXPECT_STREQ("perf function", symbol.name);
+    EXPECT_FALSE(findCodeRange(at(130), &symbol));
+
+    //entries appended by JIT are seen, later entry of the same address wins
+    file = std::fopen(path.c_str(), "a");
+    ASSERT_NE(nullptr, file);
+    std::fprintf(file, "%zx 20 later\n"
+                 , reinterpret_cast<std::size_t>(at(0)));
+    std::fprintf(file, "%zx 10 appended\n"
+                 , reinterpret_cast<std::size_t>(at(128)));
+    std::fclose(file);
+    ASSERT_TRUE(findCodeRange(at(130), &symbol));
+    EXPECT_STREQ("appended", symbol.name);
+    ASSERT_TRUE(findCodeRange(at(8), &symbol));
+    EXPECT_STREQ("later", symbol.name);
+
+    //registered ranges take precedence
+    cppassert::registerCodeRange(at(0), at(16), "registered");
+    ASSERT_TRUE(findCodeRange(at(8), &symbol));
+    EXPECT_STREQ("registered", symbol.name);
+    EXPECT_TRUE(cppassert::unregisterCodeRange(at(0)));
+
+    cppassert::internal::setPerfMapPath("");
+    std::remove(path.c_str());
+    EXPECT_FALSE(findCodeRange(at(8), &symbol));
+}
+#endif
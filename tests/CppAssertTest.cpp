@@ -165,6 +165,15 @@ TEST_F(CppAssertTest, formatStreamed)
     EXPECT_EQ(1, formatStreamedCounter_);
 }
 
+TEST(CppAssertWarmUpTest, warmUp)
+{
+    const cppassert::WarmUpTimes times = cppassert::CppAssert::warmUp();
+    EXPECT_GT(times.total.count(), 0);
+    EXPECT_EQ(times.total, times.capture+times.symbolIndex
+                           +times.symbolization+times.formatting);
+    EXPECT_EQ(times.total, cppassert::CppAssert::getWarmUpTimes().total);
+}
+
 TEST_F(CppAssertTest, formatFrame)
 {
     std::string result = cppAssert_->getStackTraceExceptTop(0);
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <cppassert/CppAssert.hpp>
+#include <cppassert/MessageSink.hpp>
+#include <cstring>
+#include <string>
+
+using cppassert::MessageSink;
+using cppassert::internal::AssertionMessage;
+using cppassert::internal::FormatterAdapter;
+
+namespace
+{
+
+struct StringOnlyFormatter
+{
+    std::string formatStatementFailureMessage(const char *statement)
+    {
+        return std::string("statement: ")+statement;
+    }
+
+    std::string formatPredicateFailureMessage(const char *predicate,
+                                        const char *value1Text,
+                                        const char *value2Text,
+                                        const std::string &value1,
+                                        const std::string &value2)
+    {
+        return std::string(value1Text)+'='+value1+' '+predicate+' '
+                +value2Text+'='+value2;
+    }
+
+    std::string formatFrame(std::uint32_t frameNumber, const void *
+                            , const char *)
+    {
+        return std::to_string(frameNumber)+'\n';
+    }
+};
+
+struct SinkOnlyFormatter
+{
+    void formatStatementFailureMessage(MessageSink &sink,
+                                       const char *statement)
+    {
+        sink<<"statement: "<<statement;
+    }
+
+    void formatPredicateFailureMessage(MessageSink &sink,
+                                       const char *predicate,
+                                       const char *value1Text,
+                                       const char *value2Text,
+                                       const AssertionMessage &value1,
+                                       const AssertionMessage &value2)
+    {
+        sink<<value1Text<<'='<<value1<<' '<<predicate<<' '
+            <<value2Text<<'='<<value2;
+    }
+
+    void formatFrame(MessageSink &sink, std::uint32_t frameNumber
+                     , const void *, const char *)
+    {
+        sink<<frameNumber<<'\n';
+    }
+};
+
+template<typename Formatter>
+void expectSameOutput()
+{
+    Formatter formatter;
+    FormatterAdapter<Formatter> adapter(formatter);
+
+    EXPECT_EQ("statement: x", adapter.formatStatementFailureMessage("x"));
+    std::string text;
+    MessageSink sink(text);
+    adapter.formatStatementFailureMessage(sink, "x");
+    EXPECT_EQ("statement: x", text);
+
+    EXPECT_EQ("a=1 == b=2", adapter.formatPredicateFailureMessage("==", "a", "b"
+                                                                , "1", "2"));
+    AssertionMessage value1, value2;
+    value1<<1;
+    value2<<2;
+    AssertionMessage message;
+    MessageSink messageSink(message);
+    adapter.formatPredicateFailureMessage(messageSink, "==", "a", "b"
+                                          , value1, value2);
+    EXPECT_EQ("a=1 == b=2", message.str());
+
+    EXPECT_EQ("3\n", adapter.formatFrame(3, nullptr, ""));
+}
+}
+
+TEST(MessageSinkTest, buffer)
+{
+    char buffer[8];
+    MessageSink sink(buffer, sizeof(buffer));
+    EXPECT_STREQ("", buffer);
+    sink<<"abc"<<'d'<<12;
+    EXPECT_STREQ("abcd12", buffer);
+    EXPECT_FALSE(sink.isTruncated());
+    sink<<"efgh";
+    EXPECT_STREQ("abcd12e", buffer);
+    EXPECT_EQ(7u, sink.size());
+    EXPECT_TRUE(sink.isTruncated());
+    sink<<"";
+    EXPECT_TRUE(sink.isTruncated());
+}
+
+TEST(MessageSinkTest, string)
+{
+    std::string text("x");
+    MessageSink sink(text);
+    sink<<std::string("yz")<<' '<<-5<<' '<<5u<<' '<<nullptr;
+    const char *null = nullptr;
+    sink<<' '<<null;
+    EXPECT_EQ("xyz -5 5 (null) (null)", text);
+    EXPECT_EQ(21u, sink.size());
+}
+
+TEST(MessageSinkTest, assertionMessage)
+{
+    AssertionMessage streamed;
+    streamed<<"streamed";
+    AssertionMessage message;
+    MessageSink sink(message);
+    sink<<streamed;
+    sink.setWidth(4);
+    sink<<7<<8;
+    EXPECT_EQ("streamed   78", message.str());
+}
+
+TEST(MessageSinkTest, pointer)
+{
+    std::string text;
+    MessageSink sink(text);
+    sink<<reinterpret_cast<const void *>(0x10);
+    EXPECT_EQ(std::string("0x")+std::string(sizeof(void *)*2-2, '0')+"10"
+              , text);
+}
+
+TEST(MessageSinkTest, stringOnlyFormatter)
+{
+    expectSameOutput<StringOnlyFormatter>();
+}
+
+TEST(MessageSinkTest, sinkOnlyFormatter)
+{
+    expectSameOutput<SinkOnlyFormatter>();
+}
+
+TEST(MessageSinkTest, defaultFormatter)
+{
+    std::string text;
+    MessageSink sink(text);
+    cppassert::CppAssert::getInstance()->formatBoolFailureMessage(sink
+                                                    , "a", "false", "true");
+    EXPECT_EQ(cppassert::CppAssert::getInstance()->formatBoolFailureMessage(
+                  "a", "false", "true"), text);
+}
+
+TEST(MessageSinkTest, failureReportInBuffer)
+{
+    cppassert::AssertionFailure failure(255, "file", "my_function"
+                                        , std::string("my message"));
+    char buffer[16];
+    MessageSink sink(buffer, sizeof(buffer));
+    cppassert::CppAssert::getInstance()->formatAssertionMessage(sink, failure);
+    EXPECT_STREQ("file:255: my_fu", buffer);
+    EXPECT_TRUE(sink.isTruncated());
+    EXPECT_EQ(0, std::strncmp(failure.toString().c_str(), buffer, 15));
+}
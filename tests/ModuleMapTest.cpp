@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <cppassert/details/ModuleMap.hpp>
+#include <cstdint>
+
+#ifdef CPP_ASSERT_HAVE_MODULE_MAP
+#include <dlfcn.h>
+
+using cppassert::internal::ModuleMap;
+
+namespace
+{
+void moduleMapFunction()
+{
+}
+}
+
+TEST(ModuleMapTest, executableHasBuildId)
+{
+    const auto map = ModuleMap::getCurrent();
+    ASSERT_TRUE(map!=nullptr);
+    ASSERT_LT(0u, map->getModuleCount());
+    const ModuleMap::Frame frame = map->findFrame(
+                reinterpret_cast<const void *>(&moduleMapFunction));
+    ASSERT_NE(ModuleMap::UnknownModule, frame.module);
+    const ModuleMap::Module &module = map->getModule(frame.module);
+    EXPECT_NE(std::string::npos, module.path.find("unitTests"));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&moduleMapFunction)
+              , module.base+frame.offset);
+    EXPECT_FALSE(module.buildId.empty());
+    EXPECT_THROW(map->getModule(map->getModuleCount()), std::out_of_range);
+}
+
+TEST(ModuleMapTest, unknownAddress)
+{
+    const auto map = ModuleMap::getCurrent();
+    int local = 0;
+    const ModuleMap::Frame frame = map->findFrame(&local);
+    EXPECT_EQ(ModuleMap::UnknownModule, frame.module);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&local), frame.offset);
+}
+
+TEST(ModuleMapTest, snapshotIsReplacedOnDlopen)
+{
+    const auto map = ModuleMap::getCurrent();
+    EXPECT_EQ(map, ModuleMap::getCurrent());
+    void *library = nullptr;
+    for(const char *name: {"libutil.so.1", "libanl.so.1", "libz.so.1"})
+    {
+        library = ::dlopen(name, RTLD_NOW|RTLD_NOLOAD);
+        if(library!=nullptr)
+        {
+            ::dlclose(library);
+            library = nullptr;
+            continue;
+        }
+        library = ::dlopen(name, RTLD_NOW);
+        if(library!=nullptr)
+        {
+            break;
+        }
+    }
+    if(library==nullptr)
+    {
+        return;
+    }
+    const auto loaded = ModuleMap::getCurrent();
+    EXPECT_NE(map, loaded);
+    EXPECT_EQ(map->getModuleCount()+1, loaded->getModuleCount());
+    ::dlclose(library);
+}
+
+TEST(ModuleMapTest, formatFrames)
+{
+    const auto frames = cppassert::internal::StackTrace::getStackTrace();
+    const std::string record
+            = ModuleMap::getCurrent()->formatFrames(frames);
+    if(frames.size()==0)
+    {
+        EXPECT_TRUE(record.empty());
+        return;
+    }
+    EXPECT_EQ(0u, record.find("cppassert-frames "));
+    EXPECT_NE(std::string::npos, record.find("\nmodule "));
+    EXPECT_NE(std::string::npos, record.find("\nframe "));
+    EXPECT_EQ(record.size()-4, record.rfind("end\n"));
+}
+#endif
@@ -0,0 +1,134 @@
+#include <cppassert/Assertion.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+//every instantiation is a separate assertion site with its own sampling state
+template<int Site>
+int everyN(int n, int &evaluations)
+{
+    CPP_ASSERT_EVERY_N(n, ++evaluations>0);
+    return evaluations;
+}
+
+template<int Site>
+int sampled(int n, int &evaluations)
+{
+    CPP_ASSERT_SAMPLED(n, ++evaluations>0, "evaluations "<<evaluations);
+    return evaluations;
+}
+
+template<int Site>
+int everyMs(int milliseconds, int &evaluations)
+{
+    CPP_ASSERT_EVERY_MS(milliseconds, ++evaluations>0);
+    return evaluations;
+}
+}
+
+TEST(SampledAssertionTest, everyN)
+{
+    int evaluations = 0;
+    for(int i = 0; i<100; ++i)
+    {
+        everyN<0>(4, evaluations);
+    }
+    EXPECT_EQ(25, evaluations);
+}
+
+TEST(SampledAssertionTest, everyNIsPerThread)
+{
+    int evaluations[2] = {0, 0};
+    std::thread threads[2];
+    for(int i = 0; i<2; ++i)
+    {
+        int &threadEvaluations = evaluations[i];
+        threads[i] = std::thread([&threadEvaluations]()
+        {
+            for(int j = 0; j<10; ++j)
+            {
+                everyN<1>(5, threadEvaluations);
+            }
+        });
+    }
+    for(std::thread &thread: threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(2, evaluations[0]);
+    EXPECT_EQ(2, evaluations[1]);
+}
+
+TEST(SampledAssertionTest, sampled)
+{
+    int evaluations = 0;
+    for(int i = 0; i<80000; ++i)
+    {
+        sampled<0>(8, evaluations);
+    }
+    EXPECT_LT(9000, evaluations);
+    EXPECT_GT(11000, evaluations);
+}
+
+TEST(SampledAssertionTest, sampledEveryCall)
+{
+    int evaluations = 0;
+    for(int i = 0; i<10; ++i)
+    {
+        sampled<1>(1, evaluations);
+    }
+    EXPECT_EQ(10, evaluations);
+}
+
+TEST(SampledAssertionTest, everyMs)
+{
+    int evaluations = 0;
+    for(int i = 0; i<1000; ++i)
+    {
+        everyMs<0>(60000, evaluations);
+    }
+    EXPECT_EQ(1, evaluations);
+}
+
+TEST(SampledAssertionTest, everyMsAfterInterval)
+{
+    int evaluations = 0;
+    for(int i = 0; i<3; ++i)
+    {
+        everyMs<1>(1, evaluations);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(3, evaluations);
+}
+
+//gtest doesnt support death tests on free bsd
+#if defined(__linux__)
+TEST(SampledAssertionTest, everyNShouldAbort)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(
+            CPP_ASSERT_EVERY_N(10, false, "every n")
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*Assertion failure.*every n.*");
+}
+
+TEST(SampledAssertionTest, sampledShouldAbort)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(
+            CPP_ASSERT_SAMPLED(10, 1==2)
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*Assertion failure.*1==2.*");
+}
+
+TEST(SampledAssertionTest, everyMsShouldAbort)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(
+            CPP_ASSERT_EVERY_MS(10, false)
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*Assertion failure.*");
+}
+#endif
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include <cppassert/Assertion.hpp>
+#include <cppassert/CodeRange.hpp>
+#include <cppassert/CppAssert.hpp>
+#include <cppassert/details/StackTraceRenderer.hpp>
+#include <string>
+
+using cppassert::StackTraceFilter;
+using cppassert::internal::StackTrace;
+using cppassert::internal::StackTraceRenderer;
+
+namespace
+{
+//stands for code of named functions, it's outside of executable segments
+char code[5][16];
+
+const char *const FunctionNames[] = {
+    "std::sort",
+    "std::__introsort_loop",
+    "parse",
+    "__gnu_cxx::__ops::__iter_comp_iter",
+    "main"
+};
+
+StackTrace getFakeStackTrace()
+{
+    const void *addresses[5];
+    for(std::size_t i = 0; i<5; ++i)
+    {
+        cppassert::registerCodeRange(code[i], code[i]+sizeof(code[i])
+                                     , FunctionNames[i]);
+        addresses[i] = code[i]+1;
+    }
+    return StackTrace::fromReturnAddresses(addresses, 5);
+}
+
+void unregisterFakeStackTrace()
+{
+    for(std::size_t i = 0; i<5; ++i)
+    {
+        cppassert::unregisterCodeRange(code[i]);
+    }
+}
+
+std::string render(const StackTrace &frames, const StackTraceFilter &filter)
+{
+    std::string output;
+    cppassert::MessageSink sink(output);
+    StackTraceRenderer renderer(std::make_shared<StackTraceFilter>(filter));
+    renderer.render(frames, sink, [](cppassert::MessageSink &text
+                                       , std::uint32_t frameNumber
+                                       , const void *
+                                       , const char *)
+    {
+        text<<frameNumber<<'\n';
+    });
+    return output;
+}
+
+__attribute__((noinline)) void failHere()
+{
+    cppassert::AssertionFailure failure(__LINE__, __FILE__, "failHere"
+                                        , std::string("failure"));
+    failure.onAssertionFailure(cppassert::internal::AssertionMessage());
+}
+
+//value is returned after assertion so that failure path isn't a tail call
+__attribute__((noinline)) int failStatement(int value)
+{
+    CPP_ASSERT_ALWAYS(value==0);
+    return value;
+}
+
+__attribute__((noinline)) int failStatementWithMessage(int value)
+{
+    CPP_ASSERT_ALWAYS(value==0, "value "<<value);
+    return value;
+}
+
+__attribute__((noinline)) bool failBool(bool value)
+{
+    CPP_ASSERT_ALWAYS_TRUE(value);
+    return value;
+}
+
+__attribute__((noinline)) bool failBoolWithMessage(bool value)
+{
+    CPP_ASSERT_ALWAYS_TRUE(value, "value "<<value);
+    return value;
+}
+
+__attribute__((noinline)) int failPredicate(int value)
+{
+    CPP_ASSERT_ALWAYS_EQ(value, 0);
+    return value;
+}
+
+__attribute__((noinline)) int failPredicateWithMessage(int value)
+{
+    CPP_ASSERT_ALWAYS_EQ(value, 0, "value "<<value);
+    return value;
+}
+
+std::string getFirstFrame(int (*fail)(int))
+{
+    std::string firstFrame;
+    cppassert::CppAssert::getInstance()->setAssertionHandler(
+                [&firstFrame](const cppassert::AssertionFailure &failure)
+    {
+        const StackTrace &frames = failure.getStackFrames();
+        if(frames.size()>0)
+        {
+            firstFrame = frames[0].getSymbol();
+        }
+    });
+    fail(1);
+    cppassert::CppAssert::getInstance()->setDefaultHandler();
+    return firstFrame;
+}
+}
+
+TEST(StackTraceRendererTest, allFrames)
+{
+    const StackTrace frames = getFakeStackTrace();
+    EXPECT_EQ("0\n1\n2\n3\n4\n", render(frames, StackTraceFilter()));
+    unregisterFakeStackTrace();
+}
+
+TEST(StackTraceRendererTest, hiddenFramesAreCollapsed)
+{
+    const StackTrace frames = getFakeStackTrace();
+    StackTraceFilter filter;
+    filter.hiddenPrefixes = {"std::", "__gnu_cxx::"};
+    EXPECT_EQ("     ... 2 hidden frames\n2\n"
+              "     ... 1 hidden frame\n4\n", render(frames, filter));
+    unregisterFakeStackTrace();
+}
+
+TEST(StackTraceRendererTest, maxFrames)
+{
+    const StackTrace frames = getFakeStackTrace();
+    StackTraceFilter filter;
+    filter.maxFrames = 2;
+    EXPECT_EQ("0\n1\n     ... 3 more frames\n", render(frames, filter));
+    //frames below the limit are not symbolized
+    EXPECT_TRUE(frames[1].isSymbolized());
+    EXPECT_FALSE(frames[2].isSymbolized());
+
+    filter.hiddenPrefixes = {"std::"};
+    EXPECT_EQ("     ... 2 hidden frames\n2\n3\n     ... 1 more frame\n"
+              , render(frames, filter));
+    unregisterFakeStackTrace();
+}
+
+TEST(StackTraceRendererTest, stackTraceFilter)
+{
+    StackTraceFilter filter;
+    filter.maxFrames = 1;
+    cppassert::CppAssert::setStackTraceFilter(filter);
+    EXPECT_EQ(1u, cppassert::CppAssert::getStackTraceFilter().maxFrames);
+    const std::string text
+            = cppassert::CppAssert::getInstance()->getStackTraceExceptTop(0);
+    EXPECT_NE(std::string::npos, text.find("more frame"));
+
+    cppassert::CppAssert::setStackTraceFilter(StackTraceFilter());
+    EXPECT_EQ(0u, cppassert::CppAssert::getStackTraceFilter().maxFrames);
+    EXPECT_FALSE(cppassert::internal::getStackTraceFilter());
+}
+
+#ifdef CPP_ASSERT_HAVE_BACKTRACE
+TEST(StackTraceRendererTest, libraryFramesAreSkippedByAddress)
+{
+    std::string firstFrame;
+    cppassert::CppAssert::getInstance()->setAssertionHandler(
+                [&firstFrame](const cppassert::AssertionFailure &failure)
+    {
+        const StackTrace &frames = failure.getStackFrames();
+        ASSERT_LT(0u, frames.size());
+        EXPECT_FALSE(cppassert::internal::isLibraryCode(
+                         frames[0].getAddress()));
+        firstFrame = frames[0].getSymbol();
+    });
+    failHere();
+    cppassert::CppAssert::getInstance()->setDefaultHandler();
+    EXPECT_NE(std::string::npos, firstFrame.find("failHere"));
+
+#ifdef CPP_ASSERT_HAVE_LIBRARY_SECTION
+    const char *function = reinterpret_cast<const char *>(
+                                &StackTrace::getStackTrace);
+    EXPECT_TRUE(cppassert::internal::isLibraryCode(function+1));
+#endif
+    EXPECT_FALSE(cppassert::internal::isLibraryCode(
+                     reinterpret_cast<const char *>(&failHere)+1));
+}
+
+TEST(StackTraceRendererTest, assertingFunctionIsFirstFrame)
+{
+    const struct
+    {
+        int (*fail)(int);
+        const char *name;
+    } sites[] = {
+        {&failStatement, "failStatement("},
+        {&failStatementWithMessage, "failStatementWithMessage("},
+        {[](int value) { return int(failBool(value==0)); }, "failBool("},
+        {[](int value) { return int(failBoolWithMessage(value==0)); }
+                , "failBoolWithMessage("},
+        {&failPredicate, "failPredicate("},
+        {&failPredicateWithMessage, "failPredicateWithMessage("}
+    };
+    for(const auto &site: sites)
+    {
+        const std::string firstFrame = getFirstFrame(site.fail);
+        EXPECT_NE(std::string::npos, firstFrame.find(site.name))
+                << firstFrame;
+        EXPECT_EQ(std::string::npos, firstFrame.find("lambda"))
+                << firstFrame;
+        EXPECT_EQ(std::string::npos
+                  , firstFrame.find("onPredicateAssertionFailure"))
+                << firstFrame;
+    }
+}
+#endif
@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
 #include "../source/details/StackTrace.cpp"
+#include "../source/details/AssertionMessage.cpp"
 #include "../source/details/DebugPrint.cpp"
+#include "../source/details/DwarfLineTable.cpp"
+#include "../source/details/ElfSymbolTable.cpp"
+#include "../source/details/ModuleMap.cpp"
+#include "../source/details/StackUnwinder.cpp"
+#include "../source/details/SymbolCache.cpp"
+#include "../source/CodeRange.cpp"
+#include "../source/MessageSink.cpp"
+#include <cstring>
+#include <dlfcn.h>
 #include <iostream>
 
 #if defined(CPP_ASSERT_HAVE_BACKTRACE) || defined(_WIN32)
@@ -42,6 +52,42 @@ TEST(StackTraceTest, getStackTrace)
     EXPECT_TRUE(functionName.find("getStackTrace")!=std::string::npos);
 }
 
+TEST(StackTraceTest, framesAreSymbolizedOnDemand)
+{
+    StackTrace frames = StackTrace::getStackTrace();
+    ASSERT_TRUE(frames.size()>1);
+    for(std::size_t i=0; i<frames.size(); ++i) {
+        EXPECT_FALSE(frames[i].isSymbolized());
+        EXPECT_TRUE(frames[i].getAddress()!=nullptr);
+    }
+    EXPECT_TRUE(frames[1].getSymbol()!=nullptr);
+    EXPECT_TRUE(frames[1].isSymbolized());
+    EXPECT_FALSE(frames[0].isSymbolized());
+    const char *symbol = frames[1].getSymbol();
+    frames.symbolize();
+    EXPECT_EQ(symbol, frames[1].getSymbol());
+    for(std::size_t i=0; i<frames.size(); ++i) {
+        EXPECT_TRUE(frames[i].isSymbolized());
+        EXPECT_TRUE(frames[i].getSymbol()!=nullptr);
+    }
+}
+
+TEST(StackTraceTest, framesToSkip)
+{
+    StackTrace frames = StackTrace::getStackTrace();
+    StackTrace skipped = StackTrace::getStackTrace(1);
+    ASSERT_EQ(frames.size(), skipped.size()+1);
+    EXPECT_EQ(frames[1].getAddress(), skipped[0].getAddress());
+}
+
+TEST(StackTraceTest, emptyStackTrace)
+{
+    StackTrace frames;
+    EXPECT_EQ(0u, frames.size());
+    frames.symbolize();
+    EXPECT_THROW(frames[0], std::out_of_range);
+}
+
 TEST(StackTraceTest, indexOperatorShouldThrowIfOutOfRange)
 {
     StackTrace frames = StackTrace::getStackTrace();
@@ -49,6 +95,132 @@ TEST(StackTraceTest, indexOperatorShouldThrowIfOutOfRange)
     EXPECT_THROW(frames[frames.size()], std::out_of_range);
 }
 
+namespace
+{
+/*
+ * Every level has to stay a real frame in optimized builds, the call is
+ * neither inlined nor turned into a jump or a loop
+ */
+#if defined(_MSC_VER)
+__declspec(noinline)
+#else
+__attribute__((noinline))
+#endif
+StackTrace getStackTraceAtDepth(std::size_t depth, std::size_t maxDepth)
+{
+    volatile std::size_t level = depth;
+    if(level>0)
+    {
+        StackTrace frames = getStackTraceAtDepth(level-1, maxDepth);
+#if defined(_MSC_VER)
+        _ReadWriteBarrier();
+#else
+        __asm__ __volatile__("" : : : "memory");
+#endif
+        return frames;
+    }
+    return StackTrace::getStackTrace(0, maxDepth);
+}
+}
+
+TEST(StackTraceTest, maxDepth)
+{
+    StackTrace frames = getStackTraceAtDepth(40, 5);
+    EXPECT_EQ(5u, frames.size());
+    //trace deeper than inline storage
+    StackTrace deepFrames = getStackTraceAtDepth(40, 30);
+    ASSERT_EQ(30u, deepFrames.size());
+    for(std::size_t i=1; i<deepFrames.size(); ++i)
+    {
+        EXPECT_EQ(deepFrames[1].getAddress(), deepFrames[i].getAddress());
+    }
+    deepFrames.symbolize();
+    EXPECT_NE(nullptr, std::strstr(deepFrames[29].getSymbol()
+                                   , "getStackTraceAtDepth"));
+}
+
+TEST(StackTraceTest, maxStackDepth)
+{
+    const std::size_t depth = getMaxStackDepth();
+    setMaxStackDepth(3);
+    EXPECT_EQ(3u, getMaxStackDepth());
+    EXPECT_EQ(3u, getStackTraceAtDepth(10, 0).size());
+    EXPECT_EQ(8u, getStackTraceAtDepth(10, 8).size());
+    setMaxStackDepth(0);
+    EXPECT_EQ(static_cast<std::size_t>(StackTrace::MaxDepth)
+              , getMaxStackDepth());
+    setMaxStackDepth(depth);
+}
+
+#ifdef CPP_ASSERT_HAVE_BACKTRACE
+namespace
+{
+__attribute__((noinline))
+StackTrace getStackTraceWith(cppassert::StackUnwinder unwinder)
+{
+    setStackUnwinder(unwinder);
+    StackTrace frames = StackTrace::getStackTrace(1);
+    setStackUnwinder(cppassert::StackUnwinder::Backtrace);
+    __asm__ __volatile__("" : : : "memory");
+    return frames;
+}
+
+/*
+ * Compared frames are all in this file, which keeps frame pointers also
+ * in optimized builds, unlike gtest frames above the test
+ */
+__attribute__((noinline))
+StackTrace getStackTraceThrough(cppassert::StackUnwinder unwinder,
+                                std::size_t depth)
+{
+    volatile std::size_t level = depth;
+    StackTrace frames = (level>0)
+            ? getStackTraceThrough(unwinder, level-1)
+            : getStackTraceWith(unwinder);
+    __asm__ __volatile__("" : : : "memory");
+    return frames;
+}
+}
+
+TEST(StackTraceTest, unwindersCollectTheSameFrames)
+{
+    EXPECT_EQ(cppassert::StackUnwinder::Backtrace, getStackUnwinder());
+    StackTrace backtraceFrames
+            = getStackTraceThrough(cppassert::StackUnwinder::Backtrace, 2);
+    StackTrace unwindFrames
+            = getStackTraceThrough(cppassert::StackUnwinder::UnwindBacktrace
+                                   , 2);
+    StackTrace framePointerFrames
+            = getStackTraceThrough(cppassert::StackUnwinder::FramePointer, 2);
+    ASSERT_TRUE(backtraceFrames.size()>3);
+    ASSERT_TRUE(unwindFrames.size()>3);
+    ASSERT_TRUE(framePointerFrames.size()>3);
+    //frame 3 is the test at a different call of getStackTraceThrough
+    for(std::size_t i=0; i<3; ++i)
+    {
+        EXPECT_EQ(backtraceFrames[i].getAddress()
+                  , unwindFrames[i].getAddress());
+        EXPECT_EQ(backtraceFrames[i].getAddress()
+                  , framePointerFrames[i].getAddress());
+    }
+    EXPECT_NE(nullptr, std::strstr(framePointerFrames[0].getSymbol()
+                                   , "getStackTraceThrough"));
+    EXPECT_NE(nullptr, std::strstr(framePointerFrames[3].getSymbol()
+                                   , "unwindersCollectTheSameFrames"));
+}
+
+TEST(StackTraceTest, unwindersStopAtMaximalDepth)
+{
+    void *frames[2] = {nullptr, nullptr};
+    EXPECT_EQ(1u, captureWithUnwind(frames, 1));
+    EXPECT_EQ(nullptr, frames[1]);
+    EXPECT_EQ(1u, captureWithFramePointers(frames, 1));
+    EXPECT_EQ(nullptr, frames[1]);
+    EXPECT_EQ(0u, captureWithUnwind(frames, 0));
+    EXPECT_EQ(0u, captureWithFramePointers(frames, 0));
+}
+#endif /* CPP_ASSERT_HAVE_BACKTRACE */
+
 #if defined(__linux__) || defined(__FreeBSD__)
 TEST(StackTraceTest, demangler)
 {
@@ -62,7 +234,226 @@ TEST(StackTraceTest, demangler)
     const char *demangledSymbol = demangler.demangle("_ZN7testing8internal38HandleSehExceptionsInMethodIfSupportedINS_4TestEvEET0_PT_MS4_FS3_vEPKc");
     EXPECT_STREQ(expectedSymbol, demangledSymbol);
 }
+
+TEST(StackTraceTest, demangleCache)
+{
+    DemangleCache &cache = DemangleCache::getInstance();
+    //name is looked up by value, not by pointer
+    std::string mangledName("_ZN9cppassert8internal13DemangleCache4sizeEv");
+    const char *demangledName = cache.demangle(mangledName.c_str());
+    EXPECT_STREQ("cppassert::internal::DemangleCache::size()", demangledName);
+    const std::size_t size = cache.size();
+    const std::string copy(mangledName);
+    EXPECT_EQ(demangledName, cache.demangle(copy.c_str()));
+    EXPECT_EQ(nullptr, cache.demangle("notMangled"));
+    EXPECT_EQ(nullptr, cache.demangle("notMangled"));
+    EXPECT_EQ(size+1, cache.size());
+
+    StackTrace frames = StackTrace::getStackTrace();
+    frames.symbolize();
+    const std::size_t symbolizedSize = cache.size();
+    StackTrace otherFrames = StackTrace::getStackTrace();
+    otherFrames.symbolize();
+    EXPECT_EQ(symbolizedSize, cache.size());
+}
 #endif /* defined(__linux__) || defined(__FreeBSD__)*/
 
+#ifdef CPP_ASSERT_HAVE_ELF_SYMBOLS
+namespace
+{
+__attribute__((noinline)) StackTrace staticFunction()
+{
+    return StackTrace::getStackTrace();
+}
+}
+
+TEST(StackTraceTest, elfSymbolTableResolvesStaticFunction)
+{
+    const ElfSymbolTable &table = ElfSymbolTable::getInstance();
+    EXPECT_TRUE(table.getModuleCount()>0);
+    StackTrace frames = staticFunction();
+    ASSERT_TRUE(frames.size()>0);
+    ElfSymbolTable::Symbol symbol;
+    ASSERT_TRUE(table.findSymbol(frames[0].getAddress(), &symbol));
+    ASSERT_NE(nullptr, symbol.name);
+    EXPECT_NE(nullptr, std::strstr(symbol.name, "staticFunction"));
+    EXPECT_TRUE(symbol.offset>0);
+    EXPECT_NE(std::string::npos
+              , std::string(frames[0].getSymbol()).find("staticFunction()+0x"));
+}
+
+TEST(StackTraceTest, elfSymbolTableUnknownAddress)
+{
+    ElfSymbolTable::Symbol symbol;
+    int local = 0;
+    EXPECT_FALSE(ElfSymbolTable::getInstance().findSymbol(&local, &symbol));
+    EXPECT_FALSE(ElfSymbolTable::getInstance().findSymbol(nullptr, &symbol));
+}
+
+TEST(StackTraceTest, elfSymbolTableFollowsLoadedModules)
+{
+    const ElfSymbolTable &table = ElfSymbolTable::getInstance();
+    EXPECT_EQ(&table, &ElfSymbolTable::getInstance());
+    void *library = nullptr;
+    for(const char *name: {"libutil.so.1", "libanl.so.1", "libz.so.1"})
+    {
+        library = ::dlopen(name, RTLD_NOW|RTLD_NOLOAD);
+        if(library!=nullptr)
+        {
+            ::dlclose(library);
+            library = nullptr;
+            continue;
+        }
+        library = ::dlopen(name, RTLD_NOW);
+        if(library!=nullptr)
+        {
+            break;
+        }
+    }
+    if(library==nullptr)
+    {
+        return;
+    }
+    const ElfSymbolTable &loaded = ElfSymbolTable::getInstance();
+    EXPECT_NE(&table, &loaded);
+    EXPECT_EQ(table.getModuleCount()+1, loaded.getModuleCount());
+    ::dlclose(library);
+    //replaced tables stay valid
+    EXPECT_EQ(table.getModuleCount()+1, loaded.getModuleCount());
+    EXPECT_EQ(table.getModuleCount()
+              , ElfSymbolTable::getInstance().getModuleCount());
+}
+#endif /* CPP_ASSERT_HAVE_ELF_SYMBOLS */
+
+#ifdef CPP_ASSERT_HAVE_DWARF_LINES
+namespace
+{
+std::uint32_t inlinedCaptureLine = 0;
+
+inline __attribute__((always_inline)) StackTrace inlinedCapture()
+{
+    StackTrace frames = StackTrace::getStackTrace(); inlinedCaptureLine = __LINE__;
+    return frames;
+}
+
+bool endsWith(const char *text, const char *suffix)
+{
+    const std::size_t length = std::strlen(text);
+    const std::size_t suffixLength = std::strlen(suffix);
+    return (length>=suffixLength
+            && std::strcmp(text+length-suffixLength, suffix)==0);
+}
+}
+
+TEST(StackTraceTest, sourceLocation)
+{
+    StackTrace frames = StackTrace::getStackTrace(); const std::uint32_t line = __LINE__;
+    ASSERT_TRUE(frames.size()>0);
+    ASSERT_EQ(1u, frames[0].getSourceLocationCount());
+    const SourceLocation &location = frames[0].getSourceLocation(0);
+    ASSERT_NE(nullptr, location.file);
+    EXPECT_TRUE(endsWith(location.file, "StackTraceTest.cpp"));
+    EXPECT_EQ(line, location.line);
+    EXPECT_EQ(nullptr, location.function);
+    EXPECT_NE(std::string::npos, std::string(frames[0].getSymbol()).find(
+                "StackTraceTest.cpp:"+std::to_string(line)));
+    EXPECT_THROW(frames[0].getSourceLocation(1), std::out_of_range);
+}
+
+TEST(StackTraceTest, sourceLocationOfInlinedCall)
+{
+    StackTrace frames = inlinedCapture(); const std::uint32_t line = __LINE__;
+    ASSERT_TRUE(frames.size()>0);
+    ASSERT_EQ(2u, frames[0].getSourceLocationCount());
+    const SourceLocation &inlined = frames[0].getSourceLocation(0);
+    EXPECT_EQ(inlinedCaptureLine, inlined.line);
+    ASSERT_NE(nullptr, inlined.function);
+    EXPECT_STREQ("inlinedCapture", inlined.function);
+    const SourceLocation &caller = frames[0].getSourceLocation(1);
+    ASSERT_NE(nullptr, caller.file);
+    EXPECT_TRUE(endsWith(caller.file, "StackTraceTest.cpp"));
+    EXPECT_EQ(line, caller.line);
+    EXPECT_EQ(nullptr, caller.function);
+}
+
+TEST(StackTraceTest, dwarfLineTableIsCached)
+{
+    ElfSymbolTable::Symbol symbol;
+    StackTrace frames = StackTrace::getStackTrace();
+    ASSERT_TRUE(ElfSymbolTable::getInstance().findSymbol(frames[0].getAddress()
+                                                         , &symbol));
+    const DwarfLineTable &table = DwarfLineTable::getTable(symbol.module);
+    EXPECT_FALSE(table.isEmpty());
+    EXPECT_EQ(&table, &DwarfLineTable::getTable(symbol.module));
+    EXPECT_TRUE(DwarfLineTable::getTable("/nonexistent/module").isEmpty());
+    SourceLocation location;
+    EXPECT_EQ(0u, table.findLocations(0, &location, 1));
+}
+
+TEST(StackTraceTest, symbolCache)
+{
+    char directory[] = "/tmp/cppassertSymbolCacheXXXXXX";
+    ASSERT_NE(nullptr, ::mkdtemp(directory));
+    SymbolCacheFile::setDirectory(directory);
+    ElfSymbolTable::Symbol symbol;
+    StackTrace frames = staticFunction();
+    ASSERT_TRUE(ElfSymbolTable::getInstance().findSymbol(frames[0].getAddress()
+                                                         , &symbol));
+    const std::string buildId = ElfImage(symbol.module).getBuildId();
+    ASSERT_FALSE(buildId.empty());
+
+    const ElfSymbolIndex index(symbol.module);
+    const ElfSymbolIndex cachedIndex(symbol.module);
+    EXPECT_FALSE(index.isCached());
+    EXPECT_TRUE(cachedIndex.isCached());
+    std::size_t offset = 0;
+    std::size_t cachedOffset = 0;
+    const char *name = index.findSymbol(symbol.moduleAddress, &offset);
+    ASSERT_NE(nullptr, name);
+    EXPECT_STREQ(name, cachedIndex.findSymbol(symbol.moduleAddress
+                                              , &cachedOffset));
+    EXPECT_EQ(offset, cachedOffset);
+
+    const std::unique_ptr<DwarfLineTable> table
+            = DwarfLineTable::create(symbol.module);
+    const std::unique_ptr<DwarfLineTable> cachedTable
+            = DwarfLineTable::create(symbol.module);
+    EXPECT_FALSE(table->isCached());
+    EXPECT_TRUE(cachedTable->isCached());
+    const StackTrace inlinedFrames = inlinedCapture();
+    ASSERT_TRUE(ElfSymbolTable::getInstance().findSymbol(
+                    inlinedFrames[0].getAddress(), &symbol));
+    SourceLocation locations[2];
+    SourceLocation cachedLocations[2];
+    ASSERT_EQ(2u, table->findLocations(symbol.moduleAddress-1, locations, 2));
+    ASSERT_EQ(2u, cachedTable->findLocations(symbol.moduleAddress-1
+                                             , cachedLocations, 2));
+    for(std::size_t i = 0; i<2; ++i)
+    {
+        EXPECT_STREQ(locations[i].file, cachedLocations[i].file);
+        EXPECT_EQ(locations[i].line, cachedLocations[i].line);
+    }
+    EXPECT_STREQ("inlinedCapture", cachedLocations[0].function);
+
+    //cache of other build is not trusted
+    const std::string path = std::string(directory)+'/'+buildId+".sym";
+    std::FILE *file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(nullptr, file);
+    std::fseek(file, static_cast<long>(offsetof(Header, buildId)), SEEK_SET);
+    std::fputc(buildId[0]=='0' ? '1' : '0', file);
+    std::fclose(file);
+    EXPECT_FALSE(ElfSymbolIndex(symbol.module).isCached());
+    EXPECT_TRUE(ElfSymbolIndex(symbol.module).isCached());
+
+    SymbolCacheFile::setDirectory(std::string());
+    EXPECT_FALSE(ElfSymbolIndex(symbol.module).isCached());
+    EXPECT_FALSE(SymbolCacheFile::open(buildId
+                            , SymbolCacheFile::Kind::Symbols).isValid());
+    ::unlink(path.c_str());
+    ::unlink((std::string(directory)+'/'+buildId+".line").c_str());
+    ::rmdir(directory);
+}
+#endif /* CPP_ASSERT_HAVE_DWARF_LINES */
+
 #endif /* defined(CPP_ASSERT_HAVE_BACKTRACE) || defined(_WIN32) */
 
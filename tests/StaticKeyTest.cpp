@@ -0,0 +1,115 @@
+#define CPP_ASSERT_STATIC_KEYS
+#include <cppassert/Assertion.hpp>
+#include <cppassert/CppAssert.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#ifdef CPP_ASSERT_HAVE_STATIC_KEYS
+namespace
+{
+const std::uint32_t COUNTED_SITE_LINE = __LINE__ + 4;
+int countedSite(int &evaluations)
+{
+    //evaluations counts how many times predicate was evaluated
+    CPP_ASSERT_ALWAYS(++evaluations>0);
+    return evaluations;
+}
+
+const std::uint32_t FAILING_SITE_LINE = __LINE__ + 3;
+void failingSite(int value)
+{
+    CPP_ASSERT_ALWAYS_EQ(value, 0);
+}
+
+bool setCountedSiteEnabled(bool enabled)
+{
+    return (cppassert::CppAssert::setSiteEnabled("StaticKeyTest.cpp"
+                                                 , COUNTED_SITE_LINE
+                                                 , enabled)==1);
+}
+}
+
+TEST(StaticKeyTest, sitesArePatchable)
+{
+    EXPECT_LE(2u, cppassert::CppAssert::getStaticKeyCount());
+}
+
+TEST(StaticKeyTest, disabledSiteIsNotEvaluated)
+{
+    int evaluations = 0;
+    countedSite(evaluations);
+    EXPECT_EQ(1, evaluations);
+
+    ASSERT_TRUE(setCountedSiteEnabled(false));
+    countedSite(evaluations);
+    countedSite(evaluations);
+    EXPECT_EQ(1, evaluations);
+
+    ASSERT_TRUE(setCountedSiteEnabled(true));
+    countedSite(evaluations);
+    EXPECT_EQ(2, evaluations);
+}
+
+TEST(StaticKeyTest, patchingIsIdempotent)
+{
+    int evaluations = 0;
+    ASSERT_TRUE(setCountedSiteEnabled(false));
+    ASSERT_TRUE(setCountedSiteEnabled(false));
+    countedSite(evaluations);
+    EXPECT_EQ(0, evaluations);
+    ASSERT_TRUE(setCountedSiteEnabled(true));
+    ASSERT_TRUE(setCountedSiteEnabled(true));
+    countedSite(evaluations);
+    EXPECT_EQ(1, evaluations);
+}
+
+TEST(StaticKeyTest, patchingWhileSiteIsExecuted)
+{
+    std::atomic<bool> done(false);
+    std::thread worker([&done]()
+    {
+        int evaluations = 0;
+        while(!done.load())
+        {
+            countedSite(evaluations);
+        }
+    });
+    for(int i = 0; i<1000; ++i)
+    {
+        ASSERT_TRUE(setCountedSiteEnabled((i%2)!=0));
+    }
+    done = true;
+    worker.join();
+    ASSERT_TRUE(setCountedSiteEnabled(true));
+}
+
+//gtest doesnt support death tests on free bsd
+#if defined(__linux__)
+TEST(StaticKeyTest, disabledSiteShouldntAbort)
+{
+    ASSERT_EQ(1u, cppassert::CppAssert::setSiteEnabled("StaticKeyTest.cpp"
+                                                      , FAILING_SITE_LINE
+                                                      , false));
+    failingSite(1);
+    ASSERT_EQ(1u, cppassert::CppAssert::setSiteEnabled("StaticKeyTest.cpp"
+                                                      , FAILING_SITE_LINE
+                                                      , true));
+}
+
+TEST(StaticKeyTest, enabledSiteShouldAbort)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(
+            cppassert::CppAssert::setSiteEnabled("StaticKeyTest.cpp"
+                                                 , FAILING_SITE_LINE
+                                                 , false);
+            cppassert::CppAssert::setSiteEnabled("StaticKeyTest.cpp"
+                                                 , FAILING_SITE_LINE
+                                                 , true);
+            failingSite(1)
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*Assertion failure.*");
+}
+#endif
+#endif
@@ -0,0 +1,68 @@
+#
+# Offline symbolization test. Expects following variables:
+#
+#  BINARY       - binary built from SymbolizeTest.cpp
+#  SYMBOLIZER   - cppassert-symbolize tool
+#  DIRECTORY    - scratch directory of debug files
+#
+# Record printed by the binary is rewritten to refer to a module path that
+# doesn't exist, so the binary has to be found by build-id under DIRECTORY.
+#
+
+execute_process(COMMAND ${BINARY}
+                OUTPUT_VARIABLE record
+                RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Unable to capture stack record with ${BINARY}")
+endif()
+
+string(REGEX MATCH "module ([0-9]+) ([0-9a-f]+) 0x[0-9a-f]+ ([^\n]*symbolizeTest[^\n]*)\n"
+       match "${record}")
+if(NOT match)
+    message(FATAL_ERROR "Module of ${BINARY} not found in record:\n${record}")
+endif()
+set(buildId ${CMAKE_MATCH_2})
+set(modulePath ${CMAKE_MATCH_3})
+string(SUBSTRING ${buildId} 0 2 buildIdDirectory)
+string(SUBSTRING ${buildId} 2 -1 buildIdFile)
+
+file(REMOVE_RECURSE ${DIRECTORY})
+configure_file(${BINARY}
+               ${DIRECTORY}/.build-id/${buildIdDirectory}/${buildIdFile}.debug
+               COPYONLY)
+string(REPLACE "${modulePath}" "/nonexistent/symbolizeTest" record "${record}")
+file(WRITE ${DIRECTORY}/record.txt "${record}")
+
+execute_process(COMMAND ${SYMBOLIZER} -d ${DIRECTORY} ${DIRECTORY}/record.txt
+                OUTPUT_VARIABLE frames
+                RESULT_VARIABLE result)
+message("${frames}")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "cppassert-symbolize failed")
+endif()
+foreach(expected "before record\n" "after record\n"
+                 "symbolizeTestFunction[^\n]* at [^\n]*SymbolizeTest.cpp:[0-9]+"
+                 "main[^\n]* at [^\n]*SymbolizeTest.cpp:[0-9]+")
+    if(NOT frames MATCHES "${expected}")
+        message(FATAL_ERROR "'${expected}' not found in symbolized frames")
+    endif()
+endforeach()
+if(frames MATCHES "cppassert-frames")
+    message(FATAL_ERROR "Record wasn't symbolized")
+endif()
+
+# the second run maps symbol and line tables stored by the first one
+foreach(run 1 2)
+    execute_process(COMMAND ${SYMBOLIZER} -c ${DIRECTORY}/cache
+                            -d ${DIRECTORY} ${DIRECTORY}/record.txt
+                    OUTPUT_VARIABLE cachedFrames
+                    RESULT_VARIABLE result)
+    if(NOT result EQUAL 0 OR NOT cachedFrames STREQUAL frames)
+        message(FATAL_ERROR "Run ${run} with symbol cache differs:\n${cachedFrames}")
+    endif()
+endforeach()
+foreach(suffix sym line)
+    if(NOT EXISTS ${DIRECTORY}/cache/${buildId}.${suffix})
+        message(FATAL_ERROR "Symbol cache ${buildId}.${suffix} wasn't written")
+    endif()
+endforeach()
@@ -0,0 +1,22 @@
+/*
+ * Prints raw stack record of a known function, test script
+ * (SymbolizeTest.cmake) symbolizes it with cppassert-symbolize.
+ */
+#include <cppassert/details/ModuleMap.hpp>
+#include <cppassert/details/StackTrace.hpp>
+#include <iostream>
+
+__attribute__((noinline))
+std::string symbolizeTestFunction()
+{
+    using cppassert::internal::ModuleMap;
+    using cppassert::internal::StackTrace;
+    return ModuleMap::getCurrent()->formatFrames(StackTrace::getStackTrace());
+}
+
+int main()
+{
+    const std::string record = symbolizeTestFunction();
+    std::cout<<"before record\n"<<record<<"after record"<<std::endl;
+    return record.empty() ? 1 : 0;
+}
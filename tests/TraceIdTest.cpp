@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <cppassert/CppAssert.hpp>
+#include <cppassert/TraceId.hpp>
+#include <set>
+#include <thread>
+#include <vector>
+
+#if defined(CPP_ASSERT_HAVE_BACKTRACE) || defined(_WIN32)
+namespace
+{
+cppassert::TraceId captureTrace()
+{
+    return cppassert::capture();
+}
+
+cppassert::TraceId captureOtherTrace()
+{
+    return cppassert::capture();
+}
+
+/*
+ * Every bit selects one of two call sites so that each value has distinct
+ * stack
+ */
+cppassert::TraceId captureBits(unsigned bits, unsigned depth)
+{
+    if(depth==0)
+    {
+        return cppassert::capture();
+    }
+    cppassert::TraceId id;
+    if(bits&1)
+    {
+        id = captureBits(bits>>1, depth-1);
+    }
+    else
+    {
+        id = captureBits(bits>>1, depth-1);
+    }
+    return id;
+}
+}
+
+TEST(TraceIdTest, equalStacksHaveEqualIds)
+{
+    std::vector<cppassert::TraceId> ids;
+    for(int i=0; i<2; ++i)
+    {
+        ids.push_back(captureTrace());
+        ids.push_back(captureOtherTrace());
+    }
+    EXPECT_NE(cppassert::TraceId::Empty, ids[0]);
+    EXPECT_EQ(ids[0], ids[2]);
+    EXPECT_EQ(ids[1], ids[3]);
+    EXPECT_NE(ids[0], ids[1]);
+    EXPECT_EQ(4u, sizeof(cppassert::TraceId));
+}
+
+TEST(TraceIdTest, framesOfId)
+{
+    const cppassert::TraceId id = captureTrace();
+    const cppassert::internal::StackTrace frames
+            = cppassert::internal::StackTrace::getStackTrace();
+    const cppassert::internal::StackTrace traceFrames
+            = cppassert::getStackTrace(id);
+    ASSERT_EQ(frames.size()+1, traceFrames.size());
+    ASSERT_EQ(traceFrames.size(), cppassert::getTraceSize(id));
+    EXPECT_FALSE(traceFrames[0].isSymbolized());
+    for(std::size_t i=1; i<frames.size(); ++i)
+    {
+        EXPECT_EQ(frames[i].getAddress(), traceFrames[i+1].getAddress());
+    }
+    EXPECT_NE(std::string::npos, cppassert::toString(id).find("captureTrace"));
+}
+
+TEST(TraceIdTest, emptyId)
+{
+    EXPECT_EQ(0u, cppassert::getTraceSize(cppassert::TraceId::Empty));
+    EXPECT_EQ(0u, cppassert::getStackTrace(cppassert::TraceId::Empty).size());
+    EXPECT_TRUE(cppassert::toString(cppassert::TraceId::Empty).empty());
+}
+
+TEST(TraceIdTest, concurrentCaptures)
+{
+    const unsigned Depth = 13;
+    const unsigned Stacks = 1u<<Depth;
+    const std::size_t count = cppassert::getTraceCount();
+    std::vector<std::vector<cppassert::TraceId>> ids(4);
+    std::vector<std::thread> threads;
+    for(std::size_t thread=0; thread<ids.size(); ++thread)
+    {
+        threads.emplace_back([&ids, thread, Stacks, Depth]()
+        {
+            for(unsigned bits=0; bits<Stacks; ++bits)
+            {
+                ids[thread].push_back(captureBits(bits, Depth));
+            }
+        });
+    }
+    for(std::thread &thread: threads)
+    {
+        thread.join();
+    }
+    for(std::size_t thread=1; thread<ids.size(); ++thread)
+    {
+        EXPECT_TRUE(ids[0]==ids[thread]);
+    }
+    const std::set<cppassert::TraceId> distinct(ids[0].begin()
+                                                , ids[0].end());
+    EXPECT_EQ(Stacks, distinct.size());
+    EXPECT_EQ(count+Stacks, cppassert::getTraceCount());
+}
+#endif
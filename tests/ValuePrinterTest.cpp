@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include <cppassert/Assertion.hpp>
+#include <cppassert/ValuePrinter.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <ostream>
+#include <string>
+
+namespace
+{
+struct NotStreamable
+{
+    int first;
+    int second;
+
+    bool operator==(const NotStreamable &other) const
+    {
+        return (first==other.first && second==other.second);
+    }
+};
+
+struct Streamable
+{
+    int value;
+
+    bool operator==(const Streamable &other) const
+    {
+        return (value==other.value);
+    }
+};
+
+std::ostream &operator<<(std::ostream &stream, const Streamable &value)
+{
+    return stream<<"Streamable("<<value.value<<')';
+}
+
+struct Point
+{
+    int x;
+    int y;
+
+    bool operator==(const Point &other) const
+    {
+        return (x==other.x && y==other.y);
+    }
+};
+
+struct Bytes
+{
+    unsigned char bytes[3];
+};
+
+enum class Direction : unsigned char
+{
+    Up = 1,
+    Down = 200
+};
+
+enum Sign
+{
+    Negative = -1,
+    Positive = 1
+};
+
+enum class Shape
+{
+    Circle,
+    Square
+};
+
+std::ostream &operator<<(std::ostream &stream, Shape shape)
+{
+    return stream<<(shape==Shape::Circle ? "Circle" : "Square");
+}
+
+enum Suit
+{
+    Hearts,
+    Spades
+};
+
+std::ostream &operator<<(std::ostream &stream, Suit suit)
+{
+    return stream<<(suit==Hearts ? "Hearts" : "Spades");
+}
+
+struct Convertible
+{
+    operator int() const
+    {
+        return 1;
+    }
+};
+
+static_assert(!cppassert::internal::IsStreamable<Convertible>::value,
+              "member operators of std::ostream are not considered");
+
+template<typename T>
+std::string print(const T &value)
+{
+    cppassert::AssertionMessage message;
+    cppassert::ValuePrinter<T>::print(message, value);
+    return message.str();
+}
+
+template<typename T>
+T parse(const std::string &text)
+{
+    return static_cast<T>(std::strtold(text.c_str(), nullptr));
+}
+
+int function(int value)
+{
+    return value;
+}
+}
+
+namespace cppassert
+{
+template<>
+struct ValuePrinter<Point>
+{
+    static void print(AssertionMessage &message, const Point &value)
+    {
+        message<<'('<<value.x<<", "<<value.y<<')';
+    }
+};
+}
+
+TEST(ValuePrinterTest, integers)
+{
+    EXPECT_EQ("0", print(0));
+    EXPECT_EQ("-1", print(-1));
+    EXPECT_EQ("1234567890", print(1234567890));
+    EXPECT_EQ("-32768", print(static_cast<short>(-32768)));
+    EXPECT_EQ("65535", print(static_cast<unsigned short>(65535)));
+    EXPECT_EQ("4294967295", print(4294967295u));
+    EXPECT_EQ("-9223372036854775808"
+              , print(std::numeric_limits<long long>::min()));
+    EXPECT_EQ("18446744073709551615"
+              , print(std::numeric_limits<unsigned long long>::max()));
+    EXPECT_EQ("65", print(u'A'));
+}
+
+TEST(ValuePrinterTest, characters)
+{
+    EXPECT_EQ("'a' (97)", print('a'));
+    EXPECT_EQ("'\\'' (39)", print('\''));
+    EXPECT_EQ("'\\x00' (0)", print('\0'));
+    EXPECT_EQ("'\\xff' (255)", print(static_cast<unsigned char>(255)));
+    EXPECT_EQ("'\\xff' (-1)", print(static_cast<signed char>(-1)));
+}
+
+TEST(ValuePrinterTest, floatingPointIsShortestRoundTrip)
+{
+    EXPECT_EQ("0", print(0.0));
+    EXPECT_EQ("-0", print(-0.0));
+    EXPECT_EQ("0.1", print(0.1));
+    EXPECT_EQ("0.1", print(0.1f));
+    EXPECT_EQ("1.5", print(1.5L));
+    EXPECT_EQ("0.30000000000000004", print(0.1+0.2));
+    EXPECT_EQ("1e+100", print(1e100));
+    EXPECT_EQ("inf", print(std::numeric_limits<double>::infinity()));
+    EXPECT_EQ("-inf", print(-std::numeric_limits<float>::infinity()));
+    EXPECT_EQ("nan", print(std::numeric_limits<double>::quiet_NaN()));
+
+    const double third = 1.0/3.0;
+    EXPECT_EQ(third, parse<double>(print(third)));
+    const float thirdFloat = 1.0f/3.0f;
+    EXPECT_EQ(thirdFloat, parse<float>(print(thirdFloat)));
+    EXPECT_EQ(std::numeric_limits<double>::max()
+              , parse<double>(print(std::numeric_limits<double>::max())));
+    EXPECT_EQ(std::numeric_limits<double>::denorm_min()
+              , parse<double>(print(std::numeric_limits<double>::denorm_min())));
+}
+
+TEST(ValuePrinterTest, pointers)
+{
+    EXPECT_EQ("(null)", print(static_cast<int *>(nullptr)));
+    EXPECT_EQ("(null)", print(nullptr));
+    EXPECT_EQ("0x1234", print(reinterpret_cast<const int *>(0x1234)));
+    EXPECT_EQ("0xabc", print(reinterpret_cast<void *>(0xabc)));
+    EXPECT_EQ("text", print(static_cast<const char *>("text")));
+    EXPECT_NE(std::string::npos, print(&function).find("0x"));
+}
+
+TEST(ValuePrinterTest, enumerationsAndBool)
+{
+    EXPECT_EQ("200", print(Direction::Down));
+    EXPECT_EQ("-1", print(Negative));
+    EXPECT_EQ("true", print(true));
+    EXPECT_EQ("false", print(false));
+}
+
+TEST(ValuePrinterTest, enumerationOperatorTakesPriority)
+{
+    EXPECT_EQ("Square", print(Shape::Square));
+    EXPECT_EQ("Spades", print(Spades));
+    cppassert::AssertionMessage message;
+    message<<Shape::Circle<<' '<<Hearts<<' '<<Negative;
+    EXPECT_EQ("Circle Hearts -1", message.str());
+}
+
+TEST(ValuePrinterTest, objects)
+{
+    EXPECT_EQ("Streamable(5)", print(Streamable{5}));
+    EXPECT_EQ("text", print(std::string("text")));
+    EXPECT_EQ("(1, 2)", print(Point{1, 2}));
+    const Bytes bytes = {{0x01, 0xab, 0xff}};
+    EXPECT_EQ("3-byte object <01 ab ff>", print(bytes));
+}
+
+TEST(ValuePrinterTest, notStreamableTypeCanBeCompared)
+{
+    EXPECT_FALSE(cppassert::internal::IsStreamable<NotStreamable>::value);
+    EXPECT_TRUE(cppassert::internal::IsStreamable<Streamable>::value);
+    const NotStreamable value = {1, 2};
+    const Point point = {1, 2};
+    CPP_ASSERT_ALWAYS_EQ(value, value);
+    CPP_ASSERT_ALWAYS_EQ(point, point, "message");
+}
+
+//gtest doesnt support death tests on free bsd
+#if defined(__linux__)
+TEST(ValuePrinterTest, failureReportsPrintedValues)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    const NotStreamable first = {1, 2};
+    const NotStreamable second = {1, 3};
+    const Point firstPoint = {1, 2};
+    const Point secondPoint = {3, 4};
+    EXPECT_EXIT(
+            CPP_ASSERT_ALWAYS_EQ(first, second)
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*first evaluated to: 8-byte object <01 00 00 00 02 00 00 00>"
+              "\n.*second evaluated to: 8-byte object "
+              "<01 00 00 00 03 00 00 00>.*");
+    EXPECT_EXIT(
+            CPP_ASSERT_ALWAYS_EQ(firstPoint, secondPoint, "message")
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*evaluated to: \\(1, 2\\)\n.*evaluated to: \\(3, 4\\).*");
+    EXPECT_EXIT(
+            CPP_ASSERT_ALWAYS_EQ(Shape::Circle, Shape::Square)
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*evaluated to: Circle\n.*evaluated to: Square.*");
+    EXPECT_EXIT(
+            CPP_ASSERT_ALWAYS_EQ(0.1+0.2, 0.3)
+            ,::testing::KilledBySignal(SIGABRT)
+            , ".*evaluated to: 0.30000000000000004\n.*0.3 evaluated to: 0.3\n.*");
+}
+#endif
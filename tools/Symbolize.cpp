@@ -0,0 +1,391 @@
+#include <cppassert/details/DwarfLineTable.hpp>
+#include <cppassert/details/ElfSymbolTable.hpp>
+#include <cppassert/details/SymbolCache.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Symbolizes raw stack records appended to failure messages, see
+ * cppassert::internal::ModuleMap::formatFrames. Other lines are copied
+ * unchanged, so whole logs can be piped through.
+ */
+namespace
+{
+using cppassert::internal::DwarfLineTable;
+using cppassert::internal::ElfImage;
+using cppassert::internal::ElfSymbolIndex;
+using cppassert::internal::SourceLocation;
+using cppassert::internal::SymbolCacheFile;
+
+const char *const Usage =
+    "usage: cppassert-symbolize [-c cache] [-d directory]... [file]...\n"
+    "Replaces raw stack records read from files or standard input with\n"
+    "symbolized frames. Binaries and debug files are looked up by build-id\n"
+    "as <directory>/.build-id/xx/yyyy.debug, <directory>/.build-id/xx/yyyy,\n"
+    "<directory>/<module name> and <directory>/<module path> in the given\n"
+    "directories, then /usr/lib/debug, then at module path of the record.\n"
+    "Symbol and line tables are stored by build-id in cache directory\n"
+    "given with -c or CPPASSERT_SYMBOL_CACHE and reused by later runs.\n";
+
+const char *const RecordBegin = "cppassert-frames ";
+const char *const RecordEnd = "end";
+const std::uint32_t UnknownModule = UINT32_MAX;
+const std::size_t MaxSourceLocations = 8;
+
+/*
+ * Module of the record
+ */
+struct RecordModule
+{
+    std::string buildId;
+    std::uintptr_t base = 0;
+    std::string path;
+};
+
+/*
+ * Frame of the record, offset is absolute address for UnknownModule
+ */
+struct RecordFrame
+{
+    std::uint32_t module = UnknownModule;
+    std::uintptr_t offset = 0;
+};
+
+struct Record
+{
+    std::map<std::uint32_t, RecordModule> modules;
+    std::vector<RecordFrame> frames;
+};
+
+/*
+ * Symbols and line table of a module, built once per run
+ */
+struct Module
+{
+    std::string path;
+    ElfSymbolIndex symbols;
+    std::unique_ptr<DwarfLineTable> lines;
+};
+
+bool startsWith(const std::string &text, const char *prefix)
+{
+    return text.compare(0, std::strlen(prefix), prefix)==0;
+}
+
+std::string getFileName(const std::string &path)
+{
+    const std::size_t slash = path.rfind('/');
+    return (slash==std::string::npos) ? path : path.substr(slash+1);
+}
+
+bool parseNumber(const std::string &text, std::uintptr_t *value)
+{
+    if(text.empty())
+    {
+        return false;
+    }
+    char *end = nullptr;
+    const unsigned long long result = std::strtoull(text.c_str(), &end, 0);
+    *value = static_cast<std::uintptr_t>(result);
+    return (*end=='\0');
+}
+
+/*
+ * Record lines are `module <index> <build-id> <base> <path>` and
+ * `frame <index> <offset>`, path may contain spaces
+ */
+bool parseLine(const std::string &line, Record *record)
+{
+    std::istringstream stream(line);
+    std::string kind;
+    std::string index;
+    stream>>kind>>index;
+    std::uintptr_t moduleIndex = UnknownModule;
+    if(kind=="module")
+    {
+        RecordModule module;
+        std::string base;
+        stream>>module.buildId>>base;
+        std::getline(stream>>std::ws, module.path);
+        if(!parseNumber(index, &moduleIndex) || !parseNumber(base, &module.base)
+           || module.path.empty())
+        {
+            return false;
+        }
+        if(module.buildId=="-")
+        {
+            module.buildId.clear();
+        }
+        record->modules[static_cast<std::uint32_t>(moduleIndex)]
+                = std::move(module);
+        return true;
+    }
+    if(kind=="frame")
+    {
+        RecordFrame frame;
+        std::string offset;
+        stream>>offset;
+        if((index!="-" && !parseNumber(index, &moduleIndex))
+           || !parseNumber(offset, &frame.offset))
+        {
+            return false;
+        }
+        frame.module = static_cast<std::uint32_t>(moduleIndex);
+        record->frames.push_back(frame);
+        return true;
+    }
+    return false;
+}
+
+class Symbolizer
+{
+public:
+    explicit Symbolizer(std::vector<std::string> directories)
+        :directories_(std::move(directories))
+    {
+    }
+
+    /*
+     * Copies input to output with records replaced by symbolized frames,
+     * malformed records are copied unchanged
+     */
+    void symbolize(std::istream &input, std::ostream &output)
+    {
+        std::string line;
+        while(std::getline(input, line))
+        {
+            if(!startsWith(line, RecordBegin))
+            {
+                output<<line<<'\n';
+                continue;
+            }
+            std::vector<std::string> lines(1, line);
+            Record record;
+            bool isValid = true;
+            bool isComplete = false;
+            while(isValid && std::getline(input, line))
+            {
+                lines.push_back(line);
+                if(line==RecordEnd)
+                {
+                    isComplete = true;
+                    break;
+                }
+                isValid = parseLine(line, &record);
+            }
+            if(isValid && isComplete)
+            {
+                writeRecord(record, output);
+                continue;
+            }
+            for(const auto &rawLine: lines)
+            {
+                output<<rawLine<<'\n';
+            }
+        }
+    }
+private:
+    /*
+     * The same frame format as the one of symbolized StackTrace
+     */
+    void writeRecord(const Record &record, std::ostream &output)
+    {
+        char text[64];
+        for(std::size_t i = 0; i<record.frames.size(); ++i)
+        {
+            const RecordFrame &frame = record.frames[i];
+            auto recordModule = record.modules.find(frame.module);
+            if(recordModule==record.modules.end())
+            {
+                std::snprintf(text, sizeof(text), "%4zu 0x%zx ??", i
+                              , static_cast<std::size_t>(frame.offset));
+                output<<text<<'\n';
+                continue;
+            }
+            const RecordModule &module = recordModule->second;
+            const std::uintptr_t address = module.base+frame.offset;
+            const Module &files = getModule(module);
+            std::size_t offset = frame.offset;
+            const char *name = files.symbols.findSymbol(frame.offset, &offset);
+            std::snprintf(text, sizeof(text), "%4zu 0x%zx ", i
+                          , static_cast<std::size_t>(address));
+            output<<text<<module.path<<'('<<(name ? demangle(name) : "");
+            std::snprintf(text, sizeof(text), "+0x%zx) [0x%zx]", offset
+                          , static_cast<std::size_t>(address));
+            output<<text;
+            SourceLocation locations[MaxSourceLocations];
+            //return address follows the call, its last byte belongs to it
+            const std::size_t locationCount = files.lines->findLocations(
+                        frame.offset-1, locations, MaxSourceLocations);
+            for(std::size_t j = 0; j<locationCount; ++j)
+            {
+                output<<((j==0) ? " at " : ", inlined at ")
+                      <<(locations[j].file ? locations[j].file : "??")
+                      <<':'<<locations[j].line;
+                if(locations[j].function)
+                {
+                    output<<" in "<<locations[j].function;
+                }
+            }
+            output<<'\n';
+        }
+    }
+
+    /*
+     * Returns files of module, they are searched and indexed on first
+     * use of build-id, or of path if module has no build-id
+     */
+    const Module &getModule(const RecordModule &recordModule)
+    {
+        const std::string &key = recordModule.buildId.empty()
+                                    ? recordModule.path : recordModule.buildId;
+        std::unique_ptr<Module> &module = modules_[key];
+        if(module)
+        {
+            return *module;
+        }
+        module.reset(new Module());
+        for(const auto &candidate: getCandidates(recordModule))
+        {
+            ElfImage image(candidate.c_str());
+            if(!image.isValid() || (!recordModule.buildId.empty()
+                                    && image.getBuildId()!=recordModule.buildId))
+            {
+                continue;
+            }
+            if(module->symbols.isEmpty())
+            {
+                ElfSymbolIndex symbols(candidate.c_str());
+                if(!symbols.isEmpty())
+                {
+                    module->path = candidate;
+                    module->symbols = std::move(symbols);
+                }
+            }
+            if(!module->lines || module->lines->isEmpty())
+            {
+                module->lines = DwarfLineTable::create(candidate.c_str());
+            }
+            if(!module->symbols.isEmpty() && !module->lines->isEmpty())
+            {
+                break;
+            }
+        }
+        if(!module->lines)
+        {
+            module->lines = DwarfLineTable::create("");
+        }
+        return *module;
+    }
+
+    std::vector<std::string> getCandidates(const RecordModule &module) const
+    {
+        std::vector<std::string> candidates;
+        const std::string &buildId = module.buildId;
+        for(const auto &directory: directories_)
+        {
+            if(buildId.size()>2)
+            {
+                const std::string path = directory+"/.build-id/"
+                                         +buildId.substr(0, 2)+'/'
+                                         +buildId.substr(2);
+                candidates.push_back(path+".debug");
+                candidates.push_back(path);
+            }
+            candidates.push_back(directory+'/'+getFileName(module.path));
+            candidates.push_back(directory+module.path);
+        }
+        candidates.push_back(module.path);
+        return candidates;
+    }
+
+    const char *demangle(const char *name)
+    {
+        auto found = demangledNames_.find(name);
+        if(found!=demangledNames_.end())
+        {
+            return found->second.c_str();
+        }
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        std::string &result = demangledNames_[name];
+        result = (status==0 && demangled) ? demangled : name;
+        std::free(demangled);
+        return result.c_str();
+    }
+
+    std::vector<std::string> directories_;
+    std::map<std::string, std::unique_ptr<Module>> modules_;
+    std::unordered_map<std::string, std::string> demangledNames_;
+};
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> directories;
+    std::vector<std::string> files;
+    for(int i = 1; i<argc; ++i)
+    {
+        if(std::strcmp(argv[i], "-d")==0 || std::strcmp(argv[i], "-c")==0)
+        {
+            if(i+1==argc)
+            {
+                std::cerr<<Usage;
+                return 2;
+            }
+            if(argv[i][1]=='d')
+            {
+                directories.push_back(argv[++i]);
+            }
+            else
+            {
+                SymbolCacheFile::setDirectory(argv[++i]);
+            }
+        }
+        else if(std::strcmp(argv[i], "-h")==0
+                || std::strcmp(argv[i], "--help")==0)
+        {
+            std::cout<<Usage;
+            return 0;
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
+    }
+    directories.push_back("/usr/lib/debug");
+
+    Symbolizer symbolizer(std::move(directories));
+    std::ios_base::sync_with_stdio(false);
+    if(files.empty())
+    {
+        symbolizer.symbolize(std::cin, std::cout);
+    }
+    for(const auto &file: files)
+    {
+        if(file=="-")
+        {
+            symbolizer.symbolize(std::cin, std::cout);
+            continue;
+        }
+        std::ifstream input(file);
+        if(!input)
+        {
+            std::cerr<<"cppassert-symbolize: can't open "<<file<<'\n';
+            return 1;
+        }
+        symbolizer.symbolize(input, std::cout);
+    }
+    return 0;
+}